@@ -0,0 +1,113 @@
+#include "stdafx.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace Json4CPP::Benchmark
+{
+  vector<pair<string, BENCHMARK_FUNCTION>>& Registry()
+  {
+    static auto registry = vector<pair<string, BENCHMARK_FUNCTION>>();
+    return registry;
+  }
+
+  bool Register(string const& name, BENCHMARK_FUNCTION function)
+  {
+    Registry().push_back({ name, function });
+    return true;
+  }
+
+  double Measure(string const& name, size_t bytes, function<void()> const& func)
+  {
+    // Warm up, and measure how many iterations fit into a second
+    auto start = high_resolution_clock::now();
+    func();
+    auto single = duration<double>(high_resolution_clock::now() - start).count();
+    auto iterations = max<int64_t>(1, (int64_t)(1.0 / max(single, 1e-9)));
+
+    start = high_resolution_clock::now();
+    for (int64_t i = 0; i < iterations; ++i)
+    {
+      func();
+    }
+    auto seconds = duration<double>(high_resolution_clock::now() - start).count() / iterations;
+
+    cout << "  " << left << setw(48) << name << right << setw(12) << fixed << setprecision(3) << seconds * 1e3 << " ms";
+    if (bytes)
+    {
+      cout << setw(12) << setprecision(1) << bytes / seconds / 1e6 << " MB/s";
+    }
+    cout << endl;
+    return seconds;
+  }
+
+  size_t MemoryUsage()
+  {
+    auto counters = PROCESS_MEMORY_COUNTERS_EX();
+    GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&counters, sizeof(counters));
+    return counters.PrivateUsage;
+  }
+
+  size_t PeakMemoryUsage()
+  {
+    auto counters = PROCESS_MEMORY_COUNTERS();
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize;
+  }
+
+  wstring GenerateDocument(size_t count)
+  {
+    wostringstream os;
+    os << L"[\r\n";
+    for (size_t i = 0; i < count; ++i)
+    {
+      os << L"  {\r\n"
+         << L"    \"id\": " << i << L",\r\n"
+         << L"    \"name\": \"Item " << i << L"\",\r\n"
+         << L"    \"description\": \"Lorem ipsum dolor sit amet, \\\"consectetur\\\" adipiscing elit \\u03A9\",\r\n"
+         << L"    \"price\": " << i * 0.25 + 0.125 << L",\r\n"
+         << L"    \"available\": " << (i % 2 ? L"true" : L"false") << L",\r\n"
+         << L"    \"discount\": null,\r\n"
+         << L"    \"tags\": [ \"a\", \"b\", \"c\", " << i % 7 << L" ],\r\n"
+         << L"    \"size\": { \"width\": " << i % 100 << L", \"height\": " << i % 50 << L", \"unit\": \"cm\" }\r\n"
+         << L"  }" << (i + 1 < count ? L"," : L"") << L"\r\n";
+    }
+    os << L"]";
+    return os.str();
+  }
+
+  wstring GenerateNumbers(size_t count)
+  {
+    wostringstream os;
+    os << L"[";
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (i) os << L",";
+      if (i % 2) os << (int64_t)(i * 2654435761ull % 1000000007ull);
+      else       os << setprecision(17) << (double)(i * 2654435761ull % 1000000007ull) / 1024.0 + 0.1;
+    }
+    os << L"]";
+    return os.str();
+  }
+
+  wstring GenerateStrings(size_t count)
+  {
+    wostringstream os;
+    os << L"[";
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (i) os << L",";
+      switch (i % 4)
+      {
+      case 0: os << L"\"The quick brown fox jumps over the lazy dog\""; break;
+      case 1: os << L"\"Line\\r\\nbreak and \\t tab and \\\"quotes\\\" and \\\\ backslash\""; break;
+      case 2: os << L"\"\u00C1rv\u00EDzt\u0171r\u0151 t\u00FCk\u00F6rf\u00FAr\u00F3g\u00E9p \u03A9 \u20AC\""; break;
+      case 3: os << L"\"\\u0041\\u00DF\\u6771\\uD834\\uDD1E escaped code points\""; break;
+      }
+    }
+    os << L"]";
+    return os.str();
+  }
+}
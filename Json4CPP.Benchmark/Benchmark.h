@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <chrono>
+
+namespace Json4CPP::Benchmark
+{
+  // Registers a benchmark function which is run by main in the order of registration.
+  // Usage: BENCHMARK(JsonLinter_Read) { Measure("name", bytes, [&] { ... }); }
+  #define BENCHMARK(NAME)                                                                   \
+    static void NAME();                                                                     \
+    static auto const NAME##Registered = ::Json4CPP::Benchmark::Register(#NAME, NAME);      \
+    static void NAME()
+
+  using BENCHMARK_FUNCTION = std::function<void()>;
+
+  std::vector<std::pair<std::string, BENCHMARK_FUNCTION>>& Registry();
+  bool Register(std::string const& name, BENCHMARK_FUNCTION function);
+
+  // Runs func repeatedly for at least about a second, then prints the average time of one iteration.
+  // If bytes is not 0, the throughput in MB/s is printed too.
+  double Measure(std::string const& name, size_t bytes, std::function<void()> const& func);
+
+  // Returns the private memory of the process in bytes.
+  size_t MemoryUsage();
+
+  // Returns the peak working set (resident memory) of the process in bytes. It can not be reset, so it only grows.
+  size_t PeakMemoryUsage();
+
+  // Prevents the compiler from optimizing away the computation of value.
+  template<typename T>
+  void DoNotOptimize(T const& value)
+  {
+    static auto volatile sink = (void const*)nullptr;
+    sink = &value;
+  }
+
+  // Generates a pretty printed document with an array of count objects, each of them containing strings, numbers,
+  // booleans, null, a nested array and a nested object. The result is deterministic for the same count.
+  std::wstring GenerateDocument(size_t count);
+  // Generates a document with an array of count numbers, alternating between integers and reals.
+  std::wstring GenerateNumbers(size_t count);
+  // Generates a document with an array of count strings, some of them containing escapes and non-ASCII characters.
+  std::wstring GenerateStrings(size_t count);
+}
@@ -0,0 +1,43 @@
+﻿#include "stdafx.h"
+
+#include "Benchmark.h"
+
+#include <locale>
+#include <codecvt>
+
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Benchmark
+{
+  // Compares String2WString and WString2String with std::wstring_convert, which they used before.
+  // The sizes are given in bytes of the UTF-8 encoded input.
+  BENCHMARK(Helper_Transcode)
+  {
+    auto ascii = wstring();
+    auto cjk = wstring();
+    auto mixed = wstring();
+    for (int i = 0; ascii.size() < 4000000; ++i)
+    {
+      ascii += L"The quick brown fox jumps over the lazy dog "s + to_wstring(i) + L". "s;
+      cjk   += L"私はガラスを食べられます。それは私を傷つけません。"s;
+      mixed += L"{ \"name\": \"Árvíztűrő tükörfúrógép\", \"emoji\": \"\U0001F600\", \"id\": "s + to_wstring(i) + L" }, "s;
+    }
+    auto inputs = vector<pair<string, wstring>>
+    {
+      { "ASCII"s, ascii },
+      { "CJK"s  , cjk   },
+      { "mixed"s, mixed },
+    };
+    for (auto& [name, wide] : inputs)
+    {
+      auto utf8 = WString2String(wide);
+      auto bytes = utf8.size();
+      Measure(name + " wstring_convert::from_bytes"s, bytes, [&] { DoNotOptimize(wstring_convert<codecvt_utf8_utf16<wchar_t>>().from_bytes(utf8)); });
+      Measure(name + " String2WString"s             , bytes, [&] { DoNotOptimize(String2WString(utf8)); });
+      Measure(name + " wstring_convert::to_bytes"s  , bytes, [&] { DoNotOptimize(wstring_convert<codecvt_utf8_utf16<wchar_t>>().to_bytes(wide)); });
+      Measure(name + " WString2String"s             , bytes, [&] { DoNotOptimize(WString2String(wide)); });
+    }
+  }
+}
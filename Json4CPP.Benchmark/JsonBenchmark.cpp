@@ -0,0 +1,554 @@
+#include "stdafx.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Benchmark
+{
+  // Builds the Json from the tokens the way Json::Read did before JsonDomHandler, value by value through Insert and PushBack.
+  static Json ReadTokens(deque<TOKEN>& tokens)
+  {
+    auto [token, value] = move(tokens.front());
+    tokens.pop_front();
+    switch (token)
+    {
+    case JsonTokenType::StartObject:
+    {
+      auto object = JsonObject();
+      while (tokens.front().first != JsonTokenType::EndObject)
+      {
+        auto key = get<wstring>(move(tokens.front().second));
+        tokens.pop_front();
+        object.Insert({ move(key), ReadTokens(tokens) });
+      }
+      tokens.pop_front();
+      return object;
+    }
+    case JsonTokenType::StartArray:
+    {
+      auto array = JsonArray();
+      while (tokens.front().first != JsonTokenType::EndArray)
+      {
+        array.PushBack(ReadTokens(tokens));
+      }
+      tokens.pop_front();
+      return array;
+    }
+    default:
+      return visit([](auto& value) { return Json(move(value)); }, value);
+    }
+  }
+
+  // Collects the tokens of json the way Json::Write did.
+  static deque<TOKEN>& WriteTokens(Json const& json, deque<TOKEN>& tokens)
+  {
+    switch (json.Type())
+    {
+    case JsonType::Null   : tokens.push_back({ JsonTokenType::Null   , nullptr              }); break;
+    case JsonType::String : tokens.push_back({ JsonTokenType::String , json.Get<wstring>() }); break;
+    case JsonType::Boolean: tokens.push_back({ JsonTokenType::Boolean, json.Get<bool   >() }); break;
+    case JsonType::Real   : tokens.push_back({ JsonTokenType::Real   , json.Get<double >() }); break;
+    case JsonType::Integer: tokens.push_back({ JsonTokenType::Integer, json.Get<int64_t>() }); break;
+    case JsonType::Object :
+      tokens.push_back({ JsonTokenType::StartObject, L"{"s });
+      for (auto& [key, value] : json.Get<JsonObject>())
+      {
+        tokens.push_back({ JsonTokenType::PropertyName, key });
+        WriteTokens(value, tokens);
+      }
+      tokens.push_back({ JsonTokenType::EndObject, L"}"s });
+      break;
+    case JsonType::Array  :
+      tokens.push_back({ JsonTokenType::StartArray, L"["s });
+      for (auto& value : json.Get<JsonArray>())
+      {
+        WriteTokens(value, tokens);
+      }
+      tokens.push_back({ JsonTokenType::EndArray, L"]"s });
+      break;
+    }
+    return tokens;
+  }
+
+  // Collects the strings and keys of json.
+  static void CollectStrings(Json const& json, vector<wstring const*>& strings)
+  {
+    switch (json.Type())
+    {
+    case JsonType::String:
+      strings.push_back(&json.Get<wstring>());
+      break;
+    case JsonType::Object:
+      for (auto& [key, value] : json.Get<JsonObject>())
+      {
+        strings.push_back(&key);
+        CollectStrings(value, strings);
+      }
+      break;
+    case JsonType::Array:
+      for (auto& value : json.Get<JsonArray>())
+      {
+        CollectStrings(value, strings);
+      }
+      break;
+    }
+  }
+
+  // The size of value in UTF-8, with the unpaired surrogates encoded in 3 bytes each, as WTF-8 does.
+  static size_t Utf8Size(wstring const& value)
+  {
+    auto size = size_t(0);
+    for (size_t i = 0; i < value.size(); ++i)
+    {
+      auto c = (uint32_t)(make_unsigned_t<wchar_t>)value[i];
+      if (0xD800 <= c && c <= 0xDBFF && i + 1 < value.size() && 0xDC00 <= (uint32_t)value[i + 1] && (uint32_t)value[i + 1] <= 0xDFFF)
+      {
+        ++i;
+        c = 0x10000;
+      }
+      size += c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+    }
+    return size;
+  }
+
+  // The way Dump worked before JsonWriter, by collecting the tokens first.
+  static wstring DumpTokens(Json const& json, uint8_t indentation)
+  {
+    auto tokens = deque<TOKEN>();
+    WriteTokens(json, tokens);
+    wostringstream os;
+    JsonLinter::Write(os, tokens, indentation);
+    return os.str();
+  }
+
+  // Compares building the Json from the collected tokens with building it directly while parsing.
+  BENCHMARK(Json_Parse)
+  {
+    auto inputs = vector<pair<string, wstring>>
+    {
+      { "document"s, GenerateDocument(20000) },
+      { "numbers"s , GenerateNumbers(200000) },
+      { "strings"s , GenerateStrings(100000) },
+    };
+    for (auto& [name, text] : inputs)
+    {
+      auto bytes = text.size() * sizeof(wchar_t);
+      Measure(name + " tokens + Read"s, bytes, [&]
+      {
+        auto tokens = JsonLinter::Read(text);
+        DoNotOptimize(ReadTokens(tokens));
+      });
+      Measure(name + " Parse"s, bytes, [&] { DoNotOptimize(Json::Parse(text)); });
+
+      // The token based path holds every value twice: once in the tokens and once in the Json being built
+      auto before = MemoryUsage();
+      auto tokens = JsonLinter::Read(text);
+      auto withTokens = MemoryUsage();
+      auto json = Json::Parse(text);
+      auto withJson = MemoryUsage();
+      cout << "  " << left << setw(48) << name + " memory of tokens / Json"s << right
+           << setw(12) << fixed << setprecision(1) << (withTokens - before) / 1e6 << " MB"
+           << setw(12) << (withJson - withTokens) / 1e6 << " MB" << endl;
+    }
+  }
+  // Compares dumping through the collected tokens with JsonWriter walking the values directly.
+  BENCHMARK(Json_Dump)
+  {
+    auto inputs = vector<pair<string, Json>>
+    {
+      { "document"s, Json::Parse(GenerateDocument(20000)) },
+      { "numbers"s , Json::Parse(GenerateNumbers(1000000)) },
+      { "strings"s , Json::Parse(GenerateStrings(100000)) },
+    };
+    for (auto& [name, json] : inputs)
+    {
+      for (auto indentation : { 0, 2 })
+      {
+        auto bytes = json.Dump(indentation).size() * sizeof(wchar_t);
+        auto suffix = "("s + to_string(indentation) + ")"s;
+        Measure(name + " tokens + JsonLinter::Write"s + suffix, bytes, [&] { DoNotOptimize(DumpTokens(json, indentation)); });
+        Measure(name + " Dump"s + suffix, bytes, [&] { DoNotOptimize(json.Dump(indentation)); });
+        Measure(name + " JsonWriter::Write(wostream)"s + suffix, bytes, [&]
+        {
+          wostringstream os;
+          JsonWriter::Write(os, json, indentation);
+          DoNotOptimize(os);
+        });
+      }
+
+      // Besides the output, the token based path holds a copy of every key and string
+      auto before = MemoryUsage();
+      auto tokens = deque<TOKEN>();
+      WriteTokens(json, tokens);
+      auto withTokens = MemoryUsage();
+      cout << "  " << left << setw(48) << name + " memory of tokens"s << right
+           << setw(12) << fixed << setprecision(1) << (withTokens - before) / 1e6 << " MB" << endl;
+    }
+  }
+  // Compares reading and writing files through a UTF-16 wstring of the whole document with parsing and dumping UTF-8 directly.
+  // The memory lines show the size of the intermediate text and of the Json itself, which still stores UTF-16 strings.
+  BENCHMARK(Json_File)
+  {
+    auto inputs = vector<pair<string, wstring>>
+    {
+      { "document"s, GenerateDocument(20000) },
+      { "strings"s , GenerateStrings(100000) },
+    };
+    auto file = L"Json_File.json"s;
+    for (auto& [name, text] : inputs)
+    {
+      auto json = Json::Parse(text);
+      json.Write(file);
+      auto bytes = ReadAllBytes(file).size();
+      Measure(name + " ReadAllText + Parse"s, bytes, [&] { DoNotOptimize(Json::Parse(ReadAllText(file))); });
+      Measure(name + " Read"s, bytes, [&] { DoNotOptimize(Json::Read(file)); });
+      Measure(name + " Dump + WriteAllText"s, bytes, [&] { WriteAllText(file, json.Dump(JsonDefault::Indentation)); });
+      Measure(name + " Write"s, bytes, [&] { json.Write(file); });
+
+      auto before = MemoryUsage();
+      auto wide = ReadAllText(file);
+      auto withWide = MemoryUsage();
+      auto utf8 = ReadAllBytes(file);
+      auto withUtf8 = MemoryUsage();
+      auto parsed = Json::Parse(utf8);
+      auto withJson = MemoryUsage();
+      cout << "  " << left << setw(48) << name + " memory of wstring / string / Json"s << right
+           << setw(12) << fixed << setprecision(1) << (withWide - before) / 1e6 << " MB"
+           << setw(12) << (withUtf8 - withWide) / 1e6 << " MB"
+           << setw(12) << (withJson - withUtf8) / 1e6 << " MB" << endl;
+
+      // The strings and keys of the Json as they are stored, in std::wstring, and as a UTF-8 storage mode would store them,
+      // in std::string. The string objects take the same place in the Json either way, only the allocated characters differ,
+      // so the std::string copies are only sized, not encoded.
+      auto strings = vector<wstring const*>();
+      CollectStrings(parsed, strings);
+      auto wideStrings = vector<wstring>();
+      auto utf8Strings = vector<string>();
+      wideStrings.reserve(strings.size());
+      utf8Strings.reserve(strings.size());
+      auto beforeStrings = MemoryUsage();
+      for (auto string : strings)
+      {
+        wideStrings.push_back(*string);
+      }
+      auto withWideStrings = MemoryUsage();
+      for (auto string : strings)
+      {
+        utf8Strings.emplace_back(Utf8Size(*string), '\0');
+      }
+      auto withUtf8Strings = MemoryUsage();
+      cout << "  " << left << setw(48) << name + " memory of strings as wstring / UTF-8"s << right
+           << setw(12) << fixed << setprecision(1) << (withWideStrings - beforeStrings) / 1e6 << " MB"
+           << setw(12) << (withUtf8Strings - withWideStrings) / 1e6 << " MB" << endl;
+    }
+    filesystem::remove(file);
+  }
+  // Compares parsing into containers allocated from the default resource with parsing into a monotonic arena.
+  // Destroying a Json from an arena still frees its strings, but the container memory is released at once with the arena.
+  BENCHMARK(Json_ParseResource)
+  {
+    auto inputs = vector<pair<string, wstring>>
+    {
+      { "document"s, GenerateDocument(20000) },
+      { "numbers"s , GenerateNumbers(200000) },
+    };
+    for (auto& [name, text] : inputs)
+    {
+      auto bytes = text.size() * sizeof(wchar_t);
+      Measure(name + " Parse"s, bytes, [&] { DoNotOptimize(Json::Parse(text)); });
+      Measure(name + " Parse(arena)"s, bytes, [&]
+      {
+        auto arena = pmr::monotonic_buffer_resource();
+        DoNotOptimize(Json::Parse(text, &arena));
+      });
+
+      // Destruction can not be repeated on the same Json, so it is timed over a fixed number of parsed documents
+      auto destroy = [&](string const& label, pmr::memory_resource* resource, function<void()> const& release)
+      {
+        auto documents = vector<optional<Json>>(10);
+        for (auto& document : documents)
+        {
+          document = Json::Parse(text, resource);
+        }
+        auto start = chrono::high_resolution_clock::now();
+        for (auto& document : documents)
+        {
+          document.reset();
+        }
+        release();
+        auto seconds = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count() / documents.size();
+        cout << "  " << left << setw(48) << name + label << right << setw(12) << fixed << setprecision(3) << seconds * 1e3 << " ms" << endl;
+      };
+      destroy(" destroy"s, pmr::get_default_resource(), [] {});
+      auto arena = pmr::monotonic_buffer_resource();
+      destroy(" destroy(arena) + release"s, &arena, [&] { arena.release(); });
+    }
+  }
+  // Counts the blocks allocated through it. Installed as the default resource, it sees every JsonObject and JsonArray
+  // that is not given a resource explicitly, in the library too, so copies of subtrees show up in the count.
+  class CountingResource : public pmr::memory_resource
+  {
+  public:
+    size_t allocations = 0;
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+      ++allocations;
+      return pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+      pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(memory_resource const& other) const noexcept override
+    {
+      return this == &other;
+    }
+  };
+
+  // Builds an array of objects in different ways, and prints the time and the number of container allocations per object.
+  // The keys fit into the small string buffer, so the containers are the only allocations.
+  BENCHMARK(Json_Build)
+  {
+    auto const count = 100000;
+    auto builds = vector<pair<string, function<JsonArray()>>>
+    {
+      { "PushBack(JsonObject const&)"s, [&]
+      {
+        auto array = JsonArray();
+        for (int i = 0; i < count; ++i)
+        {
+          auto object = JsonObject();
+          object.Insert({ L"id"s, i });
+          object.Insert({ L"tags"s, JsonArray{ 1, 2, 3 } });
+          array.PushBack(object);
+        }
+        return array;
+      } },
+      { "PushBack(JsonObject&&)"s, [&]
+      {
+        auto array = JsonArray();
+        for (int i = 0; i < count; ++i)
+        {
+          auto object = JsonObject();
+          object.Insert({ L"id"s, i });
+          object.Insert({ L"tags"s, JsonArray{ 1, 2, 3 } });
+          array.PushBack(move(object));
+        }
+        return array;
+      } },
+      { "PushBack(initializer_list)"s, [&]
+      {
+        auto array = JsonArray();
+        for (int i = 0; i < count; ++i)
+        {
+          array.PushBack({ { L"id"s, i }, { L"tags"s, { 1, 2, 3 } } });
+        }
+        return array;
+      } },
+      { "EmplaceBack + Emplace"s, [&]
+      {
+        auto array = JsonArray();
+        for (int i = 0; i < count; ++i)
+        {
+          auto& object = *array.EmplaceBack(JsonObject()).GetIf<JsonObject>();
+          object.Emplace(L"id"s, i);
+          object.Emplace(L"tags"s, JsonArray{ 1, 2, 3 });
+        }
+        return array;
+      } },
+    };
+    auto counter = CountingResource();
+    for (auto& [name, build] : builds)
+    {
+      Measure(name, 0, [&] { DoNotOptimize(build()); });
+      auto previous = pmr::set_default_resource(&counter);
+      counter.allocations = 0;
+      {
+        auto array = build();
+        DoNotOptimize(array);
+      }
+      pmr::set_default_resource(previous);
+      cout << "  " << left << setw(48) << name + " allocations"s << right
+           << setw(12) << fixed << setprecision(2) << (double)counter.allocations / count << endl;
+    }
+  }
+
+  // Reads a value 5 levels deep in a const document, where every level also holds 9 arrays of 100 numbers beside the next level.
+  // At on a const Json used to return a copy, so the first line copies every level the same way, the others do not copy at all.
+  // The times are of 1000 reads, the allocations of a single one.
+  BENCHMARK(Json_ConstAccess)
+  {
+    auto const depth = 5;
+    auto document = Json(JsonObject());
+    auto* level = &document;
+    for (int i = 0; i < depth; ++i)
+    {
+      for (int j = 1; j < 10; ++j)
+      {
+        auto& numbers = (*level)[L"k"s + to_wstring(j)] = JsonArray();
+        for (int k = 0; k < 100; ++k)
+        {
+          numbers.PushBack(k);
+        }
+      }
+      level = &((*level)[L"k0"s] = JsonObject());
+    }
+    *level = 1337;
+    auto const& json = document;
+    auto path = vector<KEY>(depth, L"k0"s);
+
+    auto ways = vector<pair<string, function<int64_t()>>>
+    {
+      { "copy of every level"s, [&]
+      {
+        auto current = Json(json.At(path[0]));
+        for (int i = 1; i < depth; ++i)
+        {
+          current = Json(current.At(path[i]));
+        }
+        return current.Get<int64_t>();
+      } },
+      { "At"s, [&]
+      {
+        auto current = &json;
+        for (auto& key : path)
+        {
+          current = &current->At(key);
+        }
+        return current->Get<int64_t>();
+      } },
+      { "Find"s, [&]
+      {
+        auto current = &json;
+        for (auto& key : path)
+        {
+          current = current->Find(key);
+        }
+        return current->Get<int64_t>();
+      } },
+      { "JsonObjectView"s, [&]
+      {
+        auto view = (JsonObjectView)json;
+        for (int i = 0; i < depth - 1; ++i)
+        {
+          view = (JsonObjectView)view[path[i]];
+        }
+        return view[path[depth - 1]].Get<int64_t>();
+      } },
+    };
+    auto counter = CountingResource();
+    for (auto& [name, way] : ways)
+    {
+      Measure(name, 0, [&]
+      {
+        for (int i = 0; i < 1000; ++i)
+        {
+          DoNotOptimize(way());
+        }
+      });
+      auto previous = pmr::set_default_resource(&counter);
+      counter.allocations = 0;
+      DoNotOptimize(way());
+      pmr::set_default_resource(previous);
+      cout << "  " << left << setw(48) << name + " allocations"s << right << setw(12) << counter.allocations << endl;
+    }
+  }
+
+  // Compares two documents which only differ in their last value, with and without cached hashes,
+  // then removes the duplicates of 1000 documents by comparing them one by one and by an std::unordered_set of pointers to them.
+  BENCHMARK(Json_HashEquality)
+  {
+    auto text = GenerateDocument(20000);
+    auto first = Json::Parse(text);
+    auto second = Json::Parse(text);
+    auto third = Json::Parse(text);
+    second[19999][L"size"s][L"unit"s] = L"mm"s;
+    auto const& constFirst = first;
+    auto const& constSecond = second;
+    auto const& constThird = third;
+    Measure("operator== equal documents"s, text.size() * sizeof(wchar_t), [&] { DoNotOptimize(constFirst == constThird); });
+    Measure("operator== different documents"s, text.size() * sizeof(wchar_t), [&] { DoNotOptimize(constFirst == constSecond); });
+
+    auto start = chrono::steady_clock::now();
+    DoNotOptimize(constFirst.Hash() + constSecond.Hash() + constThird.Hash());
+    auto elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / 3;
+    cout << "  " << left << setw(48) << "Hash first call"s << right << setw(12) << fixed << setprecision(3) << elapsed << " ms" << endl;
+    Measure("Hash cached"s, 0, [&] { DoNotOptimize(constFirst.Hash()); });
+    // Only the changed value and the containers above it are hashed again
+    Measure("Hash after changing one value"s, 0, [&] { second[19999][L"size"s][L"width"s] = 1; DoNotOptimize(constSecond.Hash()); });
+    Measure("operator== equal documents, cached hashes"s, text.size() * sizeof(wchar_t), [&] { DoNotOptimize(constFirst == constThird); });
+    Measure("operator== different documents, cached hashes"s, 0, [&] { DoNotOptimize(constFirst == constSecond); });
+
+    // 250 different documents of the same size, which only differ in their last value
+    auto base = Json::Parse(GenerateDocument(100));
+    auto documents = vector<Json>(1000, base);
+    for (int i = 0; i < 1000; ++i)
+    {
+      documents[i][99][L"id"s] = i % 250;
+    }
+    Measure("unique documents by operator=="s, 0, [&]
+    {
+      auto unique = vector<Json const*>();
+      for (auto& document : documents)
+      {
+        if (none_of(unique.begin(), unique.end(), [&](Json const* other) { return *other == document; }))
+        {
+          unique.push_back(&document);
+        }
+      }
+      DoNotOptimize(unique.size());
+    });
+    Measure("unique documents by std::unordered_set"s, 0, [&]
+    {
+      auto hash = [](Json const* json) { return std::hash<Json>()(*json); };
+      auto equal = [](Json const* first, Json const* second) { return *first == *second; };
+      auto unique = unordered_set<Json const*, decltype(hash), decltype(equal)>(0, hash, equal);
+      for (auto& document : documents)
+      {
+        unique.insert(&document);
+      }
+      DoNotOptimize(unique.size());
+    });
+  }
+
+  // Copies a document and changes one value of the copy, as when a configuration is derived from a common one.
+  // Copies share the objects and arrays, so only the ones on the path to the changed value are copied. The document parsed
+  // into an arena is copied deeply, as copies use the default resource, which is how every copy was made before.
+  BENCHMARK(Json_CopyOnWrite)
+  {
+    // Installed before parsing, so that the document and its copies use the same default resource and share
+    auto counter = CountingResource();
+    auto previous = pmr::set_default_resource(&counter);
+    auto text = GenerateDocument(20000);
+    auto bytes = text.size() * sizeof(wchar_t);
+    auto document = Json::Parse(text);
+    auto arena = pmr::monotonic_buffer_resource();
+    auto arenaDocument = Json::Parse(text, &arena);
+    auto change = [](Json& json) { json[10000][L"size"s][L"width"s] = 1; };
+    auto inputs = vector<pair<string, Json const*>>
+    {
+      { "copy"s, &document },
+      { "deep copy"s, &arenaDocument },
+    };
+    for (auto& [name, input] : inputs)
+    {
+      Measure(name, bytes, [&] { auto copy = *input; DoNotOptimize(copy); });
+      Measure(name + " + change one value"s, bytes, [&] { auto copy = *input; change(copy); DoNotOptimize(copy); });
+      counter.allocations = 0;
+      {
+        auto copy = *input;
+        change(copy);
+        DoNotOptimize(copy);
+      }
+      cout << "  " << left << setw(48) << name + " + change one value allocations"s << right << setw(12) << counter.allocations << endl;
+    }
+    pmr::set_default_resource(previous);
+  }
+}
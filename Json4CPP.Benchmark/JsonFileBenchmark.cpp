@@ -0,0 +1,64 @@
+#include "stdafx.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Benchmark
+{
+  // Compares reading a large file through a mapping, in chunks through an std::istream, and through a wstring of the whole file.
+  // The peak working set can not be reset, so the ways are run in the order of their expected peak, each of them reporting
+  // how much the peak grew above the one before the first of them.
+  BENCHMARK(Json_ReadFile)
+  {
+    // The file is written in parts, so that generating it does not raise the peak
+    auto file = L"Json_ReadFile.json"s;
+    {
+      auto os = ofstream(filesystem::path(file), ofstream::out | ofstream::binary);
+      os << "[";
+      for (int i = 0; i < 100; ++i)
+      {
+        os << (i ? ",\r\n" : "\r\n") << WString2String(GenerateDocument(2000));
+      }
+      os << "\r\n]";
+    }
+    auto bytes = filesystem::file_size(file);
+    cout << "  " << left << setw(48) << "file size"s << right << setw(12) << fixed << setprecision(1) << bytes / 1e6 << " MB" << endl;
+
+    auto ways = vector<pair<string, function<Json()>>>
+    {
+      { "Read (mapped)"s, [&] { return Json::Read(file); } },
+      { "istream (chunked)"s, [&]
+      {
+        auto json = Json();
+        auto handler = JsonDomHandler(json);
+        auto is = ifstream(filesystem::path(file), ifstream::in | ifstream::binary);
+        JsonLinter::Read(is, handler);
+        return json;
+      } },
+      { "ReadAllText + Parse"s, [&] { return Json::Parse(ReadAllText(file)); } },
+      { "ReadAllText + wistringstream"s, [&]
+      {
+        auto json = Json();
+        auto handler = JsonDomHandler(json);
+        auto is = wistringstream(ReadAllText(file));
+        JsonLinter::Read(is, handler);
+        return json;
+      } },
+    };
+    auto baseline = PeakMemoryUsage();
+    for (auto& [name, read] : ways)
+    {
+      DoNotOptimize(read());
+      cout << "  " << left << setw(48) << name + " peak memory"s << right
+           << setw(12) << fixed << setprecision(1) << (PeakMemoryUsage() - baseline) / 1e6 << " MB" << endl;
+    }
+    for (auto& [name, read] : ways)
+    {
+      Measure(name, bytes, [&] { DoNotOptimize(read()); });
+    }
+    filesystem::remove(file);
+  }
+}
@@ -0,0 +1,62 @@
+#include "stdafx.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Benchmark
+{
+  // Reads three fields of a 100 MB document, one at the beginning, one in the middle and one at the end,
+  // by parsing the whole document and by JsonLazy, which only indexes it and parses the three values.
+  // The peak working set can not be reset, so JsonLazy runs first, each of them reporting how much the peak grew above the one before.
+  BENCHMARK(JsonLazy_ReadFields)
+  {
+    // The file is written in parts, so that generating it does not raise the peak
+    auto file = L"JsonLazy_ReadFields.json"s;
+    auto parts = 165;
+    {
+      auto os = ofstream(filesystem::path(file), ofstream::out | ofstream::binary);
+      os << "{\r\n  \"meta\": { \"version\": 3, \"name\": \"JsonLazy_ReadFields\" },\r\n  \"items\": [";
+      for (int i = 0; i < parts; ++i)
+      {
+        auto part = WString2String(GenerateDocument(2000));
+        os << (i ? ",\r\n" : "\r\n") << part.substr(1, part.size() - 2);
+      }
+      os << "\r\n  ],\r\n  \"count\": " << parts * 2000 << "\r\n}";
+    }
+    auto bytes = filesystem::file_size(file);
+    cout << "  " << left << setw(48) << "file size"s << right << setw(12) << fixed << setprecision(1) << bytes / 1e6 << " MB" << endl;
+
+    auto read = [&](auto&& json)
+    {
+      auto version = (int64_t)json[L"meta"s][L"version"s];
+      auto name = (wstring)json[L"items"s][(int64_t)parts * 1000][L"name"s];
+      auto count = (int64_t)json[L"count"s];
+      return name.size() + version + count;
+    };
+    auto ways = vector<pair<string, function<size_t()>>>
+    {
+      { "JsonLazy::Read + 3 fields"s, [&] { return read(JsonLazy::Read(file)); } },
+      { "Json::Read + 3 fields"s    , [&] { return read(Json::Read(file)); } },
+    };
+    auto baseline = PeakMemoryUsage();
+    for (auto& [name, way] : ways)
+    {
+      DoNotOptimize(way());
+      cout << "  " << left << setw(48) << name + " peak memory"s << right
+           << setw(12) << fixed << setprecision(1) << (PeakMemoryUsage() - baseline) / 1e6 << " MB" << endl;
+    }
+    for (auto& [name, way] : ways)
+    {
+      Measure(name, bytes, [&] { DoNotOptimize(way()); });
+    }
+
+    // From memory, where JsonLazy copies the text first
+    auto text = ReadAllBytes(file);
+    Measure("JsonLazy::Parse + 3 fields"s, bytes, [&] { DoNotOptimize(read(JsonLazy::Parse(string_view(text)))); });
+    Measure("Json::Parse + 3 fields"s    , bytes, [&] { DoNotOptimize(read(Json::Parse(string_view(text)))); });
+    filesystem::remove(file);
+  }
+}
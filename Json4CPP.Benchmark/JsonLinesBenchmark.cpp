@@ -0,0 +1,102 @@
+#include "stdafx.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Benchmark
+{
+  // Reads and writes JSON Lines, one element of a generated document on each line, compared with splitting
+  // the lines by hand and parsing or dumping each of them on its own. The sizes are given in bytes of the UTF-8 encoded input.
+  BENCHMARK(JsonLines_ReadWrite)
+  {
+    auto document = Json::Parse(wstring_view(GenerateDocument(100000)));
+    auto records = vector<Json>();
+    for (auto& value : document.Get<JsonArray>())
+    {
+      records.push_back(value);
+    }
+    auto text = ""s;
+    {
+      auto os = ostringstream();
+      auto writer = JsonLinesWriter(os);
+      for (auto& record : records)
+      {
+        writer.Write(record);
+      }
+      writer.Flush();
+      text = os.str();
+    }
+    auto bytes = text.size();
+    cout << "  " << left << setw(48) << to_string(records.size()) + " records"s << right << setw(12) << fixed << setprecision(1) << bytes / 1e6 << " MB" << endl;
+
+    Measure("getline + operator\"\"_json"s, bytes, [&]
+    {
+      auto is = istringstream(text);
+      auto line = ""s;
+      while (getline(is, line))
+      {
+        auto wide = String2WString(line);
+        DoNotOptimize(operator""_json(wide.c_str(), wide.size()));
+      }
+    });
+    Measure("getline + Json::Parse(string_view)"s, bytes, [&]
+    {
+      auto is = istringstream(text);
+      auto line = ""s;
+      while (getline(is, line))
+      {
+        DoNotOptimize(Json::Parse(string_view(line)));
+      }
+    });
+    Measure("JsonLinesReader::Read(json)"s, bytes, [&]
+    {
+      auto is = istringstream(text);
+      auto reader = JsonLinesReader(is);
+      auto json = Json();
+      while (reader.Read(json))
+      {
+        DoNotOptimize(json);
+      }
+    });
+    auto threads = JsonDefault::Threads;
+    for (auto count : { 1u, max(2u, thread::hardware_concurrency()) })
+    {
+      JsonDefault::Threads = (uint8_t)count;
+      Measure("JsonLinesReader::Read(records, 10000) "s + to_string(count) + (count == 1 ? " thread"s : " threads"s), bytes, [&]
+      {
+        auto is = istringstream(text);
+        auto reader = JsonLinesReader(is);
+        auto batch = vector<Json>();
+        while (reader.Read(batch, 10000))
+        {
+          DoNotOptimize(batch);
+        }
+      });
+    }
+    JsonDefault::Threads = threads;
+
+    Measure("Dump(0) + WString2String"s, bytes, [&]
+    {
+      auto os = ostringstream();
+      for (auto& record : records)
+      {
+        os << WString2String(record.Dump(0)) << '\n';
+      }
+      DoNotOptimize(os);
+    });
+    Measure("JsonLinesWriter::Write"s, bytes, [&]
+    {
+      auto os = ostringstream();
+      auto writer = JsonLinesWriter(os);
+      for (auto& record : records)
+      {
+        writer.Write(record);
+      }
+      writer.Flush();
+      DoNotOptimize(os);
+    });
+  }
+}
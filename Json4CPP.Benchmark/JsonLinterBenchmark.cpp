@@ -0,0 +1,265 @@
+#include "stdafx.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Benchmark
+{
+  // Compares the throughput of the std::wistream based parser with the one scanning a buffer in memory.
+  // The sizes are given in bytes of the UTF-8 encoded input.
+  BENCHMARK(JsonLinter_Read)
+  {
+    auto inputs = vector<pair<string, wstring>>
+    {
+      { "document"s, GenerateDocument(20000) },
+      { "numbers"s , GenerateNumbers(200000) },
+      { "strings"s , GenerateStrings(100000) },
+    };
+    for (auto& [name, wide] : inputs)
+    {
+      auto utf8 = WString2String(wide);
+      auto bytes = utf8.size();
+      Measure(name + " wstringstream"s, bytes, [&]
+      {
+        auto is = wstringstream(wide);
+        DoNotOptimize(JsonLinter::Read(is));
+      });
+      Measure(name + " wstring_view"s, bytes, [&] { DoNotOptimize(JsonLinter::Read(wstring_view(wide))); });
+      Measure(name + " string_view (UTF-8)"s, bytes, [&] { DoNotOptimize(JsonLinter::Read(string_view(utf8))); });
+      Measure(name + " String2WString + wstring_view"s, bytes, [&] { DoNotOptimize(JsonLinter::Read(String2WString(utf8))); });
+    }
+  }
+  // Parses documents containing only numbers, the kind of content of time series and coordinate arrays.
+  // The wstringstream line converts the same numbers the way ParseNumber used to, one stream per number, without parsing the document.
+  BENCHMARK(JsonLinter_ParseNumber)
+  {
+    auto generate = [](int count, function<void(wostream&, int)> write)
+    {
+      auto numbers = vector<wstring>();
+      for (int i = 0; i < count; ++i)
+      {
+        wostringstream os;
+        write(os, i);
+        numbers.push_back(os.str());
+      }
+      return numbers;
+    };
+    auto inputs = vector<pair<string, vector<wstring>>>
+    {
+      { "integers"s   , generate(500000, [](wostream& os, int i) { os << (int64_t)(i * 2654435761ull % 1000000007ull) - 500000000; }) },
+      { "coordinates"s, generate(500000, [](wostream& os, int i) { os << fixed << setprecision(6) << (i * 2654435761ull % 360000000ull) / 1e6 - 180.0; }) },
+      { "doubles"s    , generate(500000, [](wostream& os, int i) { os << setprecision(17) << (i * 2654435761ull % 1000000007ull) / 1024.0 * 1e-5; }) },
+    };
+    for (auto& [name, numbers] : inputs)
+    {
+      wostringstream os;
+      os << L"[";
+      for (auto& number : numbers)
+      {
+        os << (&number == &numbers.front() ? L"" : L",") << number;
+      }
+      os << L"]";
+      auto wide = os.str();
+      auto utf8 = WString2String(wide);
+      auto bytes = utf8.size();
+      Measure(name + " wstringstream >> number"s, bytes, [&]
+      {
+        auto sum = 0.0;
+        for (auto& number : numbers)
+        {
+          double value;
+          wstringstream(number) >> value;
+          sum += value;
+        }
+        DoNotOptimize(sum);
+      });
+      Measure(name + " Parse(wstring_view)"s, bytes, [&] { DoNotOptimize(Json::Parse(wstring_view(wide))); });
+      Measure(name + " Parse(string_view)"s, bytes, [&] { DoNotOptimize(Json::Parse(string_view(utf8))); });
+    }
+  }
+  // Parses and dumps documents of long strings, where most of the time is spent copying the characters between the escapes.
+  // The sizes are given in bytes of the UTF-8 encoded input.
+  BENCHMARK(JsonLinter_ParseString)
+  {
+    auto generate = [](int count, wstring const& sentence, wstring const& escape)
+    {
+      wostringstream os;
+      os << L"[";
+      for (int i = 0; i < count; ++i)
+      {
+        os << (i ? L",\"" : L"\"");
+        for (int j = 0; j < 8; ++j)
+        {
+          os << sentence << (j % 4 == 3 ? escape : L" ");
+        }
+        os << L"\"";
+      }
+      os << L"]";
+      return os.str();
+    };
+    auto inputs = vector<pair<string, wstring>>
+    {
+      { "plain"s  , generate(20000, L"The quick brown fox jumps over the lazy dog, then runs back into the forest."s, L" "s) },
+      { "escaped"s, generate(20000, L"The quick brown fox jumps over the lazy dog, then runs back into the forest."s, L"\\n\\t\\\""s) },
+      { "UTF-8"s  , generate(20000, L"Árvíztűrő tükörfúrógép, a gyors barna róka átugorja a lusta kutyát."s, L"\\n"s) },
+    };
+    for (auto& [name, wide] : inputs)
+    {
+      auto utf8 = WString2String(wide);
+      auto bytes = utf8.size();
+      auto json = Json::Parse(wstring_view(wide));
+      Measure(name + " Parse(wstring_view)"s, bytes, [&] { DoNotOptimize(Json::Parse(wstring_view(wide))); });
+      Measure(name + " Parse(string_view)"s , bytes, [&] { DoNotOptimize(Json::Parse(string_view(utf8))); });
+      Measure(name + " Parse(istream)"s     , bytes, [&]
+      {
+        auto is = istringstream(utf8);
+        auto result = Json();
+        is >> result;
+        DoNotOptimize(result);
+      });
+      Measure(name + " Dump"s               , bytes, [&] { DoNotOptimize(json.Dump(0)); });
+      Measure(name + " JsonWriter::Write(ostream)"s, bytes, [&]
+      {
+        ostringstream os;
+        JsonWriter::Write(os, json, 0);
+        DoNotOptimize(os);
+      });
+      Measure(name + " EscapeString"s       , bytes, [&]
+      {
+        for (auto& value : json.Get<JsonArray>())
+        {
+          DoNotOptimize(EscapeString(value.Get<wstring>()));
+        }
+      });
+    }
+  }
+
+  // Discards the values, so that only the parser is measured.
+  class JsonNullHandler : public JsonHandler
+  {
+  public:
+    void Null        (               ) override {}
+    void String      (wstring&& value) override { DoNotOptimize(value); }
+    void Boolean     (bool      value) override {}
+    void Real        (double    value) override {}
+    void Integer     (int64_t   value) override {}
+    void PropertyName(wstring&& value) override { DoNotOptimize(value); }
+    void StartObject (               ) override {}
+    void EndObject   (               ) override {}
+    void StartArray  (               ) override {}
+    void EndArray    (               ) override {}
+  };
+
+  // Compares the two backends of JsonLinter, with the index of JsonBackend::StructuralIndex built alone too.
+  // The sizes are given in bytes of the UTF-8 encoded input.
+  BENCHMARK(JsonLinter_Backend)
+  {
+    auto document = GenerateDocument(20000);
+    auto inputs = vector<pair<string, wstring>>
+    {
+      { "document"s        , document },
+      { "document compact"s, Json::Parse(wstring_view(document)).Dump(0) },
+      { "numbers"s         , GenerateNumbers(200000) },
+      { "strings"s         , GenerateStrings(100000) },
+    };
+    auto backend = JsonDefault::Backend;
+    for (auto& [name, wide] : inputs)
+    {
+      auto utf8 = WString2String(wide);
+      auto bytes = utf8.size();
+      auto positions = vector<uint32_t>();
+      Measure(name + " JsonStructuralIndex::Build(string_view)"s , bytes, [&] { DoNotOptimize(JsonStructuralIndex::Build(string_view (utf8), positions)); });
+      Measure(name + " JsonStructuralIndex::Build(wstring_view)"s, bytes, [&] { DoNotOptimize(JsonStructuralIndex::Build(wstring_view(wide), positions)); });
+      for (auto other : { JsonBackend::Linter, JsonBackend::StructuralIndex })
+      {
+        JsonDefault::Backend = other;
+        auto prefix = name + " "s + WString2String(Json::Stringify(other)) + " "s;
+        Measure(prefix + "Read(string_view, handler)"s , bytes, [&]
+        {
+          auto handler = JsonNullHandler();
+          JsonLinter::Read(string_view(utf8), handler);
+        });
+        Measure(prefix + "Read(wstring_view, handler)"s, bytes, [&]
+        {
+          auto handler = JsonNullHandler();
+          JsonLinter::Read(wstring_view(wide), handler);
+        });
+        Measure(prefix + "Json::Parse(string_view)"s   , bytes, [&] { DoNotOptimize(Json::Parse(string_view(utf8))); });
+      }
+      JsonDefault::Backend = backend;
+    }
+  }
+
+  // Scaling of the parse of a large root array in parts, from 1 thread up to the number of hardware threads.
+  // The speedup is relative to 1 thread, which uses JsonBackend::StructuralIndex too, the sizes are given in bytes of the UTF-8 encoded input.
+  BENCHMARK(JsonLinter_ReadParallel)
+  {
+    auto utf8 = WString2String(GenerateDocument(200000));
+    auto bytes = utf8.size();
+    auto counts = vector<size_t>{ 1 };
+    for (auto count = size_t(2); count < thread::hardware_concurrency(); count *= 2)
+    {
+      counts.push_back(count);
+    }
+    counts.push_back(max(2u, thread::hardware_concurrency()));
+    // The speedups can only be compared between machines with the number of hardware threads they were measured with
+    cout << "  " << left << setw(48) << "hardware threads"s << right << setw(12) << thread::hardware_concurrency() << endl;
+    auto single = pair<double, double>();
+    auto threads = JsonDefault::Threads;
+    auto backend = JsonDefault::Backend;
+    JsonDefault::Backend = JsonBackend::StructuralIndex;
+    for (auto count : counts)
+    {
+      auto handlers = vector<JsonNullHandler>(count);
+      auto pointers = vector<JsonHandler*>();
+      for (auto& handler : handlers)
+      {
+        pointers.push_back(&handler);
+      }
+      auto prefix = to_string(count) + (count == 1 ? " thread "s : " threads "s);
+      auto read  = Measure(prefix + "ReadParallel(string_view, handlers)"s, bytes, [&] { DoNotOptimize(JsonLinter::ReadParallel(string_view(utf8), pointers)); });
+      JsonDefault::Threads = (uint8_t)count;
+      auto parse = Measure(prefix + "Json::Parse(string_view)"s           , bytes, [&] { DoNotOptimize(Json::Parse(string_view(utf8))); });
+      if (count == 1)
+      {
+        single = { read, parse };
+      }
+      cout << "  " << left << setw(48) << prefix + "speedup"s << right << setw(12) << fixed << setprecision(2)
+           << single.first / read << " x" << setw(12) << single.second / parse << " x" << endl;
+    }
+    JsonDefault::Threads = threads;
+    JsonDefault::Backend = backend;
+  }
+
+  // Reads a document with an error right before its end and the same document without it, from memory and from streams.
+  // The difference is the cost of the position in the error message, which used to take a second pass over the whole input.
+  BENCHMARK(JsonLinter_ErrorPosition)
+  {
+    auto wide = GenerateDocument(20000);
+    auto invalid = wide.substr(0, wide.size() - 1) + L"; ]"s;
+    auto utf8 = WString2String(wide);
+    auto invalidUtf8 = WString2String(invalid);
+    auto bytes = utf8.size();
+    auto read = [](auto&& function)
+    {
+      auto handler = JsonNullHandler();
+      try
+      {
+        function(handler);
+      }
+      catch (exception const& e)
+      {
+        DoNotOptimize(e.what());
+      }
+    };
+    for (auto& [name, text, textUtf8] : vector<tuple<string, wstring*, string*>>{ { "valid"s, &wide, &utf8 }, { "invalid"s, &invalid, &invalidUtf8 } })
+    {
+      Measure(name + " wstringstream"s, bytes, [&] { read([&](JsonHandler& handler) { auto is = wstringstream(*text); JsonLinter::Read(is, handler); }); });
+      Measure(name + " stringstream"s , bytes, [&] { read([&](JsonHandler& handler) { auto is = stringstream(*textUtf8); JsonLinter::Read(is, handler); }); });
+      Measure(name + " string_view"s  , bytes, [&] { read([&](JsonHandler& handler) { JsonLinter::Read(string_view(*textUtf8), handler); }); });
+    }
+  }
+}
@@ -0,0 +1,146 @@
+#include "stdafx.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Benchmark
+{
+  // Sums the size of the blocks currently allocated through it.
+  class SizeResource : public pmr::memory_resource
+  {
+  public:
+    size_t size = 0;
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+      size += bytes;
+      return pmr::get_default_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+      size -= bytes;
+      pmr::get_default_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(memory_resource const& other) const noexcept override
+    {
+      return this == &other;
+    }
+  };
+
+  // Measures Insert, At and operator[] at sizes below and above the linear search limit of JsonObject,
+  // and compares its memory with the previous layout, which kept a second copy of every key in an std::unordered_map.
+  BENCHMARK(JsonObject_Access)
+  {
+    for (auto size : { 4, 8, 16, 64, 1024, 65536 })
+    {
+      auto keys = vector<KEY>();
+      for (int i = 0; i < size; ++i)
+      {
+        keys.push_back(L"property"s + to_wstring(i));
+      }
+      auto object = JsonObject();
+      for (auto& key : keys)
+      {
+        object.Insert({ key, 0 });
+      }
+      auto const& constObject = object;
+      // Every measurement touches about the same number of keys, so the times per size are comparable
+      auto repeat = max(1, 65536 / size);
+      auto name = to_string(size) + " keys "s;
+
+      Measure(name + "Insert"s, 0, [&]
+      {
+        for (int r = 0; r < repeat; ++r)
+        {
+          auto inserted = JsonObject();
+          for (auto& key : keys)
+          {
+            inserted.Insert({ key, 0 });
+          }
+          DoNotOptimize(inserted);
+        }
+      });
+      Measure(name + "At"s, 0, [&]
+      {
+        for (int r = 0; r < repeat; ++r)
+        {
+          for (auto& key : keys)
+          {
+            DoNotOptimize(constObject.At(key));
+          }
+        }
+      });
+      Measure(name + "operator[]"s, 0, [&]
+      {
+        for (int r = 0; r < repeat; ++r)
+        {
+          for (auto& key : keys)
+          {
+            DoNotOptimize(object[key]);
+          }
+        }
+      });
+
+      // Counted through a memory resource, the strings of the pairs are allocated separately and are the same for both
+      auto objectResource = SizeResource();
+      auto counted = JsonObject(&objectResource);
+      counted = object;
+      auto mapResource = SizeResource();
+      auto pairs = pmr::vector<pair<KEY, Json>>(&mapResource);
+      auto indexes = pmr::unordered_map<pmr::wstring, int64_t>(&mapResource);
+      for (auto& key : keys)
+      {
+        indexes[pmr::wstring(key, &mapResource)] = pairs.size();
+        pairs.emplace_back(key, 0);
+      }
+      cout << "  " << left << setw(48) << name + "bytes per key JsonObject / map"s << right
+           << setw(12) << fixed << setprecision(1) << (double)objectResource.size / size << " B"
+           << setw(12) << (double)mapResource.size / size << " B" << endl;
+    }
+  }
+  // Erases half of the keys of an object one by one and with a single EraseIf.
+  // Every iteration starts from a copy, so the time of the copy alone is shown first.
+  BENCHMARK(JsonObject_Erase)
+  {
+    for (auto size : { 64, 1024, 16384 })
+    {
+      auto object = JsonObject();
+      for (int i = 0; i < size; ++i)
+      {
+        object.Insert({ L"property"s + to_wstring(i), i });
+      }
+      auto name = to_string(size) + " keys "s;
+      Measure(name + "copy"s, 0, [&] { DoNotOptimize(JsonObject(object)); });
+      Measure(name + "Erase half"s, 0, [&]
+      {
+        auto erased = object;
+        for (int i = 0; i < size; i += 2)
+        {
+          erased.Erase(L"property"s + to_wstring(i));
+        }
+        DoNotOptimize(erased);
+      });
+      Measure(name + "Erase second half backwards"s, 0, [&]
+      {
+        auto erased = object;
+        for (int i = size - 1; i >= size / 2; --i)
+        {
+          erased.Erase(L"property"s + to_wstring(i));
+        }
+        DoNotOptimize(erased);
+      });
+      Measure(name + "EraseIf half"s, 0, [&]
+      {
+        auto erased = object;
+        erased.EraseIf([](pair<KEY, Json> const& pair) { return pair.second.Get<int64_t>() % 2 == 0; });
+        DoNotOptimize(erased);
+      });
+    }
+  }
+}
@@ -0,0 +1,62 @@
+#include "stdafx.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Benchmark
+{
+  // Diffs a document of 20000 items against a copy with a few changes, which shares the unchanged parts with it, and against the
+  // same changes made to a separately parsed document, where every value has to be compared. Then applies the patch, and a merge
+  // patch to the items keyed by their names, and compares the size of the patches to the size of the whole document.
+  BENCHMARK(JsonPatch_DiffApply)
+  {
+    auto text = GenerateDocument(20000);
+    auto bytes = text.size() * sizeof(wchar_t);
+    auto document = Json::Parse(text);
+    auto change = [](Json& json)
+    {
+      for (int i = 1; i < 20000; i += 2000)
+      {
+        json[i][L"price"s] = -1;
+      }
+      json[7000][L"size"s][L"depth"s] = 10;
+      json[12000][L"tags"s].PushBack(L"d");
+      json.Erase(5000);
+      json.Insert(15000, { { L"id"s, 20000 }, { L"name"s, L"Item 20000"s } });
+    };
+    auto copy = document;
+    change(copy);
+    auto parsed = Json::Parse(text);
+    change(parsed);
+
+    auto patch = Json();
+    Measure("Diff against a modified copy"s, bytes, [&] { patch = document.Diff(copy); DoNotOptimize(patch); });
+    // The hashes of both documents are computed in the first run and cached for the rest
+    Measure("Diff against a modified document"s, bytes, [&] { patch = document.Diff(parsed); DoNotOptimize(patch); });
+    Measure("Apply"s, bytes, [&] { auto json = document; json.Apply(patch); DoNotOptimize(json); });
+    Measure("Dump"s, bytes, [&] { auto dump = document.Dump(); DoNotOptimize(dump); });
+
+    auto items = Json(JsonObject());
+    for (int64_t i = 0; i < document.Size(); ++i)
+    {
+      auto& item = as_const(document).At(i);
+      items[item.At(L"name"s).Get<wstring>()] = item;
+    }
+    auto merge = Json(JsonObject());
+    for (int i = 1; i < 20000; i += 2000)
+    {
+      merge[L"Item "s + to_wstring(i)][L"price"s] = -1;
+      merge[L"Item "s + to_wstring(i + 1)][L"discount"s] = 0.5;
+    }
+    merge[L"Item 5000"s] = nullptr;
+    Measure("Merge"s, bytes, [&] { auto json = items; json.Merge(merge); DoNotOptimize(json); });
+
+    auto size = [](Json const& json) { return json.Dump().size() * sizeof(wchar_t); };
+    cout << "  " << left << setw(48) << "document size"s << right << setw(12) << size(document) << endl;
+    cout << "  " << left << setw(48) << "patch size ("s + to_string(patch.Size()) + " operations)"s << right << setw(12) << size(patch) << endl;
+    cout << "  " << left << setw(48) << "merge patch size"s << right << setw(12) << size(merge) << endl;
+  }
+}
@@ -0,0 +1,78 @@
+#include "stdafx.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Benchmark
+{
+  // Looks up the same values of a 100 MB document 1000 times, by chaining operator[] and At, by JsonPointer and by JsonPath,
+  // both compiled once and compiled for every lookup. Then evaluates a filter and a recursive descent over the whole document.
+  BENCHMARK(JsonPath_RepeatedQueries)
+  {
+    // The document is built in parts, like in JsonLazy_ReadFields
+    auto parts = 165;
+    auto text = "{\r\n  \"meta\": { \"version\": 3, \"name\": \"JsonPath_RepeatedQueries\" },\r\n  \"items\": ["s;
+    for (int i = 0; i < parts; ++i)
+    {
+      auto part = WString2String(GenerateDocument(2000));
+      text += (i ? ",\r\n" : "\r\n") + part.substr(1, part.size() - 2);
+    }
+    text += "\r\n  ],\r\n  \"count\": " + to_string(parts * 2000) + "\r\n}";
+    auto bytes = text.size();
+    auto json = Json::Parse(string_view(text));
+    auto const& constant = json;
+    text = string();
+    cout << "  " << left << setw(48) << "document size"s << right << setw(12) << fixed << setprecision(1) << bytes / 1e6 << " MB" << endl;
+
+    auto repeat = 1000;
+    auto middle = (int64_t)parts * 1000;
+    auto sum = [&](auto&& lookup)
+    {
+      auto result = 0i64;
+      for (int i = 0; i < repeat; ++i)
+      {
+        result += lookup();
+      }
+      return result;
+    };
+    Measure("1000 x operator[] chain"s, 0, [&] {
+      DoNotOptimize(sum([&] { return (int64_t)json[L"items"][middle][L"size"][L"width"]; }));
+    });
+    auto items = KEY(L"items"), size = KEY(L"size"), width = KEY(L"width");
+    Measure("1000 x At with prebuilt keys"s, 0, [&] {
+      DoNotOptimize(sum([&] { return (int64_t)constant.At(items).At(middle).At(size).At(width); }));
+    });
+    auto pointer = JsonPointer(L"/items/" + to_wstring(middle) + L"/size/width");
+    Measure("1000 x JsonPointer compiled once"s, 0, [&] {
+      DoNotOptimize(sum([&] { return (int64_t)*pointer.Find(constant); }));
+    });
+    Measure("1000 x JsonPointer compiled every time"s, 0, [&] {
+      DoNotOptimize(sum([&] { return (int64_t)*JsonPointer(pointer.ToString()).Find(constant); }));
+    });
+    auto path = JsonPath(L"$.items[" + to_wstring(middle) + L"].size.width");
+    Measure("1000 x JsonPath compiled once"s, 0, [&] {
+      DoNotOptimize(sum([&] { return (int64_t)*path.First(constant); }));
+    });
+    Measure("1000 x JsonPath compiled every time"s, 0, [&] {
+      DoNotOptimize(sum([&] { return (int64_t)*JsonPath(path.ToString()).First(constant); }));
+    });
+
+    // The results are reused, so that only the first evaluation allocates
+    auto results = vector<Json const*>();
+    auto filter = JsonPath(L"$.items[?@.price < 1 && @.available == true].id");
+    Measure("JsonPath filter"s, bytes, [&] {
+      results.clear();
+      filter.Evaluate(constant, results);
+    });
+    cout << "  " << left << setw(48) << "filter matches"s << right << setw(12) << results.size() << endl;
+    auto descendant = JsonPath(L"$..width");
+    Measure("JsonPath recursive descent"s, bytes, [&] {
+      results.clear();
+      descendant.Evaluate(constant, results);
+    });
+    cout << "  " << left << setw(48) << "recursive descent matches"s << right << setw(12) << results.size() << endl;
+  }
+}
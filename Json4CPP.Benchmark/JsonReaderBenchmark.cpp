@@ -0,0 +1,70 @@
+#include "stdafx.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Benchmark
+{
+  // Compares pulling the tokens one by one from a UTF-8 std::istream with collecting all of them,
+  // and shows that the memory needed by the reader does not grow with the size of the input.
+  BENCHMARK(JsonReader_Read)
+  {
+    for (auto count : { 2000, 20000, 200000 })
+    {
+      auto utf8 = WString2String(GenerateDocument(count));
+      auto name = "document("s + to_string(count) + ")"s;
+      auto bytes = utf8.size();
+      Measure(name + " JsonLinter::Read(string_view)"s, bytes, [&] { DoNotOptimize(JsonLinter::Read(string_view(utf8))); });
+      Measure(name + " JsonReader(istream)"s, bytes, [&]
+      {
+        auto is = istringstream(utf8);
+        auto reader = JsonReader(is);
+        auto tokens = size_t(0);
+        while (reader.Read()) ++tokens;
+        DoNotOptimize(tokens);
+      });
+
+      // The stream holds its own copy of the input, so it is created before the baseline is taken
+      auto is = istringstream(utf8);
+      auto before = MemoryUsage();
+      auto tokens = JsonLinter::Read(string_view(utf8));
+      auto withTokens = MemoryUsage();
+      tokens = deque<TOKEN>();
+      auto baseline = MemoryUsage();
+      auto reader = JsonReader(is);
+      auto peak = baseline;
+      for (size_t i = 0; reader.Read(); ++i)
+      {
+        if (i % 4096 == 0) peak = max(peak, MemoryUsage());
+      }
+      cout << "  " << left << setw(48) << name + " memory of tokens / reader"s << right
+           << setw(12) << fixed << setprecision(1) << (withTokens - before) / 1e6 << " MB"
+           << setw(12) << (peak - baseline) / 1e6 << " MB" << endl;
+    }
+  }
+  // Parses a document pushed in chunks of different sizes, compared with parsing it at once from memory.
+  BENCHMARK(JsonPushParser_Push)
+  {
+    auto utf8 = WString2String(GenerateDocument(20000));
+    auto bytes = utf8.size();
+    Measure("Json::Parse(string_view)"s, bytes, [&] { DoNotOptimize(Json::Parse(string_view(utf8))); });
+    for (auto size : { 64, 4096, 65536 })
+    {
+      Measure("JsonPushParser::Push("s + to_string(size) + " bytes)"s, bytes, [&]
+      {
+        auto json = Json();
+        auto handler = JsonDomHandler(json);
+        auto parser = JsonPushParser(handler);
+        for (size_t position = 0; position < utf8.size(); position += size)
+        {
+          parser.Push(string_view(utf8).substr(position, size));
+        }
+        parser.Finish();
+        DoNotOptimize(json);
+      });
+    }
+  }
+}
@@ -0,0 +1,27 @@
+#include "stdafx.h"
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace Json4CPP::Benchmark;
+
+// Runs every registered benchmark, or only those whose name contains the first argument.
+int main(int argc, char* argv[])
+{
+  auto filter = argc > 1 ? string(argv[1]) : ""s;
+  for (auto& [name, function] : Registry())
+  {
+    if (name.find(filter) == string::npos) continue;
+    cout << name << endl;
+    try
+    {
+      function();
+    }
+    catch (exception const& e)
+    {
+      cout << "  Failed: " << e.what() << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -89,6 +89,60 @@ namespace Json4CPP::Test
       Assert::AreEqual(expected, output);
     }
 
+    TEST_METHOD(TestEscapeStringLong)
+    {
+      // The characters to escape at every position around the 16 and 32 byte boundaries of the scanning
+      auto pairs = vector<pair<wchar_t, wstring>>
+      {
+        { L'"'     , L"\\\""s     },
+        { L'\\'    , L"\\\\"s     },
+        { L'\t'    , L"\\t"s      },
+        { L'\x01'  , L"\\u0001"s  },
+        { L'\x1F'  , L"\\u001f"s  },
+        { L'\x7F'  , L"\x7F"s     },
+        { L'é', L"é"s   },
+      };
+
+      for (auto& [c, escaped] : pairs)
+      {
+        for (size_t i = 0; i < 70; ++i)
+        {
+          auto input    = wstring(i, L'a') + c       + wstring(70 - i, L'b');
+          auto expected = wstring(i, L'a') + escaped + wstring(70 - i, L'b');
+          Assert::AreEqual(expected, EscapeString(input));
+        }
+      }
+    }
+
+    TEST_METHOD(TestScanString)
+    {
+      // Every character to stop at, at every position of a string longer than two vectors
+      for (auto c : { L'"', L'\\', L'\0', L'\x1F', L'\x7F', L'\x80', L'\x9F' })
+      {
+        for (size_t i = 0; i < 70; ++i)
+        {
+          auto value = wstring(70, L'a');
+          value[i] = c;
+          auto bytes = string(70, 'a');
+          bytes[i] = (char)c;
+          Assert::AreEqual<size_t>(i, ScanString(value.data(), value.size()));
+          Assert::AreEqual<size_t>(i, ScanString(value.data(), value.size(), true));
+          Assert::AreEqual<size_t>(i, ScanString(bytes.data(), bytes.size()));
+        }
+      }
+
+      // Anything else is copied as it is, non-ASCII characters only if they do not have to be encoded
+      auto value = wstring();
+      for (auto c : { L' ', L'!', L'~', L'\xA0', L'Ω', (wchar_t)0xD83D, (wchar_t)0xFFFF })
+      {
+        value += wstring(10, c);
+      }
+      Assert::AreEqual<size_t>(value.size(), ScanString(value.data(), value.size()));
+      Assert::AreEqual<size_t>(30, ScanString(value.data(), value.size(), true));
+      auto bytes = WString2String(value.substr(0, 30));
+      Assert::AreEqual<size_t>(bytes.size(), ScanString(bytes.data(), bytes.size()));
+    }
+
     TEST_METHOD(TestWidenString)
     {
       auto expected = wstring{ ((wchar_t)-100) & 0x00FF, ((wchar_t)-50) & 0x00FF, 50, 100 };
@@ -121,6 +175,108 @@ namespace Json4CPP::Test
       Assert::AreEqual(expected, actual);
     }
 
+    TEST_METHOD(TestString2WStringRoundTrip)
+    {
+      // Code points at the boundaries of the 1, 2, 3 and 4 byte UTF-8 sequences, between and after runs of ASCII
+      auto pairs = vector<pair<string, wstring>>
+      {
+        { ""s                                                   , L""s                                              },
+        { u8"\u007F\u0080\u07FF\u0800\uD7FF\uE000\uFFFF"s        , L"\u007F\u0080\u07FF\u0800\uD7FF\uE000\uFFFF"s   },
+        { u8"\U00010000\U0001F600\U0010FFFF"s                    , L"\U00010000\U0001F600\U0010FFFF"s               },
+        { u8"0123456789abcdef0123456789abcdef\u00E1"s            , L"0123456789abcdef0123456789abcdef\u00E1"s       },
+        { u8"\u00E10123456789abcdef0123456789abcdef"s            , L"\u00E10123456789abcdef0123456789abcdef"s       },
+        { u8"0123456789abcde\u6F22\u5B570123456789abcdef012345"s , L"0123456789abcde\u6F22\u5B570123456789abcdef012345"s },
+      };
+      for (auto& [utf8, wide] : pairs)
+      {
+        Assert::AreEqual(wide, String2WString(utf8));
+        Assert::AreEqual(utf8, WString2String(wide));
+        for (size_t i = 0; i < 40; ++i)
+        {
+          auto prefix = string(i, 'x');
+          Assert::AreEqual(wstring(i, L'x') + wide, String2WString(prefix + utf8));
+          Assert::AreEqual(prefix + utf8, WString2String(wstring(i, L'x') + wide));
+        }
+      }
+
+      auto invalids = vector<pair<string, string>>
+      {
+        { "abc\x80"s                            , "Invalid UTF-8 sequence at byte 3!"s  },
+        { "0123456789abcdef0123\xC0\xAF"s        , "Invalid UTF-8 sequence at byte 20!"s },
+        { "\xE0\x80\xAF"s                        , "Invalid UTF-8 sequence at byte 0!"s  },
+        { "a\xED\xA0\x80"s                       , "Invalid UTF-8 sequence at byte 1!"s  },
+        { "ab\xF4\x90\x80\x80"s                  , "Invalid UTF-8 sequence at byte 2!"s  },
+        { "\xE6\xBC"s                            , "Invalid UTF-8 sequence at byte 0!"s  },
+      };
+      for (auto& [input, message] : invalids)
+      {
+        ExceptException<exception>([&]() { String2WString(input); }, message);
+      }
+      ExceptException<exception>([]() { WString2String(L"ab"s + wstring(1, (wchar_t)0xDC00)); }, "Invalid UTF-16 sequence at index 2!"s);
+      ExceptException<exception>([]() { WString2String(L"0123456789abcdef"s + wstring(1, (wchar_t)0xD800) + L"a"s); }, "Invalid UTF-16 sequence at index 16!"s);
+    }
+
+    TEST_METHOD(TestString2WStringWide)
+    {
+      // Where wchar_t is 4 bytes, every code point is a single character, and surrogates are never combined
+      if constexpr (sizeof(wchar_t) == 4)
+      {
+        auto wide = wstring{ (wchar_t)0x10000, (wchar_t)0x1F600, (wchar_t)0x10FFFF, L'a' };
+        auto utf8 = "\xF0\x90\x80\x80\xF0\x9F\x98\x80\xF4\x8F\xBF\xBF" "a"s;
+        Assert::AreEqual<size_t>(1, String2WString("\xF0\x9F\x98\x80"s).size());
+        for (size_t i = 0; i < 40; ++i)
+        {
+          auto prefix = string(i, 'x');
+          Assert::AreEqual(wstring(i, L'x') + wide, String2WString(prefix + utf8));
+          Assert::AreEqual(prefix + utf8, WString2String(wstring(i, L'x') + wide));
+          auto message = "Invalid UTF-16 sequence at index "s + to_string(i) + "!"s;
+          for (auto invalid : { 0xD800u, 0xDBFFu, 0xDC00u, 0xDFFFu, 0x110000u, 0xFFFFFFFFu })
+          {
+            ExceptException<exception>([&]() { WString2String(wstring(i, L'x') + wstring(1, (wchar_t)invalid) + L"a"s); }, message);
+          }
+          // A surrogate pair is two lone surrogates in UTF-32
+          ExceptException<exception>([&]() { WString2String(wstring(i, L'x') + wstring{ (wchar_t)0xD83D, (wchar_t)0xDE00 }); }, message);
+        }
+      }
+    }
+
+    TEST_METHOD(TestParallelFor)
+    {
+      for (size_t count = 0; count <= 8; ++count)
+      {
+        auto calls = vector<int>(count);
+        ParallelFor(count, [&](size_t index) { ++calls[index]; });
+        Assert::IsTrue(vector<int>(count, 1) == calls);
+      }
+
+      // Every index is called, even if some of them throw, and the exception of the lowest one is rethrown
+      auto calls = vector<int>(6);
+      ExceptException<exception>([&]()
+      {
+        ParallelFor(calls.size(), [&](size_t index)
+        {
+          ++calls[index];
+          if (index % 2)
+          {
+            auto message = "Error "s + to_string(index) + "!"s;
+            throw exception(message.c_str());
+          }
+        });
+      }, "Error 1!");
+      Assert::IsTrue(vector<int>(6, 1) == calls);
+    }
+
+    TEST_METHOD(TestIsSynchronized)
+    {
+      auto pool = pmr::synchronized_pool_resource();
+      auto unsynchronized = pmr::unsynchronized_pool_resource();
+      auto arena = pmr::monotonic_buffer_resource();
+      Assert::IsTrue (IsSynchronized(pmr::new_delete_resource()));
+      Assert::IsTrue (IsSynchronized(&pool));
+      Assert::IsFalse(IsSynchronized(&unsynchronized));
+      Assert::IsFalse(IsSynchronized(&arena));
+    }
+
     TEST_METHOD(TestGetStreamPosition)
     {
       auto ss = wstringstream(L"abc\r\n"
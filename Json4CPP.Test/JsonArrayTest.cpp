@@ -161,6 +161,23 @@ namespace Json4CPP::Test
       Assert::AreEqual<Json>(3, array2[2]);
     }
 
+    TEST_METHOD(TestConstructorMemoryResource)
+    {
+      auto resource = CountingResource();
+      auto array = JsonArray(&resource);
+      array.PushBack(1);
+      array.PushBack(L"2"s);
+      Assert::IsTrue(resource.allocations > 0);
+
+      // Copies are allocated from the default resource
+      auto allocations = resource.allocations;
+      auto copy = array;
+      copy.PushBack(3);
+      Assert::AreEqual(allocations, resource.allocations);
+      Assert::AreEqual(JsonArray{ 1, L"2"s, 3 }, copy);
+      Assert::AreEqual(JsonArray{ 1, L"2"s }, array);
+    }
+
     TEST_METHOD(TestDump)
     {
       JsonArray array = { nullptr, L"Test"s, true, 1337, {{ L"key1", 1 }, { L"key2", 2 }}, { 1, 2, 3 } };
@@ -249,6 +266,81 @@ namespace Json4CPP::Test
       Assert::AreEqual(6i64, JsonArray{ nullptr, L"Test"s, true, 1337, {{ L"key1", 1 }, { L"key2", 2 }}, { 1, 2, 3 } }.Size());
     }
 
+    TEST_METHOD(TestHash)
+    {
+      auto array = JsonArray{ 1, { { L"Key1", 1.0 } }, { true, nullptr } };
+      // Equal arrays hash the same, even if their numbers are of different types
+      auto same = JsonArray{ 1.0, { { L"Key1", true } }, { 1, nullptr } };
+      Assert::IsTrue(array == same);
+      Assert::AreEqual(array.Hash(), same.Hash());
+      Assert::IsTrue(hash<JsonArray>()(array) == (size_t)array.Hash());
+      Assert::AreEqual(JsonArray().Hash(), JsonArray{}.Hash());
+      Assert::AreEqual(JsonArray{ 0.0 }.Hash(), JsonArray{ -0.0 }.Hash());
+      Assert::AreNotEqual(JsonArray{ 1, 2 }.Hash(), JsonArray{ 2, 1 }.Hash());
+      Assert::AreNotEqual(JsonArray{ 1 }.Hash(), JsonArray{ 1, 1 }.Hash());
+      Assert::AreNotEqual(JsonArray{ JsonArray() }.Hash(), JsonArray{ JsonObject() }.Hash());
+
+      // Every non-const access drops the cached hash, also when a nested value is changed
+      auto hash = array.Hash();
+      array[0] = 2;
+      Assert::AreNotEqual(hash, array.Hash());
+      array.At(0) = 1;
+      Assert::AreEqual(hash, array.Hash());
+      array[1][L"Key1"] = 2;
+      Assert::AreNotEqual(hash, array.Hash());
+      *array.Find(1) = { { L"Key1", 1 } };
+      Assert::AreEqual(hash, array.Hash());
+      array.At(2).PushBack(3);
+      Assert::AreNotEqual(hash, array.Hash());
+      array.At(2).Erase(2);
+      Assert::AreEqual(hash, array.Hash());
+      for (auto& value : array)
+      {
+        value = 0;
+      }
+      Assert::AreEqual(JsonArray{ 0, 0, 0 }.Hash(), array.Hash());
+      array.PushBack(1);
+      array.EmplaceBack(2);
+      array.Insert(0, 3);
+      Assert::AreEqual(JsonArray{ 3, 0, 0, 0, 1, 2 }.Hash(), array.Hash());
+      array.Erase(0);
+      array.Resize(3);
+      Assert::AreEqual(JsonArray{ 0, 0, 0 }.Hash(), array.Hash());
+      array.Clear();
+      Assert::AreEqual(JsonArray().Hash(), array.Hash());
+
+      // Copies keep the cached hash, moved from arrays drop it
+      same.Hash();
+      auto copy = same;
+      Assert::AreEqual(same.Hash(), copy.Hash());
+      auto moved = move(copy);
+      Assert::AreEqual(same.Hash(), moved.Hash());
+      copy = JsonArray();
+      Assert::AreEqual(JsonArray().Hash(), copy.Hash());
+
+      // Values changed through references obtained before the hash is computed are noticed as well
+      auto equal = JsonArray{ 5, { 5, 2 } };
+      equal.Hash();
+      auto changed = JsonArray{ 1, { 1, 2 } };
+      auto& value = changed[0];
+      changed.Hash();
+      value = 5;
+      auto& element = changed[1][0];
+      changed.Hash();
+      element = 5;
+      Assert::IsTrue(changed == equal);
+      Assert::AreEqual(equal.Hash(), changed.Hash());
+      // Also after the array is moved, as the references refer to the values of the new array
+      auto original = JsonArray{ 1, { 1, 2 } };
+      auto& first = original[0];
+      auto target = move(original);
+      target.Hash();
+      first = 5;
+      target[1][0] = 5;
+      Assert::IsTrue(target == equal);
+      Assert::AreEqual(equal.Hash(), target.Hash());
+    }
+
     TEST_METHOD(TestResize)
     {
       auto array = JsonArray();
@@ -286,6 +378,37 @@ namespace Json4CPP::Test
       Assert::AreEqual<Json>({ 1, 2, 3 }, array[5]);
     }
 
+    TEST_METHOD(TestEmplaceBack)
+    {
+      JsonArray array;
+      Assert::AreEqual<Json>(nullptr, array.EmplaceBack());
+      Assert::AreEqual<Json>(L"Test"s, array.EmplaceBack(L"Test"s));
+      Assert::AreEqual<Json>(1337, array.EmplaceBack(1337));
+      array.EmplaceBack(JsonObject{ { L"key1", 1 }, { L"key2", 2 } })[L"key3"] = 3;
+      Assert::AreEqual(4i64, array.Size());
+      Assert::AreEqual<Json>({ { L"key1", 1 }, { L"key2", 2 }, { L"key3", 3 } }, array[3]);
+
+      // Nested containers are moved into the array instead of copied, if they use the same memory resource
+      auto resource = CountingResource();
+      auto target = JsonArray(&resource);
+      auto nested = JsonArray(&resource);
+      nested.PushBack(1);
+      auto address = &as_const(nested).At(0);
+      target.EmplaceBack(move(nested));
+      target.PushBack(JsonArray(move(*target[0].GetIf<JsonArray>())));
+      Assert::IsTrue(address == &as_const(target).At(1).Get<JsonArray>().At(0));
+
+      // Otherwise they are copied into the resource of the array
+      nested = JsonArray(&resource);
+      nested.PushBack(1);
+      auto allocations = resource.allocations;
+      array.EmplaceBack(move(nested));
+      array.PushBack(JsonArray(move(*array[4].GetIf<JsonArray>())));
+      array[5].PushBack(2);
+      Assert::AreEqual(allocations, resource.allocations);
+      Assert::AreEqual<Json>({ 1, 2 }, array[5]);
+    }
+
     TEST_METHOD(TestInsert)
     {
       JsonArray array;
@@ -349,11 +472,12 @@ namespace Json4CPP::Test
       Assert::AreEqual<Json>({ { L"key1", 1 }, { L"key2", 2 } }, array.At(4));
       Assert::AreEqual<Json>({ 1, 2, 3 }, array.At(5));
 
+      // The values are returned by reference, without copying them
+      static_assert(is_same_v<decltype(array.At(0)), Json const&>);
       for (int i = 0; i < 6; ++i)
       {
-        array.At(i) = 9999;
-        Assert::AreNotEqual<Json>(9999, array.At(i));
         Assert::AreEqual<Json>(vec[i], array.At(i));
+        Assert::IsTrue(&array.At(i) == &*(array.begin() + i));
       }
     }
 
@@ -374,6 +498,24 @@ namespace Json4CPP::Test
       }
     }
 
+    TEST_METHOD(TestFind)
+    {
+      auto array = JsonArray{ nullptr, 1337, { 1, 2, 3 } };
+      auto const& constArray = array;
+      for (int i = 0; i < 3; ++i)
+      {
+        Assert::IsTrue(array.Find(i) == &array.At(i));
+        Assert::IsTrue(constArray.Find(i) == &constArray.At(i));
+      }
+      Assert::IsNull(array.Find(-1));
+      Assert::IsNull(array.Find(3));
+      Assert::IsNull(constArray.Find(3));
+      Assert::IsNull(JsonArray().Find(0));
+
+      *array.Find(1) = 9999;
+      Assert::AreEqual<Json>(9999, array.At(1));
+    }
+
     TEST_METHOD(TestIterator)
     {
       auto array = JsonArray{ 1, 2, 3, 4, 5 };
@@ -766,5 +908,137 @@ namespace Json4CPP::Test
       Assert::IsFalse(JsonArray{ 1, 2 } != JsonArray{ 1, 2 });
       Assert::IsTrue (JsonArray{ 1, 2 } != JsonArray{ 1, 2, 3 });
     }
+
+    TEST_METHOD(TestOperatorEqualHash)
+    {
+      // Unequal arrays with cached hashes are told apart without comparing the values, equal ones are still compared
+      auto left = JsonArray{ { 1, 2, 3 }, { { L"Key1", L"Value" } } };
+      auto right = left;
+      left.Hash();
+      right.Hash();
+      Assert::IsTrue(left == right);
+      Assert::IsFalse(left != right);
+      right[1][L"Key1"] = L"Other";
+      Assert::IsFalse(left == right);
+      right.Hash();
+      Assert::IsFalse(left == right);
+      Assert::IsTrue(left != right);
+      right[1][L"Key1"] = L"Value";
+      right.Hash();
+      Assert::IsTrue(left == right);
+    }
+
+    TEST_METHOD(TestCopyOnWrite)
+    {
+      // Copies share the values until one of them is modified, which copies them then
+      auto original = JsonArray{ 1, L"Value", { 2, 3 } };
+      auto const& constOriginal = original;
+      auto copy = original;
+      auto const& constCopy = copy;
+      Assert::IsTrue(&constOriginal.At(0) == &constCopy.At(0));
+      Assert::IsTrue(original == copy);
+      copy[0] = 2;
+      Assert::IsTrue(&constOriginal.At(0) != &constCopy.At(0));
+      Assert::AreEqual<Json>(1, constOriginal.At(0));
+      Assert::AreEqual<Json>(2, constCopy.At(0));
+      // The nested array is still shared, only the array on the path to the modified value is copied
+      Assert::IsTrue(&constOriginal.At(2).At(0) == &constCopy.At(2).At(0));
+      copy[2][0] = 4;
+      Assert::IsTrue(&constOriginal.At(2).At(0) != &constCopy.At(2).At(0));
+      Assert::AreEqual<Json>(2, constOriginal.At(2).At(0));
+
+      copy = original;
+      copy.PushBack(4);
+      Assert::AreEqual(3i64, original.Size());
+      Assert::AreEqual(4i64, copy.Size());
+      copy = original;
+      copy.Insert(0, 0);
+      Assert::AreEqual<Json>(1, constOriginal.At(0));
+      Assert::AreEqual<Json>(0, constCopy.At(0));
+      copy = original;
+      copy.Erase(0);
+      Assert::AreEqual(3i64, original.Size());
+      Assert::AreEqual(2i64, copy.Size());
+      copy = original;
+      copy.Resize(1);
+      Assert::AreEqual(3i64, original.Size());
+      copy = original;
+      copy.Clear();
+      Assert::AreEqual(3i64, original.Size());
+      Assert::AreEqual(0i64, copy.Size());
+      copy = original;
+      for (auto& value : copy)
+      {
+        value = nullptr;
+      }
+      Assert::AreEqual<Json>(1, constOriginal.At(0));
+      // Lookups out of range leave the values shared
+      copy = original;
+      Assert::IsNull(copy.Find(3));
+      Assert::IsTrue(&constOriginal.At(0) == &constCopy.At(0));
+
+      // Arrays allocated from other resources are copied right away
+      auto resource = pmr::monotonic_buffer_resource();
+      auto arena = JsonArray(&resource);
+      arena.PushBack(1);
+      auto const& constArena = arena;
+      auto fromArena = arena;
+      Assert::IsTrue(&constArena.At(0) != &as_const(fromArena).At(0));
+      auto toArena = JsonArray(&resource);
+      toArena = arena;
+      Assert::IsTrue(&constArena.At(0) == &as_const(toArena).At(0));
+    }
+
+    TEST_METHOD(TestCopyAfterReference)
+    {
+      // Once references or iterators to the values are handed out, the copies made after that do not share the values,
+      // so writing through those does not change the copies
+      auto array = JsonArray{ 1, { 2, 3 } };
+      auto const& constArray = array;
+      auto& value = array[0];
+      auto copy = array;
+      auto const& constCopy = copy;
+      value = 2;
+      Assert::AreEqual<Json>(1, constCopy.At(0));
+      Assert::AreEqual<Json>(2, constArray.At(0));
+      copy = array;
+      array.At(0) = 3;
+      *array.Find(0) = 4;
+      Assert::AreEqual<Json>(2, constCopy.At(0));
+      auto iterator = array.begin();
+      copy = array;
+      *iterator = 5;
+      Assert::AreEqual<Json>(4, constCopy.At(0));
+      auto& last = array.EmplaceBack(6);
+      copy = array;
+      last = 7;
+      Assert::AreEqual<Json>(6, constCopy.At(2));
+      Assert::AreEqual<Json>(7, constArray.At(2));
+
+      // The same for references to nested values, the arrays on the way are not shared either
+      auto& nested = array[1][0];
+      copy = array;
+      nested = 8;
+      Assert::AreEqual<Json>(2, constCopy.At(1).At(0));
+      Assert::AreEqual<Json>(8, constArray.At(1).At(0));
+
+      // The copies of the copies share their values again
+      auto other = copy;
+      Assert::IsTrue(&constCopy.At(0) == &as_const(other).At(0));
+
+      // Modifying the array invalidates the references handed out before, so it shares its values again after that
+      array.PushBack(9);
+      auto shared = array;
+      Assert::IsTrue(&constArray.At(0) == &as_const(shared).At(0));
+      array.Erase(3);
+      Assert::IsTrue(&constArray.At(0) != &as_const(shared).At(0));
+      Assert::AreEqual<Json>(9, as_const(shared).At(3));
+      // So does an assignment
+      auto& reference = shared[0];
+      reference = 10;
+      shared = JsonArray{ 11 };
+      auto assigned = shared;
+      Assert::IsTrue(&as_const(shared).At(0) == &as_const(assigned).At(0));
+    }
   };
 }
\ No newline at end of file
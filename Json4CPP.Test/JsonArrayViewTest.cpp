@@ -0,0 +1,68 @@
+#include "stdafx.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Test
+{
+  TEST_CLASS(JsonArrayViewTest)
+  {
+  public:
+    TEST_METHOD(TestConstructor)
+    {
+      auto array = JsonArray{ 1, L"Test"s, { { L"Key1", 1 } } };
+      auto view = JsonArrayView(array);
+      Assert::IsTrue(&view.Array() == &array);
+      Assert::AreEqual(3i64, view.Size());
+      Assert::AreEqual(array.Dump(), view.Dump());
+      Assert::AreEqual(array.Dump(2), view.Dump(2));
+
+      // Changes of the array are seen through the view
+      array.PushBack(4);
+      Assert::AreEqual(4i64, view.Size());
+    }
+
+    TEST_METHOD(TestAt)
+    {
+      auto array = JsonArray{ 1, { 1, 2, 3 }, { { L"Key1", 1 } } };
+      auto view = JsonArrayView(array);
+      Assert::AreEqual<Json>(1, view.At(0));
+      Assert::AreEqual<Json>(1, view[0]);
+      Assert::AreEqual<Json>(3, view.At(1).At(2));
+      Assert::AreEqual<Json>(1, view[2].At(L"Key1"));
+      for (int i = 0; i < 3; ++i)
+      {
+        Assert::IsTrue(&view.At(i) == &array.At(i));
+        Assert::IsTrue(&view[i] == &array.At(i));
+      }
+    }
+
+    TEST_METHOD(TestFind)
+    {
+      auto array = JsonArray{ 1, 2, 3 };
+      auto view = JsonArrayView(array);
+      for (int i = 0; i < 3; ++i)
+      {
+        Assert::IsTrue(view.Find(i) == &array.At(i));
+      }
+      Assert::IsNull(view.Find(-1));
+      Assert::IsNull(view.Find(3));
+    }
+
+    TEST_METHOD(TestIterator)
+    {
+      auto array = JsonArray{ 1, 2, 3 };
+      auto view = JsonArrayView(array);
+      auto i = 0;
+      for (auto& value : view)
+      {
+        Assert::AreEqual<Json>(i + 1, value);
+        Assert::IsTrue(&value == &array.At(i));
+        ++i;
+      }
+      Assert::AreEqual(3, i);
+    }
+  };
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "stdafx.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Test
+{
+  TEST_CLASS(JsonBackendTest)
+  {
+  public:
+    TEST_METHOD(TestOperatorInsertion)
+    {
+      auto pairs = vector<pair<JsonBackend, wstring>>
+      {
+        { JsonBackend::Linter         , L"Linter"s          },
+        { JsonBackend::StructuralIndex, L"StructuralIndex"s },
+      };
+      for (auto& [input, expected] : pairs)
+      {
+        wostringstream os;
+        os << input;
+        Assert::AreEqual(expected, os.str());
+      }
+    }
+  };
+}
\ No newline at end of file
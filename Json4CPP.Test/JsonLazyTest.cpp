@@ -0,0 +1,172 @@
+﻿#include "stdafx.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Test
+{
+  TEST_CLASS(JsonLazyTest)
+  {
+  private:
+    template<typename F>
+    static string Message(F func)
+    {
+      try
+      {
+        func();
+      }
+      catch (exception const& e)
+      {
+        return e.what();
+      }
+      return ""s;
+    }
+
+    // Builds the Json through Keys, Size and At, so every value is reached through the index instead of parsing its container.
+    static Json Walk(JsonLazy const& lazy)
+    {
+      switch (lazy.Type())
+      {
+      case JsonType::Object:
+      {
+        auto json = Json(JsonObject());
+        for (auto& key : lazy.Keys())
+        {
+          json.Insert({ key, Walk(lazy.At(key)) });
+        }
+        return json;
+      }
+      case JsonType::Array:
+      {
+        auto json = Json(JsonArray());
+        for (int64_t i = 0; i < lazy.Size(); ++i)
+        {
+          json.PushBack(Walk(lazy.At(i)));
+        }
+        return json;
+      }
+      default:
+        return (Json)lazy;
+      }
+    }
+
+  public:
+    TEST_METHOD(TestRead)
+    {
+      for (auto& file : CorpusFiles())
+      {
+        auto expected = Json::Read(file);
+        auto text = ReadAllText(file);
+        for (auto& lazy : { JsonLazy::Read(file), JsonLazy::Parse(wstring_view(text)), JsonLazy::Parse(string_view(WString2String(text))) })
+        {
+          Assert::AreEqual(expected, (Json)lazy);
+          Assert::AreEqual(expected, Walk(lazy));
+          Assert::AreEqual(expected.Dump(2), lazy.Dump(2));
+        }
+      }
+    }
+
+    TEST_METHOD(TestAt)
+    {
+      auto lazy = JsonLazy::Parse(LR"({
+        "null": null, "string": "a\"b]}", "true": true, "false" : false,
+        "integer": -12, "real": 2.5e3, "big": 12345678901234567890,
+        "object": { "nested": { "deep": [ 1, { "x": "y" }, [] ] }, "empty": {} },
+        "array" : [ [ 1, 2 ], {}, "]", 3 ],
+        "escaped": 1, "Ω": "Ω", "\\": 2,
+        "duplicate": 1, "duplicate": 2
+      })"sv);
+      Assert::AreEqual<JsonType>(JsonType::Object , lazy.Type());
+      Assert::AreEqual<JsonType>(JsonType::Null   , lazy[L"null"s   ].Type());
+      Assert::AreEqual<JsonType>(JsonType::String , lazy[L"string"s ].Type());
+      Assert::AreEqual<JsonType>(JsonType::Boolean, lazy[L"true"s   ].Type());
+      Assert::AreEqual<JsonType>(JsonType::Integer, lazy[L"integer"s].Type());
+      Assert::AreEqual<JsonType>(JsonType::Real   , lazy[L"real"s   ].Type());
+      Assert::AreEqual<JsonType>(JsonType::Real   , lazy[L"big"s    ].Type());
+      Assert::AreEqual<JsonType>(JsonType::Object , lazy[L"object"s ].Type());
+      Assert::AreEqual<JsonType>(JsonType::Array  , lazy[L"array"s  ].Type());
+      Assert::IsTrue(lazy[L"null"s].Is(JsonType::Null));
+
+      Assert::AreEqual(nullptr       , (nullptr_t)lazy.At(L"null"s));
+      Assert::AreEqual(L"a\"b]}"s    , lazy.At(L"string"s).Get<wstring>());
+      Assert::AreEqual(true          , (bool)lazy.At(L"true"s));
+      Assert::AreEqual(false         , lazy.At(L"false"s).Get<bool>());
+      Assert::AreEqual<int64_t>(-12  , (int64_t)lazy.At(L"integer"s));
+      Assert::AreEqual<int32_t>(-12  , (int32_t)lazy.At(L"integer"s));
+      Assert::AreEqual(2500.0        , (double)lazy.At(L"real"s));
+      Assert::AreEqual(L"y"s         , (wstring)lazy[L"object"s][L"nested"s][L"deep"s][1][L"x"s]);
+      Assert::AreEqual<int64_t>(0    , lazy[L"object"s][L"nested"s][L"deep"s][2].Size());
+      Assert::AreEqual<int64_t>(0    , lazy[L"object"s][L"empty"s].Size());
+      Assert::AreEqual<int64_t>(2    , lazy[L"array"s][0][1].Get<int64_t>());
+      Assert::AreEqual(L"]"s         , (wstring)lazy[L"array"s][2]);
+      Assert::AreEqual<int64_t>(3    , (int64_t)lazy[L"array"s][3]);
+      Assert::AreEqual<int64_t>(4    , lazy[L"array"s].Size());
+      Assert::AreEqual<int64_t>(1    , (int64_t)lazy[L"escaped"s]);
+      Assert::AreEqual(L"Ω"s         , (wstring)lazy[L"Ω"s]);
+      Assert::AreEqual<int64_t>(2    , (int64_t)lazy[L"\\"s]);
+      Assert::AreEqual(Json{ { L"x"s, L"y"s } }, (Json)lazy[L"object"s][L"nested"s][L"deep"s][1]);
+      Assert::AreEqual(JsonArray{ 1, 2 }, (JsonArray)lazy[L"array"s][0]);
+      Assert::AreEqual(L"[1,2]"s, lazy[L"array"s][0].Dump());
+
+      // Duplicate keys are handled the same way as by Json::Parse, the first value is kept
+      Assert::AreEqual<int64_t>(1, (int64_t)lazy[L"duplicate"s]);
+      auto keys = vector<KEY>{ L"null"s, L"string"s, L"true"s, L"false"s, L"integer"s, L"real"s, L"big"s, L"object"s, L"array"s, L"escaped"s, L"Ω"s, L"\\"s, L"duplicate"s };
+      Assert::IsTrue(keys == lazy.Keys());
+      Assert::AreEqual<int64_t>(13, lazy.Size());
+      auto text = L"{"s;
+      for (int i = 0; i < 1000; ++i)
+      {
+        text += (i ? L", \"Key"s : L"\"Key"s) + to_wstring(i % 300) + L"\": "s + to_wstring(i);
+      }
+      auto large = JsonLazy::Parse(text + L"}"s);
+      Assert::AreEqual<int64_t>(300, large.Size());
+      Assert::AreEqual(L"Key299"s, large.Keys()[299]);
+      Assert::AreEqual<int64_t>(299, (int64_t)large[L"Key299"s]);
+
+      ExceptException<out_of_range>([&]() { lazy.At(L"missing"s); }, "Key not found: missing!"s);
+      ExceptException<out_of_range>([&]() { lazy[L"array"s][4]; }, "Index out of range: 4!"s);
+      ExceptException<exception>([&]() { lazy.At(0); }, "At(int index) is only defined for JsonArray!"s);
+      ExceptException<exception>([&]() { lazy[L"array"s][L"a"s]; }, "At(KEY key) is only defined for JsonObject!"s);
+      ExceptException<exception>([&]() { lazy[L"integer"s].Size(); }, "Size() is only defined for JsonObject and JsonArray!"s);
+      ExceptException<exception>([&]() { lazy[L"array"s].Keys(); }, "Keys() is only defined for JsonObject!"s);
+    }
+
+    TEST_METHOD(TestFail)
+    {
+      // Only the parts which are reached are validated, with the same messages and positions as by Json::Parse
+      auto text = u8"{ \"a\": [ 1, 2 3 ],\r\n  \"b\": { \"c\": tru }, \"d\": \"Ω\" }"s;
+      auto lazy = JsonLazy::Parse(text);
+      Assert::AreEqual(L"Ω"s, (wstring)lazy[L"d"s]);
+      Assert::AreEqual("Expected ',' or ']' at position Line: 1 Column: 15!"s, Message([&]() { lazy[L"a"s].Dump(); }));
+      Assert::AreEqual("Expected ',' or ']' at position Line: 1 Column: 15!"s, Message([&]() { lazy[L"a"s][2]; }));
+      Assert::AreEqual<int64_t>(2, (int64_t)lazy[L"a"s][1]);
+      Assert::AreEqual("Expected 'true' at position Line: 2 Column: 15!"s, Message([&]() { (bool)lazy[L"b"s][L"c"s]; }));
+      Assert::AreEqual(Message([&]() { Json::Parse(text); }), Message([&]() { (Json)lazy; }));
+
+      // The brackets are checked by Parse
+      auto pairs = vector<pair<string, string>>
+      {
+        { "{ \"a\": [ } ]"s     , "Unexpected '}' at position Line: 1 Column: 10!"s },
+        { "[\r\n  [ 1, 2 ]"s    , "Expected ',' or ']' at position Line: 2 Column: 11!"s },
+        { "[ \"a\\\" ]"s         , "Expected '\"' at position Line: 1 Column: 9!"s },
+        { "[] 1"s               , Message([]() { Json::Parse("[] 1"sv); }) },
+        { "\"a\""s              , Message([]() { Json::Parse("\"a\""sv); }) },
+      };
+      for (auto& [input, expected] : pairs)
+      {
+        Assert::AreEqual(expected, Message([&]() { JsonLazy::Parse(input); }));
+      }
+
+      // Every document which fails to parse fails when it is parsed entirely through JsonLazy too
+      for (auto& file : Files(L"fail"s, 33))
+      {
+        if (Message([&]() { Json::Read(file); }).size())
+        {
+          Assert::AreNotEqual(""s, Message([&]() { Walk(JsonLazy::Read(file)); }));
+        }
+      }
+    }
+  };
+}
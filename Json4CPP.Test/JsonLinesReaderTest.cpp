@@ -0,0 +1,187 @@
+#include "stdafx.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Test
+{
+  TEST_CLASS(JsonLinesReaderTest)
+  {
+  private:
+    // One record for each of the roundtrip files, dumped on a single line.
+    static vector<Json> Records()
+    {
+      auto records = vector<Json>();
+      for (int i = 1; i <= 27; ++i)
+      {
+        auto& record = records.emplace_back();
+        auto handler = JsonDomHandler(record);
+        JsonLinter::Read(ReadAllText(L"roundtrip"s + (i < 10 ? L"0"s : L""s) + to_wstring(i) + L".json"s), handler);
+      }
+      return records;
+    }
+
+    static string Lines(vector<Json> const& records, string const& separator)
+    {
+      auto text = ""s;
+      for (auto& record : records)
+      {
+        text += WString2String(record.Dump(0)) + separator;
+      }
+      return text;
+    }
+  public:
+    TEST_METHOD(TestRead)
+    {
+      auto expected = Records();
+      for (auto& separator : { "\n"s, "\r\n"s, "\n\n  \t\r\n"s })
+      {
+        auto is = istringstream(Lines(expected, separator));
+        auto reader = JsonLinesReader(is);
+        auto json = Json();
+        for (auto& record : expected)
+        {
+          Assert::IsTrue(reader.Read(json));
+          Assert::AreEqual(record, json);
+        }
+        Assert::IsFalse(reader.Read(json));
+      }
+
+      // The last line does not need a line ending, any value is a record, and the lines are counted from 1
+      auto is = istringstream("\n{ \"a\": [1, 2] }\r\n\r\n  \"b\"  \nnull\n3.5"s);
+      auto reader = JsonLinesReader(is);
+      auto json = Json();
+      Assert::AreEqual<uint64_t>(0, reader.Line());
+      auto records = vector<pair<Json, uint64_t>>
+      {
+        { Json{ { L"a"s, Json{ 1, 2 } } }, 2 },
+        { L"b"s                          , 4 },
+        { nullptr                        , 5 },
+        { 3.5                            , 6 },
+      };
+      for (auto& [record, line] : records)
+      {
+        Assert::IsTrue(reader.Read(json));
+        Assert::AreEqual(record, json);
+        Assert::AreEqual(line, reader.Line());
+      }
+      Assert::IsFalse(reader.Read(json));
+      Assert::IsFalse(reader.Read(json));
+    }
+
+    TEST_METHOD(TestReadFail)
+    {
+      // The errors report the line in the whole input, and the reader continues with the next line
+      auto is = istringstream("[1]\n[1, 2\n\n{ \"a\": 1 }\n1 2\r\n{ \"b\": \xC3\xA9 }\n\"\\x\"\n[4]"s);
+      auto reader = JsonLinesReader(is);
+      auto json = Json();
+      auto read = [&](string const& expected)
+      {
+        ExceptException<exception>([&]() { reader.Read(json); }, expected);
+      };
+      Assert::IsTrue(reader.Read(json));
+      Assert::AreEqual(Json{ 1 }, json);
+      read("Expected ',' or ']' at position Line: 2 Column: 6!"s);
+      Assert::IsTrue(reader.Read(json));
+      Assert::AreEqual(Json{ { L"a"s, 1 } }, json);
+      read("Unexpected '2' at position Line: 5 Column: 3!"s);
+      read("Expected one of the following characters: 'n', '\"', 't', 'f', '-', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '{' or '[' at position Line: 6 Column: 8!"s);
+      read("Expected one of the following characters: '\"', '\\', '/', 'b', 'f', 'n', 'r', 't' or 'u' at position Line: 7 Column: 3!"s);
+      Assert::IsTrue(reader.Read(json));
+      Assert::AreEqual(Json{ 4 }, json);
+      Assert::AreEqual<uint64_t>(8, reader.Line());
+      Assert::IsFalse(reader.Read(json));
+
+      ExceptException<exception>([]() { JsonLinesReader(L"missing.jsonl"s); }, "Could not open file: missing.jsonl!"s);
+    }
+
+    TEST_METHOD(TestReadBatch)
+    {
+      auto expected = Records();
+      auto text = Lines(expected, "\r\n"s);
+      auto threads = JsonDefault::Threads;
+      for (auto number : { 1, 4 })
+      {
+        JsonDefault::Threads = (uint8_t)number;
+        for (size_t count = 1; count <= expected.size() + 1; ++count)
+        {
+          auto is = istringstream(text);
+          auto reader = JsonLinesReader(is);
+          auto records = vector<Json>();
+          auto actual = vector<Json>();
+          while (auto size = reader.Read(records, count))
+          {
+            Assert::AreEqual(size, records.size());
+            Assert::IsTrue(size <= count);
+            actual.insert(actual.end(), records.begin(), records.end());
+          }
+          Assert::IsTrue(records.empty());
+          Assert::IsTrue(expected == actual);
+          Assert::AreEqual<uint64_t>(expected.size(), reader.Line());
+        }
+      }
+
+      // Large enough to be parsed on 4 threads, the first error in the batch is thrown
+      auto large = vector<Json>();
+      auto size = size_t(0);
+      while (size < 5 * JsonLinter::ParallelPartSize)
+      {
+        large.insert(large.end(), expected.begin(), expected.end());
+        size += text.size();
+      }
+      for (auto number : { 1, 4 })
+      {
+        JsonDefault::Threads = (uint8_t)number;
+        auto is = istringstream(Lines(large, "\n"s));
+        auto reader = JsonLinesReader(is);
+        auto records = vector<Json>();
+        Assert::AreEqual(large.size(), reader.Read(records, large.size() + 1));
+        Assert::IsTrue(large == records);
+        Assert::AreEqual(large.size(), (size_t)reader.Line());
+
+        // The lines are inserted after the end of a line in the middle, and in the last quarter
+        auto lines = Lines(large, "\n"s);
+        lines.insert(lines.find('\n', lines.size() * 3 / 4) + 1, "[1 2]\n"s);
+        auto position = lines.find('\n', lines.size() / 2) + 1;
+        lines.insert(position, "[\n"s);
+        auto line = count(lines.begin(), lines.begin() + position, '\n') + 1;
+        is = istringstream(lines);
+        auto failing = JsonLinesReader(is, pmr::new_delete_resource());
+        try
+        {
+          failing.Read(records, large.size() + 2);
+          Assert::Fail();
+        }
+        catch (exception const& e)
+        {
+          Assert::AreEqual("Expected one of the following characters: 'n', '\"', 't', 'f', '-', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '{' or '[' at position Line: "s + to_string(line) + " Column: 2!"s, string(e.what()));
+        }
+        Assert::AreEqual<size_t>(0, failing.Read(records, 1));
+      }
+      JsonDefault::Threads = threads;
+    }
+
+    TEST_METHOD(TestReadFile)
+    {
+      auto expected = Records();
+      auto file = L"JsonLinesReaderTest.jsonl"s;
+      {
+        auto os = ofstream(filesystem::path(file), ofstream::out | ofstream::binary);
+        os << Lines(expected, "\n"s);
+      }
+      {
+        auto reader = JsonLinesReader(filesystem::path(file));
+        auto json = Json();
+        for (auto& record : expected)
+        {
+          Assert::IsTrue(reader.Read(json));
+          Assert::AreEqual(record, json);
+        }
+        Assert::IsFalse(reader.Read(json));
+      }
+      filesystem::remove(file);
+    }
+  };
+}
\ No newline at end of file
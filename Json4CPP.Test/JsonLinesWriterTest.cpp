@@ -0,0 +1,91 @@
+#include "stdafx.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Test
+{
+  TEST_CLASS(JsonLinesWriterTest)
+  {
+  public:
+    TEST_METHOD(TestWrite)
+    {
+      auto records = vector<Json>
+      {
+        Json{ { L"a"s, Json{ 1, 2.5, nullptr } }, { L"b"s, L"line\r\nbreak"s } },
+        Json{ 1, Json{ 2, Json{ 3 } } },
+        L"\u00E9\u03A9"s,
+        1337,
+        true,
+        nullptr,
+        Json(JsonObject()),
+        Json(JsonArray()),
+      };
+      auto expected = ""s;
+      for (auto& record : records)
+      {
+        expected += WString2String(record.Dump(0)) + "\n"s;
+      }
+
+      auto os = ostringstream();
+      {
+        auto writer = JsonLinesWriter(os);
+        for (auto& record : records)
+        {
+          writer.Write(record);
+        }
+        // Nothing is written until the buffer is full, flushed, or the writer is destroyed
+        Assert::AreEqual(""s, os.str());
+        writer.Flush();
+        Assert::AreEqual(expected, os.str());
+        writer.Write(records[0]);
+      }
+      Assert::AreEqual(expected + WString2String(records[0].Dump(0)) + "\n"s, os.str());
+
+      // The records can be read back, even those with line breaks in their strings
+      auto is = istringstream(os.str());
+      auto reader = JsonLinesReader(is);
+      auto json = Json();
+      for (auto& record : records)
+      {
+        Assert::IsTrue(reader.Read(json));
+        Assert::AreEqual(record, json);
+      }
+    }
+
+    TEST_METHOD(TestWriteLarge)
+    {
+      auto record = Json{ { L"id"s, 123456 }, { L"name"s, L"JsonLinesWriterTest"s }, { L"values"s, Json{ 1.5, true, nullptr } } };
+      auto line = WString2String(record.Dump(0)) + "\n"s;
+      auto count = 4 * JsonWriter::BufferSize / line.size();
+      auto os = ostringstream();
+      auto writer = JsonLinesWriter(os);
+      for (size_t i = 0; i < count; ++i)
+      {
+        writer.Write(record);
+        // The buffer is written to the stream as soon as it is full
+        Assert::IsTrue(os.str().size() + JsonWriter::BufferSize >= (i + 1) * line.size());
+      }
+      writer.Flush();
+      Assert::AreEqual(count * line.size(), os.str().size());
+      for (size_t i = 0; i < count; ++i)
+      {
+        Assert::AreEqual(0, os.str().compare(i * line.size(), line.size(), line));
+      }
+    }
+
+    TEST_METHOD(TestWriteFile)
+    {
+      auto file = L"JsonLinesWriterTest.jsonl"s;
+      {
+        auto writer = JsonLinesWriter(filesystem::path(file));
+        writer.Write(Json{ 1, 2 });
+        writer.Write(Json{ { L"a"s, L"b"s } });
+      }
+      Assert::AreEqual("[1,2]\n{\"a\":\"b\"}\n"s, ReadAllBytes(file));
+      filesystem::remove(file);
+    }
+  };
+}
\ No newline at end of file
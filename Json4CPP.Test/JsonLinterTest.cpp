@@ -101,6 +101,50 @@ namespace Json4CPP::Test
       }
     }
 
+    TEST_METHOD(TestParseLongString)
+    {
+      // Escapes and non-ASCII characters at every position around the 16 and 32 byte boundaries of the scanning
+      auto pairs = vector<pair<wstring, wstring>>
+      {
+        { L"\\\""s    , L"\""s     },
+        { L"\\\\"s    , L"\\"s     },
+        { L"\\n"s     , L"\n"s     },
+        { L"\\u03A9"s , L"Ω"s },
+        { L"é"s  , L"é"s },
+        { L"€"s  , L"€"s },
+        { L" ~ "s, L" ~ "s },
+      };
+
+      for (auto& [piece, expected] : pairs)
+      {
+        for (size_t i = 0; i < 70; ++i)
+        {
+          auto input = L"\""s + wstring(i, L'a') + piece + wstring(70 - i, L'b') + L"\""s;
+          auto output = wstring(i, L'a') + expected + wstring(70 - i, L'b');
+          auto bytes = WString2String(input);
+          auto is = istringstream(bytes);
+          for (auto& tokens : { JsonLinter::Read(input), JsonLinter::Read(bytes), JsonLinter::Read(is) })
+          {
+            Assert::AreEqual<size_t>(1, tokens.size());
+            Assert::AreEqual<VALUE_TOKEN>(output, tokens[0].second);
+          }
+        }
+      }
+
+      // Control characters are rejected wherever they are
+      for (auto c : { L'\x01', L'\x1F', L'\x7F', L'\x85' })
+      {
+        for (size_t i = 0; i < 70; ++i)
+        {
+          auto input = L"\""s + wstring(i, L'a') + c + wstring(70 - i, L'b') + L"\""s;
+          auto exceptionMessage = "Invalid character found at position Line: 1 Column: "s + to_string(i + 2) + "!"s;
+          ExceptException<exception>([&]() { JsonLinter::Read(input); }, exceptionMessage);
+          ExceptException<exception>([&]() { JsonLinter::Read(WString2String(input)); }, exceptionMessage);
+          ExceptException<exception>([&]() { auto is = istringstream(WString2String(input)); JsonLinter::Read(is); }, exceptionMessage);
+        }
+      }
+    }
+
     TEST_METHOD(TestParseBoolean1)
     {
       auto pairs = vector<tuple<wstring, bool, string>>
@@ -516,6 +560,89 @@ namespace Json4CPP::Test
       }
     }
 
+    TEST_METHOD(TestParseNumberRange)
+    {
+      auto max = numeric_limits<double>::max();
+      auto tuples = vector<tuple<wstring, VALUE_TOKEN, JsonTokenType>>
+      {
+        { L"9223372036854775807"s                       , 9223372036854775807i64  , JsonTokenType::Integer },
+        { L"-9223372036854775808"s                      , -9223372036854775807i64 - 1, JsonTokenType::Integer },
+        // Integers outside of the range of int64_t become doubles
+        { L"9223372036854775808"s                       , 9223372036854775808.0   , JsonTokenType::Real    },
+        { L"-9223372036854775809"s                      , -9223372036854775809.0  , JsonTokenType::Real    },
+        { L"1"s + wstring(80, L'0')                     , 1e80                    , JsonTokenType::Real    },
+        { L"0."s + wstring(80, L'0') + L"1"s            , 1e-81                   , JsonTokenType::Real    },
+        { L"1."s + wstring(80, L'0') + L"1e-5"s         , 1e-5                    , JsonTokenType::Real    },
+        // Overflows to the largest double, underflows to zero
+        { L"1e400"s                                     , max                     , JsonTokenType::Real    },
+        { L"-1E+400"s                                   , -max                    , JsonTokenType::Real    },
+        { L"1e-400"s                                    , 0.0                     , JsonTokenType::Real    },
+        { L"-1e-400"s                                   , -0.0                    , JsonTokenType::Real    },
+        { L"0.00001e309"s                               , 1e304                   , JsonTokenType::Real    },
+        { L"0.0001e-320"s                               , 0.0                     , JsonTokenType::Real    },
+        { L"100000e-329"s                               , 0.0                     , JsonTokenType::Real    },
+        { L"4.9e-324"s                                  , 4.9e-324                , JsonTokenType::Real    },
+        { L"0."s + wstring(400, L'0') + L"1e800"s       , max                     , JsonTokenType::Real    },
+        { L"1"s + wstring(400, L'0') + L"e-800"s        , 0.0                     , JsonTokenType::Real    },
+        { L"1e99999999999999999999"s                    , max                     , JsonTokenType::Real    },
+        { L"-1e-99999999999999999999"s                  , -0.0                    , JsonTokenType::Real    },
+        { L"0e99999"s                                   , 0.0                     , JsonTokenType::Real    },
+      };
+
+      for (auto& [input, expected, expectedType] : tuples)
+      {
+        auto tokens1 = JsonLinter::Read(              input );
+        auto tokens2 = JsonLinter::Read(wstringstream(input));
+        auto tokens3 = JsonLinter::Read(WString2String(input));
+        for (auto& tokens : { tokens1, tokens2, tokens3 })
+        {
+          Assert::AreEqual<size_t>(1, tokens.size());
+          Assert::AreEqual<JsonTokenType>(expectedType, tokens[0].first);
+          Assert::AreEqual<VALUE_TOKEN>(expected, tokens[0].second);
+        }
+      }
+    }
+
+    TEST_METHOD(TestParseNumberRoundTrip)
+    {
+      // Pseudo random bit patterns cover every exponent, the written text has to parse back to the same double.
+      // Values which are exactly representable as float are written with float precision, so only that much is kept.
+      auto state = uint64_t(0x9E3779B97F4A7C15);
+      for (int i = 0; i < 20000; ++i)
+      {
+        state = state * 6364136223846793005ui64 + 1442695040888963407ui64;
+        auto bits = i % 2 ? state : state >> (i % 40);
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (!isfinite(value)) continue;
+        for (auto number : { value, (double)(float)value, (double)(int64_t)(state >> 11) })
+        {
+          if (!isfinite(number)) continue;
+          auto os = wstringstream();
+          auto tokens = deque<TOKEN>{ { JsonTokenType::Real, number } };
+          JsonLinter::Write(os, tokens, 0);
+          auto tokens1 = JsonLinter::Read(os.str());
+          auto tokens2 = JsonLinter::Read(WString2String(os.str()));
+          for (auto& parsedTokens : { tokens1, tokens2 })
+          {
+            auto parsed = visit(Overload{
+              [](double  const& v) { return v; },
+              [](int64_t const& v) { return (double)v; },
+              [](auto    const& v) { return numeric_limits<double>::quiet_NaN(); },
+            }, parsedTokens[0].second);
+            if ((float)number == number)
+            {
+              Assert::AreEqual((float)number, (float)parsed, os.str().c_str());
+            }
+            else
+            {
+              Assert::AreEqual(number, parsed, os.str().c_str());
+            }
+          }
+        }
+      }
+    }
+
     TEST_METHOD(TestParseObject)
     {
       auto pairs = vector<pair<wstring, vector<TOKEN>>>
@@ -658,6 +785,274 @@ namespace Json4CPP::Test
       }
     }
 
+    TEST_METHOD(TestReadUtf8)
+    {
+      auto pairs = vector<pair<string, vector<TOKEN>>>
+      {
+        { u8"\"\u03A9\""s,               { { JsonTokenType::String, L"\u03A9"s } } },        // Two bytes
+        { u8"\"\u20AC\""s,               { { JsonTokenType::String, L"\u20AC"s } } },        // Three bytes
+        { u8"\"\U0001F600\""s,           { { JsonTokenType::String, L"\xD83D\xDE00"s } } }, // Four bytes, surrogate pair
+        { u8"\"a\u03A9b\\u03A9\""s,      { { JsonTokenType::String, L"a\u03A9b\u03A9"s } } },
+        { u8"{ \"\u03A9\" : [ 1, 2.5 ] }"s, { { JsonTokenType::StartObject, L"{"s }, { JsonTokenType::PropertyName, L"\u03A9"s }, { JsonTokenType::StartArray, L"["s }, { JsonTokenType::Integer, 1i64 }, { JsonTokenType::Real, 2.5 }, { JsonTokenType::EndArray, L"]"s }, { JsonTokenType::EndObject, L"}"s } } },
+      };
+
+      for (auto& [input, expected] : pairs)
+      {
+        auto tokens = JsonLinter::Read(input);
+        Assert::AreEqual<size_t>(expected.size(), tokens.size());
+        for (int i = 0; i < expected.size(); ++i)
+        {
+          Assert::AreEqual<JsonTokenType>(expected[i].first, tokens[i].first);
+          Assert::AreEqual<VALUE_TOKEN>(expected[i].second, tokens[i].second);
+        }
+      }
+
+      // Positions are counted in UTF-16 code units, the same way as for the wide input
+      auto pairs2 = vector<tuple<string, wstring, string>>
+      {
+        { u8"[\"\u03A9\"  \r\n  ;]"s,        L"[\"\u03A9\"  \r\n  ;]"s,        "Expected ',' or ']' at position Line: 2 Column: 3!"s },
+        { u8"[\"\U0001F600\", \"\u20AC\"] 0"s, L"[\"\xD83D\xDE00\", \"\u20AC\"] 0"s, "Unexpected '0' at position Line: 1 Column: 13!"s },
+        { u8"{ \"\u03A9\" 1 }"s,              L"{ \"\u03A9\" 1 }"s,              "Expected ':' at position Line: 1 Column: 7!"s },
+      };
+
+      for (auto& [input, wideInput, exceptionMessage] : pairs2)
+      {
+        ExceptException<exception>([input = input]() { JsonLinter::Read(input); }, exceptionMessage);
+        ExceptException<exception>([input = wideInput]() { JsonLinter::Read(input); }, exceptionMessage);
+      }
+
+      auto pairs3 = vector<pair<string, string>>
+      {
+        { "\"\x80\""s,                 "Invalid UTF-8 sequence at position Line: 1 Column: 2!"s }, // Lone continuation byte
+        { "\"\xC0\xAF\""s,             "Invalid UTF-8 sequence at position Line: 1 Column: 2!"s }, // Overlong encoding
+        { "\"\xED\xA0\x80\""s,         "Invalid UTF-8 sequence at position Line: 1 Column: 2!"s }, // Encoded surrogate
+        { "\"\xF4\x90\x80\x80\""s,     "Invalid UTF-8 sequence at position Line: 1 Column: 2!"s }, // Above U+10FFFF
+        { "[\r\n  \"ab\xE2\x82\""s,     "Invalid UTF-8 sequence at position Line: 2 Column: 6!"s }, // Truncated sequence
+      };
+
+      for (auto& [input, exceptionMessage] : pairs3)
+      {
+        ExceptException<exception>([input = input]() { JsonLinter::Read(input); }, exceptionMessage);
+      }
+    }
+
+    TEST_METHOD(TestReadPosition)
+    {
+      // Streams which can not seek, the positions of the errors are tracked while reading instead
+      struct UnseekableBuffer : wstreambuf
+      {
+        UnseekableBuffer(wstring& text) { setg(text.data(), text.data(), text.data() + text.size()); }
+      };
+      struct UnseekableBufferA : streambuf
+      {
+        UnseekableBufferA(string& text) { setg(text.data(), text.data(), text.data() + text.size()); }
+      };
+
+      auto lines = L"[\r\n"s;
+      for (int i = 0; i < 9999; ++i)
+      {
+        lines += L"  1,\r\n"s;
+      }
+      auto line = L"["s;
+      for (int i = 0; i < 100000; ++i)
+      {
+        line += L"1,"s;
+      }
+
+      auto pairs = vector<pair<wstring, string>>
+      {
+        { L"[1\r\n ;]"s,                 "Expected ',' or ']' at position Line: 2 Column: 2!"s },
+        { L"[1,\r2\r\r\n ;]"s,            "Expected ',' or ']' at position Line: 2 Column: 2!"s }, // Only \r\n ends a line
+        { L"[1,\n2\n;]"s,                 "Expected ',' or ']' at position Line: 1 Column: 7!"s },
+        { L"[1,\r\n2"s,                   "Expected ',' or ']' at position Line: 2 Column: 2!"s }, // One column after the end
+        { L"\r\n\r\n  nul"s,              "Expected 'null' at position Line: 3 Column: 3!"s },
+        { L"[\r\n  \"a\tb\"]"s,            "Invalid character found at position Line: 2 Column: 5!"s },
+        { L"[\"abc\\n\" \"def\"]"s,         "Expected ',' or ']' at position Line: 1 Column: 10!"s },
+        { L"[\""s + wstring(1000, L'a') + L"\x1\"]"s, "Invalid character found at position Line: 1 Column: 1003!"s },
+        { lines + L"  1\r\n  2\r\n]"s,      "Expected ',' or ']' at position Line: 10002 Column: 3!"s },
+        { line + L"1 2]"s,                 "Expected ',' or ']' at position Line: 1 Column: 200004!"s },
+      };
+
+      for (auto& [input, exceptionMessage] : pairs)
+      {
+        auto narrow = string(input.begin(), input.end());
+        ExceptException<exception>([&]() { JsonLinter::Read(wstring_view(input)); }, exceptionMessage);
+        ExceptException<exception>([&]() { JsonLinter::Read(string_view(narrow)); }, exceptionMessage);
+        ExceptException<exception>([&]() { auto is = wistringstream(input); JsonLinter::Read(is); }, exceptionMessage);
+        ExceptException<exception>([&]() { auto is = istringstream(narrow); JsonLinter::Read(is); }, exceptionMessage);
+        ExceptException<exception>([&]() { auto text = input;  auto buffer = UnseekableBuffer (text); auto is = wistream(&buffer); JsonLinter::Read(is); }, exceptionMessage);
+        ExceptException<exception>([&]() { auto text = narrow; auto buffer = UnseekableBufferA(text); auto is = istream (&buffer); JsonLinter::Read(is); }, exceptionMessage);
+      }
+    }
+
+    TEST_METHOD(TestParseIndexed)
+    {
+      // {"a":[1,"b\"]"],"c":null}, the escaped quote and the bracket after it are inside of the string
+      auto positions = vector<uint32_t>();
+      Assert::IsTrue(JsonStructuralIndex::Build("{\"a\":[1,\"b\\\"]\"],\"c\":null}"sv, positions));
+      Assert::IsTrue(vector<uint32_t>{ 0, 1, 4, 5, 6, 7, 8, 14, 15, 16, 19, 20, 24 } == positions);
+      Assert::IsTrue(JsonStructuralIndex::Build(L"{\"a\":[1,\"b\\\"]\"],\"c\":null}"sv, positions));
+      Assert::IsTrue(vector<uint32_t>{ 0, 1, 4, 5, 6, 7, 8, 14, 15, 16, 19, 20, 24 } == positions);
+      // Non-ASCII characters are only indexed inside of the strings
+      Assert::IsTrue (JsonStructuralIndex::Build(u8"[\"\u00A0\"]"sv, positions));
+      Assert::IsFalse(JsonStructuralIndex::Build(u8"[\u00A01]"sv, positions));
+      Assert::IsFalse(JsonStructuralIndex::Build(L"[\u00A01]"sv, positions));
+
+      // Both backends have to produce the same tokens and the same errors, from UTF-16 and from UTF-8
+      auto read = [](JsonBackend backend, auto const& input)
+      {
+        auto backup = JsonDefault::Backend;
+        JsonDefault::Backend = backend;
+        auto result = pair<deque<TOKEN>, string>();
+        try
+        {
+          result.first = JsonLinter::Read(input);
+        }
+        catch (exception const& e)
+        {
+          result.second = e.what();
+        }
+        JsonDefault::Backend = backup;
+        return result;
+      };
+      auto compare = [&](wstring const& input)
+      {
+        auto utf8 = WString2String(input);
+        auto pairs = vector<pair<pair<deque<TOKEN>, string>, pair<deque<TOKEN>, string>>>
+        {
+          { read(JsonBackend::Linter, wstring_view(input)), read(JsonBackend::StructuralIndex, wstring_view(input)) },
+          { read(JsonBackend::Linter, string_view (utf8 )), read(JsonBackend::StructuralIndex, string_view (utf8 )) },
+        };
+        for (auto& [expected, actual] : pairs)
+        {
+          Assert::AreEqual(expected.second, actual.second);
+          Assert::AreEqual<size_t>(expected.first.size(), actual.first.size());
+          for (int i = 0; i < expected.first.size(); ++i)
+          {
+            Assert::AreEqual<JsonTokenType>(expected.first[i].first, actual.first[i].first);
+            Assert::AreEqual<VALUE_TOKEN>(expected.first[i].second, actual.first[i].second);
+          }
+        }
+      };
+
+      for (auto& file : CorpusFiles(true))
+      {
+        compare(ReadAllText(file));
+      }
+
+      auto inputs = vector<wstring>
+      {
+        L""s, L"  \r\n "s, L"["s, L"{"s, L"[1,"s, L"{\"a\""s, L"{\"a\":"s, L"{\"a\":1"s, L"\"abc"s, L"[\"abc"s,
+        L"[1 2]"s, L"[12x]"s, L"[1-2]"s, L"[truex]"s, L"[tru]"s, L"[nul"s, L"[-]"s, L"[01]"s, L"[1.]"s, L"[1e+]"s, L"[0x1]"s,
+        L"[\"a\"b]"s, L"[\"a\" \"b\"]"s, L"[1\"b\"]"s, L"{\"a\" 1}"s, L"{\"a\":1 \"b\":2}"s, L"{1:2}"s, L"{,}"s, L"[,]"s, L"[1,]"s,
+        L"{\"a\":1,}"s, L"[]]"s, L"{}}"s, L"[] x"s, L"[]\r\n\r\n  2"s, L"[:]"s, L"{\"a\"::1}"s, L"[\\\"]"s, L"[\\]"s,
+        L"[\"\\\\\"]"s, L"[\"\\\\\\\"\"]"s, L"[\"a\tb\"]"s, L"[\"\\u12G4\"]"s, L"[\"\\x\"]"s, L"[\"\u00E9\", \u00E9]"s,
+        L"[\u00A0 1]"s, L"[\"\u00E9\u03A9\", { \"\u20AC\": [ \"\u03A9\" ] }]"s, L"\v[\f1\v]\f"s, L"1337"s, L"\"a\""s, L"null 0"s,
+        wstring(19, L'[') + wstring(19, L']'), wstring(20, L'[') + wstring(20, L']'), wstring(25, L'{'),
+      };
+      // Strings, escapes, numbers and literals which cross the boundaries of the blocks of 64 characters
+      for (int i = 56; i < 72; ++i)
+      {
+        auto padding = wstring(i, L' ');
+        inputs.push_back(L"["s + padding + L"\"\\\\\\\"]\", 1234567, true, null]"s);
+        inputs.push_back(L"[\""s + wstring(i, L'\\') + L"\", \"x\" ]"s);
+        inputs.push_back(L"{\""s + wstring(i, L'a') + L"\":"s + padding + L"-12.5e3 , \"b\" : [ false ] }"s);
+        inputs.push_back(L"[\""s + wstring(i, L'a') + L"\\u00e9\\\"\", 1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33] x"s);
+      }
+      for (auto& input : inputs)
+      {
+        compare(input);
+      }
+    }
+
+    TEST_METHOD(TestReadParallel)
+    {
+      // The elements of the parts in order have to be the same as the ones parsed at once, and the errors have to be the same too
+      auto read = [](auto const& input, size_t count)
+      {
+        auto parts = vector<Json>(count);
+        auto handlers = vector<JsonDomHandler>();
+        auto pointers = vector<JsonHandler*>();
+        handlers.reserve(count);
+        for (auto& part : parts)
+        {
+          pointers.push_back(&handlers.emplace_back(part));
+        }
+        auto result = pair<Json, string>();
+        try
+        {
+          Assert::IsTrue(JsonLinter::ReadParallel(input, pointers));
+          result.first = JsonArray();
+          for (auto& part : parts)
+          {
+            for (auto& value : part.Get<JsonArray>())
+            {
+              result.first.PushBack(value);
+            }
+          }
+        }
+        catch (exception const& e)
+        {
+          result.second = e.what();
+        }
+        return result;
+      };
+      auto compare = [&](wstring const& input)
+      {
+        auto expected = pair<Json, string>();
+        try
+        {
+          expected.first = Json::Parse(input);
+        }
+        catch (exception const& e)
+        {
+          expected.second = e.what();
+        }
+        auto utf8 = WString2String(input);
+        for (size_t count = 1; count <= 8; ++count)
+        {
+          for (auto& actual : { read(wstring_view(input), count), read(string_view(utf8), count) })
+          {
+            Assert::AreEqual(expected.second, actual.second);
+            Assert::AreEqual(expected.first, actual.first);
+          }
+        }
+      };
+
+      auto inputs = vector<wstring>
+      {
+        L"[]"s, L"[1]"s, L"[1, 2]"s, L"[[1, 2], [3, [4, 5]], { \"a\": [6, 7] }, 8]"s, L"[1, 2, 3, 4, 5, 6, 7, 8, 9, 10] "s,
+        L"[1, 2, 3, 4, 5, 6, 7, 8, 9, 10"s, L"[1, 2, 3, 4, 5 6, 7, 8, 9, 10]"s, L"[1, 2, 3, 4, 5, 6, 7, 8, 9, 10]]"s,
+        L"[1, 2, 3, 4, 5, 6, 7, 8, 9, 10] x"s, L"[1, 2, 3, 4,, 5, 6, 7, 8, 9, 10]"s, L"[1, 2, 3, 4, 5, 6, 7, 8, 9,]"s,
+        L"[1, 2, 3, {\"a\": 4, 5, 6, 7, 8, 9, 10]"s, L"[1, 2, 3, [4, 5}, 6, 7, 8, 9, 10]"s, L"[1, 2, 3, 4], 5, 6, 7, 8, 9, 10]"s,
+        L"[1, 2, 3, 4, 5, 6, 7, 8, 9, 10, x]"s, L"[\"a, b\", \"c, d\", \"e, f\", \"g, h\"]"s,
+        wstring(19, L'[') + L"1, 2, 3" + wstring(19, L']'), L"[1, 2, 3, 4, 5, 6, 7, "s + wstring(20, L'[') + wstring(20, L']') + L"]"s,
+      };
+      // The root objects among them are skipped below
+      for (auto& file : CorpusFiles(true))
+      {
+        inputs.push_back(ReadAllText(file));
+      }
+      for (auto& input : inputs)
+      {
+        // Only the root arrays are split
+        if (auto first = input.find_first_not_of(L" \t\r\n"s); first != wstring::npos && input[first] == L'[')
+        {
+          compare(input);
+        }
+      }
+
+      // Anything but a root array is left to the other backends
+      auto json = Json();
+      auto handler = JsonDomHandler(json);
+      auto handlers = vector<JsonHandler*>{ &handler, &handler };
+      Assert::IsFalse(JsonLinter::ReadParallel(L"{ \"a\": [1, 2] }"sv, handlers));
+      Assert::IsFalse(JsonLinter::ReadParallel(L" 1"sv, handlers));
+      Assert::IsFalse(JsonLinter::ReadParallel(L""sv, handlers));
+      Assert::IsFalse(JsonLinter::ReadParallel(L"[\u00A0 1, 2]"sv, handlers));
+      Assert::AreEqual(Json(), json);
+    }
+
     TEST_METHOD(TestWriteNumber)
     {
       auto pairs = vector<pair<deque<TOKEN>, wstring>>
@@ -728,6 +1123,12 @@ namespace Json4CPP::Test
         { { { JsonTokenType::Real, 1000000000000000000000000000000000000000000000000.0   } }, L"1e+48"s               },
         { { { JsonTokenType::Real, 10000000000000000000000000000000000000000000000000.0  } }, L"1e+49"s               },
         { { { JsonTokenType::Real, 100000000000000000000000000000000000000000000000000.0 } }, L"1e+50"s               },
+        // The longest texts
+        { { { JsonTokenType::Integer, -9223372036854775807i64 - 1 } }, L"-9223372036854775808"s },
+        { { { JsonTokenType::Real, -2.2250738585072014e-308 } }, L"-2.2250738585072014e-308"s },
+        { { { JsonTokenType::Real, -1.7976931348623157e+308 } }, L"-1.7976931348623157e+308"s },
+        { { { JsonTokenType::Real, -1.1754943508222875e-38 } }, L"-1.1754944e-38"s },
+        { { { JsonTokenType::Real, 4.9406564584124654e-324 } }, L"5e-324"s },
       };
 
       for (auto [input, expected] : pairs)
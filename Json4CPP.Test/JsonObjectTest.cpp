@@ -153,6 +153,23 @@ namespace Json4CPP::Test
       Assert::AreEqual<Json>(2, object2[L"Key2"]);
     }
 
+    TEST_METHOD(TestConstructorMemoryResource)
+    {
+      auto resource = CountingResource();
+      auto object = JsonObject(&resource);
+      object.Insert({ L"Key1"s, 1 });
+      object[L"Key2"s] = L"2"s;
+      Assert::IsTrue(resource.allocations > 0);
+
+      // Copies are allocated from the default resource
+      auto allocations = resource.allocations;
+      auto copy = object;
+      copy.Insert({ L"Key3"s, 3 });
+      Assert::AreEqual(allocations, resource.allocations);
+      Assert::AreEqual(JsonObject{ { L"Key1"s, 1 }, { L"Key2"s, L"2"s }, { L"Key3"s, 3 } }, copy);
+      Assert::AreEqual(JsonObject{ { L"Key1"s, 1 }, { L"Key2"s, L"2"s } }, object);
+    }
+
     TEST_METHOD(TestDump)
     {
       JsonObject object = {
@@ -251,6 +268,79 @@ namespace Json4CPP::Test
       Assert::AreEqual(6i64, JsonObject{ { L"Null", nullptr }, { L"String", L"Test" }, { L"Boolean", true }, { L"Number", 1337 }, { L"Object", {{ L"Key1", 1 }, { L"Key2", 2 } } }, { L"Array", { 1, 2, 3 } } }.Size());
     }
 
+    TEST_METHOD(TestHash)
+    {
+      auto object = JsonObject{ { L"Number", 1 }, { L"Object", { { L"Key1", 1.0 } } }, { L"Array", { true, nullptr } } };
+      // Equal objects hash the same, even if their numbers are of different types
+      auto same = JsonObject{ { L"Number", 1.0 }, { L"Object", { { L"Key1", true } } }, { L"Array", { 1, nullptr } } };
+      Assert::IsTrue(object == same);
+      Assert::AreEqual(object.Hash(), same.Hash());
+      Assert::IsTrue(hash<JsonObject>()(object) == (size_t)object.Hash());
+      Assert::AreEqual(JsonObject().Hash(), JsonObject{}.Hash());
+      Assert::AreNotEqual(JsonObject().Hash(), JsonArray().Hash());
+      Assert::AreNotEqual(JsonObject{ { L"Key1", 1 }, { L"Key2", 2 } }.Hash(), JsonObject{ { L"Key2", 2 }, { L"Key1", 1 } }.Hash());
+      Assert::AreNotEqual(JsonObject{ { L"Key1", 1 } }.Hash(), JsonObject{ { L"Key1", 2 } }.Hash());
+      Assert::AreNotEqual(JsonObject{ { L"Key1", 1 } }.Hash(), JsonObject{ { L"Key2", 1 } }.Hash());
+
+      // Every non-const access drops the cached hash, also when a nested value is changed
+      auto hash = object.Hash();
+      object[L"Number"] = 2;
+      Assert::AreNotEqual(hash, object.Hash());
+      object.At(L"Number") = 1;
+      Assert::AreEqual(hash, object.Hash());
+      object[L"Object"][L"Key1"] = 2;
+      Assert::AreNotEqual(hash, object.Hash());
+      *object.Find(L"Object") = { { L"Key1", 1 } };
+      Assert::AreEqual(hash, object.Hash());
+      object.At(L"Array").PushBack(3);
+      Assert::AreNotEqual(hash, object.Hash());
+      object.At(L"Array").Erase(2);
+      Assert::AreEqual(hash, object.Hash());
+      for (auto& [key, value] : object)
+      {
+        value = key;
+      }
+      Assert::AreEqual(JsonObject{ { L"Number", L"Number" }, { L"Object", L"Object" }, { L"Array", L"Array" } }.Hash(), object.Hash());
+      object.Insert({ L"Key1", 1 });
+      Assert::AreEqual(JsonObject{ { L"Number", L"Number" }, { L"Object", L"Object" }, { L"Array", L"Array" }, { L"Key1", 1 } }.Hash(), object.Hash());
+      object.Erase(L"Key1");
+      object.EraseIf([](auto const& pair) { return pair.first == L"Array"; });
+      Assert::AreEqual(JsonObject{ { L"Number", L"Number" }, { L"Object", L"Object" } }.Hash(), object.Hash());
+      object.Clear();
+      Assert::AreEqual(JsonObject().Hash(), object.Hash());
+
+      // Copies keep the cached hash, moved from objects drop it
+      same.Hash();
+      auto copy = same;
+      Assert::AreEqual(same.Hash(), copy.Hash());
+      auto moved = move(copy);
+      Assert::AreEqual(same.Hash(), moved.Hash());
+      copy = JsonObject();
+      Assert::AreEqual(JsonObject().Hash(), copy.Hash());
+
+      // Values changed through references obtained before the hash is computed are noticed as well
+      auto equal = JsonObject{ { L"Key1", 5 }, { L"Key2", { 5, 2 } } };
+      equal.Hash();
+      auto changed = JsonObject{ { L"Key1", 1 }, { L"Key2", { 1, 2 } } };
+      auto& value = changed[L"Key1"];
+      changed.Hash();
+      value = 5;
+      auto& element = changed[L"Key2"][0];
+      changed.Hash();
+      element = 5;
+      Assert::IsTrue(changed == equal);
+      Assert::AreEqual(equal.Hash(), changed.Hash());
+      // Also after the object is moved, as the references refer to the values of the new object
+      auto original = JsonObject{ { L"Key1", 1 }, { L"Key2", { 1, 2 } } };
+      auto& first = original[L"Key1"];
+      auto target = move(original);
+      target.Hash();
+      first = 5;
+      target[L"Key2"][0] = 5;
+      Assert::IsTrue(target == equal);
+      Assert::AreEqual(equal.Hash(), target.Hash());
+    }
+
     TEST_METHOD(TestClear)
     {
       auto object = JsonObject{ { L"Key1", 1 }, { L"Key2", 2 } };
@@ -276,6 +366,37 @@ namespace Json4CPP::Test
       Assert::AreEqual<Json>({ 1, 2, 3 }, object[L"Array"]);
     }
 
+    TEST_METHOD(TestEmplace)
+    {
+      JsonObject object;
+      Assert::IsTrue(object.Emplace(L"Null"));
+      Assert::IsTrue(object.Emplace(L"String", L"Test"s));
+      Assert::IsTrue(object.Emplace(L"Number", 1337));
+      Assert::IsTrue(object.Emplace(L"Array", JsonArray{ 1, 2, 3 }));
+      Assert::IsFalse(object.Emplace(L"Number", 1));
+      Assert::AreEqual(JsonObject{ { L"Null", nullptr }, { L"String", L"Test" }, { L"Number", 1337 }, { L"Array", { 1, 2, 3 } } }, object);
+
+      // Nested containers are moved into the object instead of copied, if they use the same memory resource
+      auto resource = CountingResource();
+      auto target = JsonObject(&resource);
+      auto nested = JsonObject(&resource);
+      nested[L"Key1"] = 1;
+      auto address = &as_const(nested).At(L"Key1");
+      Assert::IsTrue(target.Emplace(L"Object", move(nested)));
+      Assert::IsTrue(target.Insert({ L"Moved", move(target[L"Object"]) }));
+      Assert::IsTrue(address == &as_const(target).At(L"Moved").Get<JsonObject>().At(L"Key1"));
+
+      // Otherwise they are copied into the resource of the object
+      nested = JsonObject(&resource);
+      nested[L"Key1"] = 1;
+      auto allocations = resource.allocations;
+      Assert::IsTrue(object.Emplace(L"Object", move(nested)));
+      Assert::IsTrue(object.Insert({ L"Moved", move(object[L"Object"]) }));
+      object[L"Moved"][L"Key2"] = 2;
+      Assert::AreEqual(allocations, resource.allocations);
+      Assert::AreEqual<Json>({ { L"Key1", 1 }, { L"Key2", 2 } }, object[L"Moved"]);
+    }
+
     TEST_METHOD(TestErase)
     {
       JsonObject object = {
@@ -298,6 +419,71 @@ namespace Json4CPP::Test
       Assert::AreEqual<Json>({ 1, 2, 3 }, object[L"Array"]);
     }
 
+    TEST_METHOD(TestEraseLarge)
+    {
+      // Erases in a pseudo random order and checks every remaining key after each step, against the expected order
+      auto object = JsonObject();
+      auto expected = vector<wstring>();
+      for (int i = 0; i < 300; ++i)
+      {
+        expected.push_back(L"Key"s + to_wstring(i));
+        object[expected.back()] = i;
+      }
+      auto state = 12345u;
+      while (!expected.empty())
+      {
+        state = state * 1103515245u + 12345u;
+        auto index = (state >> 8) % expected.size();
+        object.Erase(expected[index]);
+        object.Erase(expected[index]);
+        expected.erase(expected.begin() + index);
+
+        Assert::AreEqual<int64_t>(expected.size(), object.Size());
+        Assert::IsTrue(expected == object.Keys());
+        for (auto& key : expected)
+        {
+          Assert::AreEqual<Json>(stoi(key.substr(3)), object.At(key));
+        }
+        if (expected.size() % 50 == 0)
+        {
+          // Grows again after erasing
+          object[L"New"s] = 0;
+          Assert::AreEqual<Json>(0, object.At(L"New"s));
+          object.Erase(L"New"s);
+        }
+      }
+    }
+
+    TEST_METHOD(TestEraseIf)
+    {
+      auto object = JsonObject();
+      for (int i = 0; i < 100; ++i)
+      {
+        object[L"Key"s + to_wstring(i)] = i;
+      }
+      Assert::AreEqual<int64_t>(0, object.EraseIf([](pair<KEY, Json> const& pair) { return pair.second.Is(JsonType::String); }));
+      Assert::AreEqual<int64_t>(100, object.Size());
+      Assert::AreEqual<int64_t>(95, object.EraseIf([](pair<KEY, Json> const& pair) { return pair.second.Get<int64_t>() % 20 != 0; }));
+      Assert::AreEqual(JsonObject{ { L"Key0", 0 }, { L"Key20", 20 }, { L"Key40", 40 }, { L"Key60", 60 }, { L"Key80", 80 } }, object);
+      Assert::AreEqual<Json>(40, object.At(L"Key40"s));
+      Assert::ExpectException<out_of_range>([&]() { object.At(L"Key41"s); });
+      for (int i = 0; i < 100; ++i)
+      {
+        object[L"Key"s + to_wstring(i)] = i;
+      }
+      Assert::AreEqual<int64_t>(100, object.Size());
+      Assert::AreEqual(L"Key20"s, object.Keys()[1]);
+      Assert::AreEqual<Json>(99, object.At(L"Key99"s));
+      Assert::AreEqual<int64_t>(100, object.EraseIf([](pair<KEY, Json> const&) { return true; }));
+      Assert::AreEqual(JsonObject(), object);
+
+      // Erasing nothing leaves the pairs shared with the copies
+      auto original = JsonObject{ { L"Key1", 1 }, { L"Key2", 2 } };
+      auto copy = original;
+      Assert::AreEqual<int64_t>(0, copy.EraseIf([](pair<KEY, Json> const& pair) { return pair.first == L"Key3"; }));
+      Assert::IsTrue(&as_const(original).At(L"Key1"s) == &as_const(copy).At(L"Key1"s));
+    }
+
     TEST_METHOD(TestKeys)
     {
       JsonObject object = {
@@ -375,17 +561,19 @@ namespace Json4CPP::Test
       Assert::AreEqual<Json>(1337, object.At(L"Number"));
       Assert::AreEqual<Json>({ { L"Key1", 1 }, { L"Key2", 2 } }, object.At(L"Object"));
       Assert::AreEqual<Json>({ 1, 2, 3 }, object.At(L"Array"));
-      Assert::AreEqual<Json>(1, object.At(L"Object")[L"Key1"]);
-      Assert::AreEqual<Json>(2, object.At(L"Object")[L"Key2"]);
-      Assert::AreEqual<Json>(1, object.At(L"Array")[0]);
-      Assert::AreEqual<Json>(2, object.At(L"Array")[1]);
-      Assert::AreEqual<Json>(3, object.At(L"Array")[2]);
+      Assert::AreEqual<Json>(1, object.At(L"Object").At(L"Key1"));
+      Assert::AreEqual<Json>(2, object.At(L"Object").At(L"Key2"));
+      Assert::AreEqual<Json>(1, object.At(L"Array").At(0));
+      Assert::AreEqual<Json>(2, object.At(L"Array").At(1));
+      Assert::AreEqual<Json>(3, object.At(L"Array").At(2));
+      ExceptException<out_of_range>([&]() { object.At(L"Missing"); }, "Key not found: Missing!");
 
+      // The values are returned by reference, without copying them
+      static_assert(is_same_v<decltype(object.At(L"Null")), Json const&>);
       for (auto key : object.Keys())
       {
-        object.At(key) = 9999;
-        Assert::AreNotEqual<Json>(9999, object.At(key));
         Assert::AreEqual<Json>(map[key], object.At(key));
+        Assert::IsTrue(&object.At(key) == &object.At(key));
       }
     }
 
@@ -422,6 +610,90 @@ namespace Json4CPP::Test
       }
     }
 
+    TEST_METHOD(TestFind)
+    {
+      auto object = JsonObject{
+        { L"Null", nullptr },
+        { L"Number", 1337 },
+        { L"Object", { { L"Key1", 1 } } },
+      };
+      auto const& constObject = object;
+      Assert::IsTrue(object.Find(L"Null") == &object.At(L"Null"));
+      Assert::IsTrue(object.Find(L"Number") == &object.At(L"Number"));
+      Assert::IsTrue(constObject.Find(L"Object") == &constObject.At(L"Object"));
+      Assert::IsNull(object.Find(L"Missing"));
+      Assert::IsNull(constObject.Find(L"Missing"));
+      Assert::IsNull(object.Find(L"Key1"));
+
+      *object.Find(L"Number") = 9999;
+      Assert::AreEqual<Json>(9999, object.At(L"Number"));
+
+      // Above the linear search limit, where the keys are looked up by their hash
+      auto large = JsonObject();
+      for (int i = 0; i < 100; ++i)
+      {
+        large.Insert({ L"Key" + to_wstring(i), i });
+      }
+      for (int i = 0; i < 100; ++i)
+      {
+        Assert::AreEqual<Json>(i, *large.Find(L"Key" + to_wstring(i)));
+      }
+      Assert::IsNull(large.Find(L"Key100"));
+    }
+
+    TEST_METHOD(TestLargeObject)
+    {
+      // Small objects are searched linearly, larger ones through the index, it has to work the same way on both sides of the limit
+      auto object = JsonObject();
+      auto const& constObject = object;
+      for (int i = 0; i < 1000; ++i)
+      {
+        auto key = L"Key"s + to_wstring(i);
+        Assert::IsTrue(object.Insert({ key, i }));
+        Assert::IsFalse(object.Insert({ key, -1 }));
+        Assert::AreEqual<int64_t>(i + 1, object.Size());
+        for (int j = 0; j <= i; j += 1 + i / 16)
+        {
+          Assert::AreEqual<Json>(j, constObject.At(L"Key"s + to_wstring(j)));
+        }
+        Assert::ExpectException<out_of_range>([&]() { constObject.At(L"Key"s + to_wstring(i + 1)); });
+      }
+      object[L"Key1000"s] = 1000;
+      Assert::AreEqual<int64_t>(1001, object.Size());
+      Assert::AreEqual<Json>(1000, object[L"Key1000"s]);
+
+      // Erasing keeps the order of the remaining pairs
+      for (int i = 0; i <= 1000; i += 2)
+      {
+        object.Erase(L"Key"s + to_wstring(i));
+      }
+      auto keys = object.Keys();
+      Assert::AreEqual<size_t>(500, keys.size());
+      for (int i = 0; i < 500; ++i)
+      {
+        Assert::AreEqual(L"Key"s + to_wstring(2 * i + 1), keys[i]);
+        Assert::AreEqual<Json>(2 * i + 1, object.At(keys[i]));
+      }
+      while (object.Size() > 3)
+      {
+        object.Erase(object.Keys().front());
+      }
+      Assert::AreEqual(JsonObject{ { L"Key995", 995 }, { L"Key997", 997 }, { L"Key999", 999 } }, object);
+      Assert::ExpectException<out_of_range>([&]() { object.At(L"Key1"s); });
+
+      // Copies have their own index
+      auto copy = JsonObject();
+      for (int i = 0; i < 100; ++i)
+      {
+        copy[L"Key"s + to_wstring(i)] = i;
+      }
+      object = copy;
+      copy.Erase(L"Key50"s);
+      Assert::AreEqual<Json>(50, object.At(L"Key50"s));
+      Assert::AreEqual<int64_t>(100, object.Size());
+      Assert::AreEqual<int64_t>(99, copy.Size());
+    }
+
     TEST_METHOD(TestIterator)
     {
       auto object = JsonObject{
@@ -878,5 +1150,140 @@ namespace Json4CPP::Test
       Assert::IsFalse(JsonObject{ { L"Key", JsonArray{ 1, 2 } } } != JsonObject{ { L"Key", JsonArray{ 1, 2 } } });
       Assert::IsTrue (JsonObject{ { L"Key", JsonArray{ 1, 2 } } } != JsonObject{ { L"Key", JsonArray{ 1, 2, 3 } } });
     }
+
+    TEST_METHOD(TestOperatorEqualHash)
+    {
+      // Unequal objects with cached hashes are told apart without comparing the pairs, equal ones are still compared
+      auto left = JsonObject{ { L"Key1", { 1, 2, 3 } }, { L"Key2", { { L"Key3", L"Value" } } } };
+      auto right = left;
+      left.Hash();
+      right.Hash();
+      Assert::IsTrue(left == right);
+      Assert::IsFalse(left != right);
+      right[L"Key2"][L"Key3"] = L"Other";
+      Assert::IsFalse(left == right);
+      right.Hash();
+      Assert::IsFalse(left == right);
+      Assert::IsTrue(left != right);
+      right[L"Key2"][L"Key3"] = L"Value";
+      right.Hash();
+      Assert::IsTrue(left == right);
+    }
+
+    TEST_METHOD(TestCopyOnWrite)
+    {
+      // Copies share the pairs until one of them is modified, which copies them then
+      auto original = JsonObject{ { L"Key1", 1 }, { L"Key2", L"Value" } };
+      auto const& constOriginal = original;
+      auto copy = original;
+      auto const& constCopy = copy;
+      Assert::IsTrue(&constOriginal.At(L"Key1") == &constCopy.At(L"Key1"));
+      Assert::IsTrue(original == copy);
+      copy[L"Key1"] = 2;
+      Assert::IsTrue(&constOriginal.At(L"Key1") != &constCopy.At(L"Key1"));
+      Assert::AreEqual<Json>(1, constOriginal.At(L"Key1"));
+      Assert::AreEqual<Json>(2, constCopy.At(L"Key1"));
+
+      copy = original;
+      Assert::IsTrue(copy.Insert({ L"Key3", 3 }));
+      Assert::AreEqual(2i64, original.Size());
+      Assert::AreEqual(3i64, copy.Size());
+      copy = original;
+      copy.Erase(L"Key1");
+      Assert::AreEqual(2i64, original.Size());
+      Assert::AreEqual(1i64, copy.Size());
+      copy = original;
+      Assert::AreEqual(1i64, copy.EraseIf([](auto& pair) { return pair.first == L"Key2"; }));
+      Assert::AreEqual(2i64, original.Size());
+      copy = original;
+      copy.Clear();
+      Assert::AreEqual(2i64, original.Size());
+      Assert::AreEqual(0i64, copy.Size());
+      copy = original;
+      for (auto& [key, value] : copy)
+      {
+        value = nullptr;
+      }
+      Assert::AreEqual<Json>(1, constOriginal.At(L"Key1"));
+      // Lookups which do not find the key leave the pairs shared
+      copy = original;
+      Assert::IsNull(copy.Find(L"Key3"));
+      Assert::IsTrue(&constOriginal.At(L"Key1") == &constCopy.At(L"Key1"));
+
+      // The index of larger objects is copied along with the pairs
+      for (int i = 0; i < 100; ++i)
+      {
+        original.Insert({ L"Key" + to_wstring(i + 3), i });
+      }
+      copy = original;
+      copy.Erase(L"Key50");
+      copy.Insert({ L"Key200", 200 });
+      for (int i = 0; i < 100; ++i)
+      {
+        Assert::AreEqual<Json>(i, constOriginal.At(L"Key" + to_wstring(i + 3)));
+      }
+      Assert::IsNull(constOriginal.Find(L"Key200"));
+      Assert::IsNull(constCopy.Find(L"Key50"));
+      Assert::AreEqual<Json>(200, constCopy.At(L"Key200"));
+
+      // Objects allocated from other resources are copied right away
+      auto resource = pmr::monotonic_buffer_resource();
+      auto arena = JsonObject(&resource);
+      arena.Insert({ L"Key1", 1 });
+      auto const& constArena = arena;
+      auto fromArena = arena;
+      Assert::IsTrue(&constArena.At(L"Key1") != &as_const(fromArena).At(L"Key1"));
+      auto toArena = JsonObject(&resource);
+      toArena = arena;
+      Assert::IsTrue(&constArena.At(L"Key1") == &as_const(toArena).At(L"Key1"));
+    }
+
+    TEST_METHOD(TestCopyAfterReference)
+    {
+      // Once references or iterators to the pairs are handed out, the copies made after that do not share the pairs,
+      // so writing through those does not change the copies
+      auto object = JsonObject{ { L"Key1", 1 }, { L"Key2", JsonObject{ { L"Key3", 3 } } } };
+      auto const& constObject = object;
+      auto& value = object[L"Key1"];
+      auto copy = object;
+      auto const& constCopy = copy;
+      value = 2;
+      Assert::AreEqual<Json>(1, constCopy.At(L"Key1"));
+      Assert::AreEqual<Json>(2, constObject.At(L"Key1"));
+      copy = object;
+      object.At(L"Key1") = 3;
+      *object.Find(L"Key1") = 4;
+      Assert::AreEqual<Json>(2, constCopy.At(L"Key1"));
+      auto iterator = object.begin();
+      copy = object;
+      iterator->second = 5;
+      Assert::AreEqual<Json>(4, constCopy.At(L"Key1"));
+      Assert::AreEqual<Json>(5, constObject.At(L"Key1"));
+
+      // The same for references to nested values, the objects on the way are not shared either
+      auto& nested = object[L"Key2"][L"Key3"];
+      copy = object;
+      nested = 6;
+      Assert::AreEqual<Json>(3, constCopy.At(L"Key2").At(L"Key3"));
+      Assert::AreEqual<Json>(6, constObject.At(L"Key2").At(L"Key3"));
+
+      // The copies of the copies share their pairs again
+      auto other = copy;
+      Assert::IsTrue(&constCopy.At(L"Key1") == &as_const(other).At(L"Key1"));
+
+      // Modifying the object invalidates the references handed out before, so it shares its pairs again after that
+      object.Insert({ L"Key4", 7 });
+      auto shared = object;
+      Assert::IsTrue(&constObject.At(L"Key1") == &as_const(shared).At(L"Key1"));
+      object.Erase(L"Key4");
+      Assert::IsTrue(&constObject.At(L"Key1") != &as_const(shared).At(L"Key1"));
+      Assert::AreEqual<Json>(7, as_const(shared).At(L"Key4"));
+      // So does an assignment
+      auto& reference = shared[L"Key1"];
+      reference = 8;
+      shared = JsonObject{ { L"Key1", 9 } };
+      auto assigned = shared;
+      Assert::IsTrue(&as_const(shared).At(L"Key1") == &as_const(assigned).At(L"Key1"));
+    }
   };
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "stdafx.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Test
+{
+  TEST_CLASS(JsonObjectViewTest)
+  {
+  public:
+    TEST_METHOD(TestConstructor)
+    {
+      auto object = JsonObject{ { L"Key1", 1 }, { L"Key2", { 1, 2, 3 } } };
+      auto view = JsonObjectView(object);
+      Assert::IsTrue(&view.Object() == &object);
+      Assert::AreEqual(2i64, view.Size());
+      Assert::AreEqual(object.Dump(), view.Dump());
+      Assert::AreEqual(object.Dump(2), view.Dump(2));
+
+      // Changes of the object are seen through the view
+      object.Insert({ L"Key3", 3 });
+      Assert::AreEqual(3i64, view.Size());
+    }
+
+    TEST_METHOD(TestKeys)
+    {
+      auto object = JsonObject{ { L"Key1", 1 }, { L"Key2", 2 }, { L"Key3", 3 } };
+      auto view = JsonObjectView(object);
+      Assert::IsTrue(object.Keys() == view.Keys());
+    }
+
+    TEST_METHOD(TestAt)
+    {
+      auto object = JsonObject{ { L"Key1", 1 }, { L"Key2", { { L"Key3", { 1, 2, 3 } } } } };
+      auto view = JsonObjectView(object);
+      Assert::AreEqual<Json>(1, view.At(L"Key1"));
+      Assert::AreEqual<Json>(1, view[L"Key1"]);
+      Assert::AreEqual<Json>(3, view.At(L"Key2").At(L"Key3").At(2));
+      Assert::IsTrue(&view.At(L"Key1") == &object.At(L"Key1"));
+      Assert::IsTrue(&view[L"Key2"] == &object.At(L"Key2"));
+      ExceptException<out_of_range>([&]() { view.At(L"Missing"); }, "Key not found: Missing!");
+      ExceptException<out_of_range>([&]() { view[L"Missing"]; }, "Key not found: Missing!");
+      Assert::AreEqual(2i64, view.Size());
+    }
+
+    TEST_METHOD(TestFind)
+    {
+      auto object = JsonObject{ { L"Key1", 1 }, { L"Key2", 2 } };
+      auto view = JsonObjectView(object);
+      Assert::IsTrue(view.Find(L"Key1") == &object.At(L"Key1"));
+      Assert::IsTrue(view.Find(L"Key2") == &object.At(L"Key2"));
+      Assert::IsNull(view.Find(L"Missing"));
+    }
+
+    TEST_METHOD(TestIterator)
+    {
+      auto object = JsonObject{ { L"Key1", 1 }, { L"Key2", 2 }, { L"Key3", 3 } };
+      auto view = JsonObjectView(object);
+      auto i = 0;
+      for (auto& [key, value] : view)
+      {
+        ++i;
+        Assert::AreEqual(L"Key" + to_wstring(i), key);
+        Assert::AreEqual<Json>(i, value);
+        Assert::IsTrue(&value == &object.At(key));
+      }
+      Assert::AreEqual(3, i);
+    }
+  };
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include "stdafx.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Test
+{
+  TEST_CLASS(JsonPatchTest)
+  {
+  private:
+    // Returns the patch between source and target, after checking that it turns source into target.
+    // The members added by the patch are at the end of their objects, so the order of the members is not compared.
+    static Json RoundTrip(Json const& source, Json const& target)
+    {
+      auto patch = source.Diff(target);
+      auto patched = source;
+      patched.Apply(patch);
+      Assert::IsTrue(JsonPatch::Equal(target, patched));
+      return patch;
+    }
+  public:
+    TEST_METHOD(TestApply)
+    {
+      // The examples of RFC 6902 Appendix A
+      auto tests = vector<tuple<Json, Json, Json>>
+      {
+        { LR"({ "foo": "bar" })"_json,
+          LR"([{ "op": "add", "path": "/baz", "value": "qux" }])"_json,
+          LR"({ "foo": "bar", "baz": "qux" })"_json },
+        { LR"({ "foo": ["bar", "baz"] })"_json,
+          LR"([{ "op": "add", "path": "/foo/1", "value": "qux" }])"_json,
+          LR"({ "foo": ["bar", "qux", "baz"] })"_json },
+        { LR"({ "baz": "qux", "foo": "bar" })"_json,
+          LR"([{ "op": "remove", "path": "/baz" }])"_json,
+          LR"({ "foo": "bar" })"_json },
+        { LR"({ "foo": ["bar", "qux", "baz"] })"_json,
+          LR"([{ "op": "remove", "path": "/foo/1" }])"_json,
+          LR"({ "foo": ["bar", "baz"] })"_json },
+        { LR"({ "baz": "qux", "foo": "bar" })"_json,
+          LR"([{ "op": "replace", "path": "/baz", "value": "boo" }])"_json,
+          LR"({ "baz": "boo", "foo": "bar" })"_json },
+        { LR"({ "foo": { "bar": "baz", "waldo": "fred" }, "qux": { "corge": "grault" } })"_json,
+          LR"([{ "op": "move", "from": "/foo/waldo", "path": "/qux/thud" }])"_json,
+          LR"({ "foo": { "bar": "baz" }, "qux": { "corge": "grault", "thud": "fred" } })"_json },
+        { LR"({ "foo": ["all", "grass", "cows", "eat"] })"_json,
+          LR"([{ "op": "move", "from": "/foo/1", "path": "/foo/3" }])"_json,
+          LR"({ "foo": ["all", "cows", "eat", "grass"] })"_json },
+        { LR"({ "baz": "qux", "foo": ["a", 2, "c"] })"_json,
+          LR"([{ "op": "test", "path": "/baz", "value": "qux" }, { "op": "test", "path": "/foo/1", "value": 2 }])"_json,
+          LR"({ "baz": "qux", "foo": ["a", 2, "c"] })"_json },
+        { LR"({ "foo": "bar" })"_json,
+          LR"([{ "op": "add", "path": "/child", "value": { "grandchild": {} } }])"_json,
+          LR"({ "foo": "bar", "child": { "grandchild": {} } })"_json },
+        { LR"({ "foo": ["bar"] })"_json,
+          LR"([{ "op": "add", "path": "/foo/-", "value": ["abc", "def"] }])"_json,
+          LR"({ "foo": ["bar", ["abc", "def"]] })"_json },
+        { LR"({ "/": 9, "~1": 10 })"_json,
+          LR"([{ "op": "test", "path": "/~01", "value": 10 }, { "op": "copy", "from": "/~1", "path": "/~0" }])"_json,
+          LR"({ "/": 9, "~1": 10, "~": 9 })"_json },
+        // Adding an existing member replaces it, and the whole document can be replaced
+        { LR"({ "foo": "bar" })"_json,
+          LR"([{ "op": "add", "path": "/foo", "value": 1 }, { "op": "add", "path": "", "value": [{ "foo": 2 }] }, { "op": "replace", "path": "/0/foo", "value": 3 }])"_json,
+          LR"([{ "foo": 3 }])"_json },
+        // The copy is not changed with the original
+        { LR"({ "foo": { "bar": 1 } })"_json,
+          LR"([{ "op": "copy", "from": "/foo", "path": "/baz" }, { "op": "replace", "path": "/foo/bar", "value": 2 }])"_json,
+          LR"({ "foo": { "bar": 2 }, "baz": { "bar": 1 } })"_json },
+      };
+      for (auto& [input, patch, expected] : tests)
+      {
+        input.Apply(patch);
+        Assert::AreEqual(expected, input);
+      }
+    }
+
+    TEST_METHOD(TestApplyFail)
+    {
+      auto json = LR"({ "foo": ["bar", "baz"], "qux": { "quux": 1 } })"_json;
+      auto original = json;
+      auto apply = [&](wchar_t const* patch) { json.Apply(Json::Parse(patch)); };
+      ExceptException<exception>([&]() { json.Apply(LR"({ "op": "remove", "path": "/foo" })"_json); }, "Invalid JSON Patch, it has to be an array of operations!");
+      ExceptException<exception>([&]() { apply(LR"([1])"); }, "JSON Patch operation 0 failed, it has to be an object!");
+      ExceptException<exception>([&]() { apply(LR"([{ "path": "/foo" }])"); }, "JSON Patch operation 0 failed, missing member: op!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": 1, "path": "/foo" }])"); }, "JSON Patch operation 0 failed, member op has to be a string!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "append", "path": "/foo" }])"); }, "JSON Patch operation 0 failed, unknown op: append!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "add", "path": "/foo" }])"); }, "JSON Patch operation 0 failed, missing member: value!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "add", "path": "foo", "value": 1 }])"); }, "JSON Patch operation 0 failed, member path is not a valid JSON Pointer: foo!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "add", "path": "/a/b", "value": 1 }])"); }, "JSON Patch operation 0 failed, path not found: /a/b!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "add", "path": "/foo/3", "value": 1 }])"); }, "JSON Patch operation 0 failed, index out of range: /foo/3!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "add", "path": "/foo/01", "value": 1 }])"); }, "JSON Patch operation 0 failed, index out of range: /foo/01!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "remove", "path": "/foo/2" }])"); }, "JSON Patch operation 0 failed, path not found: /foo/2!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "remove", "path": "" }])"); }, "JSON Patch operation 0 failed, the whole document can not be removed!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "replace", "path": "/baz", "value": 1 }])"); }, "JSON Patch operation 0 failed, path not found: /baz!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "move", "from": "/qux", "path": "/qux/quux/corge" }])"); }, "JSON Patch operation 0 failed, a value can not be moved into itself: /qux/quux/corge!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "copy", "from": "/baz", "path": "/qux" }])"); }, "JSON Patch operation 0 failed, path not found: /baz!");
+      // The examples of RFC 6902 Appendix A.9 and A.15, strings and numbers are not equal
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "test", "path": "/foo/0", "value": "qux" }])"); }, "JSON Patch operation 0 failed, test failed at: /foo/0!");
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "test", "path": "/qux/quux", "value": "1" }])"); }, "JSON Patch operation 0 failed, test failed at: /qux/quux!");
+      // The operations before the failing one are not applied either
+      ExceptException<exception>([&]() { apply(LR"([{ "op": "remove", "path": "/foo/0" }, { "op": "replace", "path": "/qux/quux", "value": 2 }, { "op": "remove", "path": "/baz" }])"); },
+                                 "JSON Patch operation 2 failed, path not found: /baz!");
+      Assert::AreEqual(original, json);
+    }
+
+    TEST_METHOD(TestMerge)
+    {
+      // The examples of RFC 7396 Appendix A
+      auto tests = vector<tuple<Json, Json, Json>>
+      {
+        { LR"({ "a": "b" })"_json, LR"({ "a": "c" })"_json, LR"({ "a": "c" })"_json },
+        { LR"({ "a": "b" })"_json, LR"({ "b": "c" })"_json, LR"({ "a": "b", "b": "c" })"_json },
+        { LR"({ "a": "b" })"_json, LR"({ "a": null })"_json, LR"({})"_json },
+        { LR"({ "a": "b", "b": "c" })"_json, LR"({ "a": null })"_json, LR"({ "b": "c" })"_json },
+        { LR"({ "a": ["b"] })"_json, LR"({ "a": "c" })"_json, LR"({ "a": "c" })"_json },
+        { LR"({ "a": "c" })"_json, LR"({ "a": ["b"] })"_json, LR"({ "a": ["b"] })"_json },
+        { LR"({ "a": { "b": "c" } })"_json, LR"({ "a": { "b": "d", "c": null } })"_json, LR"({ "a": { "b": "d" } })"_json },
+        { LR"({ "a": [{ "b": "c" }] })"_json, LR"({ "a": [1] })"_json, LR"({ "a": [1] })"_json },
+        { LR"(["a", "b"])"_json, LR"(["c", "d"])"_json, LR"(["c", "d"])"_json },
+        { LR"({ "a": "b" })"_json, LR"(["c"])"_json, LR"(["c"])"_json },
+        { LR"({ "a": "foo" })"_json, Json(nullptr), Json(nullptr) },
+        { LR"({ "a": "foo" })"_json, Json(L"bar"), Json(L"bar") },
+        { LR"({ "e": null })"_json, LR"({ "a": 1 })"_json, LR"({ "e": null, "a": 1 })"_json },
+        { LR"([1, 2])"_json, LR"({ "a": "b", "c": null })"_json, LR"({ "a": "b" })"_json },
+        { LR"({})"_json, LR"({ "a": { "bb": { "ccc": null } } })"_json, LR"({ "a": { "bb": {} } })"_json },
+      };
+      for (auto& [input, patch, expected] : tests)
+      {
+        input.Merge(patch);
+        Assert::AreEqual(expected, input);
+      }
+
+      // A part of the document itself as the patch
+      auto json = LR"({ "a": { "a": 1, "b": 2 }, "b": 3 })"_json;
+      json.Merge(json[L"a"]);
+      Assert::AreEqual(LR"({ "a": 1, "b": 2 })"_json, json);
+    }
+
+    TEST_METHOD(TestDiff)
+    {
+      Assert::AreEqual(LR"([])"_json, RoundTrip(LR"({ "a": [1, 2] })"_json, LR"({ "a": [1, 2] })"_json));
+      Assert::AreEqual(LR"([{ "op": "replace", "path": "", "value": { "a": 1 } }])"_json, RoundTrip(LR"([1])"_json, LR"({ "a": 1 })"_json));
+      Assert::AreEqual(LR"([{ "op": "replace", "path": "", "value": 2 }])"_json, RoundTrip(Json(1), Json(2)));
+      Assert::AreEqual(LR"([{ "op": "remove", "path": "/a" }, { "op": "replace", "path": "/b", "value": 3 }, { "op": "add", "path": "/c", "value": 4 }])"_json,
+                       RoundTrip(LR"({ "a": 1, "b": 2 })"_json, LR"({ "b": 3, "c": 4 })"_json));
+      Assert::AreEqual(LR"([{ "op": "replace", "path": "/a~1b", "value": 2 }, { "op": "remove", "path": "/m~0n" }])"_json,
+                       RoundTrip(LR"({ "a/b": 1, "m~n": 2 })"_json, LR"({ "a/b": 2 })"_json));
+      Assert::AreEqual(LR"([{ "op": "replace", "path": "/a/b/c", "value": [1] }])"_json,
+                       RoundTrip(LR"({ "a": { "b": { "c": {} } } })"_json, LR"({ "a": { "b": { "c": [1] } } })"_json));
+      // Numbers are compared by their value, but booleans are not numbers, and the order of the members does not matter
+      Assert::AreEqual(LR"([])"_json, RoundTrip(LR"({ "a": 1, "b": { "c": 1, "d": 2 } })"_json, LR"({ "a": 1.0, "b": { "d": 2, "c": 1 } })"_json));
+      Assert::AreEqual(LR"([{ "op": "replace", "path": "/a", "value": true }])"_json, RoundTrip(LR"({ "a": 1 })"_json, LR"({ "a": true })"_json));
+
+      // Elements of arrays are inserted and removed where they are, and changed elements are diffed recursively
+      Assert::AreEqual(LR"([{ "op": "add", "path": "/1", "value": 4 }])"_json, RoundTrip(LR"([1, 2, 3])"_json, LR"([1, 4, 2, 3])"_json));
+      Assert::AreEqual(LR"([{ "op": "remove", "path": "/1" }])"_json, RoundTrip(LR"([1, 2, 3])"_json, LR"([1, 3])"_json));
+      Assert::AreEqual(LR"([{ "op": "add", "path": "/3", "value": 4 }])"_json, RoundTrip(LR"([1, 2, 3])"_json, LR"([1, 2, 3, 4])"_json));
+      Assert::AreEqual(LR"([{ "op": "remove", "path": "/0" }, { "op": "remove", "path": "/0" }])"_json, RoundTrip(LR"([1, 2, 3])"_json, LR"([3])"_json));
+      Assert::AreEqual(LR"([{ "op": "replace", "path": "/1/value", "value": "c" }])"_json,
+                       RoundTrip(LR"([{ "id": 1, "value": "a" }, { "id": 2, "value": "b" }])"_json, LR"([{ "id": 1, "value": "a" }, { "id": 2, "value": "c" }])"_json));
+      Assert::AreEqual(LR"([{ "op": "remove", "path": "/0" }, { "op": "add", "path": "/2", "value": 1 }])"_json, RoundTrip(LR"([1, 2, 3])"_json, LR"([2, 3, 1])"_json));
+      Assert::AreEqual(LR"([{ "op": "add", "path": "/0", "value": [] }, { "op": "replace", "path": "/2", "value": 4 }])"_json,
+                       RoundTrip(LR"([{}, 2])"_json, LR"([[], {}, 4])"_json));
+
+      // A modified copy shares the rest of the document, which is not compared
+      auto json = LR"({ "items": [{ "id": 1, "tags": ["a"] }, { "id": 2, "tags": ["b"] }], "count": 2 })"_json;
+      auto copy = json;
+      copy[L"items"][1][L"tags"].PushBack(L"c");
+      Assert::AreEqual(LR"([{ "op": "add", "path": "/items/1/tags/1", "value": "c" }])"_json, RoundTrip(json, copy));
+    }
+
+    TEST_METHOD(TestDiffMemberOrder)
+    {
+      // The order of the members is not part of the patch, the added members end up after the others
+      auto source = LR"({ "a": 1, "b": 2 })"_json;
+      auto target = LR"({ "c": 3, "b": 2, "a": 1 })"_json;
+      auto patch = RoundTrip(source, target);
+      Assert::AreEqual(LR"([{ "op": "add", "path": "/c", "value": 3 }])"_json, patch);
+      source.Apply(patch);
+      Assert::AreEqual(LR"({ "a": 1, "b": 2, "c": 3 })"_json, source);
+      Assert::IsTrue(source != target);
+      Assert::IsTrue(JsonPatch::Equal(source, target));
+    }
+
+    TEST_METHOD(TestDiffArrays)
+    {
+      // Arrays edited at random places, the patch has to turn one into the other whichever edit script is found
+      auto seed = 12345u;
+      auto random = [&](uint32_t bound) { seed = seed * 1103515245u + 12345u; return (int64_t)((seed >> 16) % bound); };
+      for (int i = 0; i < 200; ++i)
+      {
+        auto source = JsonArray();
+        for (auto size = random(40); size > 0; --size)
+        {
+          source.PushBack(random(10));
+        }
+        auto target = source;
+        for (auto edits = random(10); edits > 0; --edits)
+        {
+          switch (random(3))
+          {
+          case 0: target.Insert(random(target.Size() + 1), random(10)); break;
+          case 1: if (target.Size()) target.Erase(random(target.Size())); break;
+          case 2: if (target.Size()) target[random(target.Size())] = JsonObject{ { L"value", random(10) } }; break;
+          }
+        }
+        RoundTrip(source, target);
+      }
+
+      // Over JsonPatch::ArrayEditLimit the elements are changed in place
+      auto source = JsonArray();
+      auto target = JsonArray();
+      for (int64_t i = 0; i < 3000; ++i)
+      {
+        source.PushBack(i);
+        target.PushBack(2999 - i);
+      }
+      target.PushBack(3000);
+      auto patch = RoundTrip(source, target);
+      Assert::AreEqual(3001i64, patch.Size());
+      Assert::AreEqual(LR"({ "op": "add", "path": "/3000", "value": 3000 })"_json, patch.At(3000));
+    }
+
+    TEST_METHOD(TestEqual)
+    {
+      Assert::IsTrue (JsonPatch::Equal(Json(1), Json(1.0)));
+      Assert::IsFalse(JsonPatch::Equal(Json(1), Json(true)));
+      Assert::IsFalse(JsonPatch::Equal(Json(0), Json(nullptr)));
+      Assert::IsFalse(JsonPatch::Equal(Json(L"1"), Json(1)));
+      Assert::IsTrue (JsonPatch::Equal(LR"({ "a": 1, "b": [1, { "c": 2, "d": 3 }] })"_json, LR"({ "b": [1.0, { "d": 3, "c": 2 }], "a": 1 })"_json));
+      Assert::IsFalse(JsonPatch::Equal(LR"({ "a": 1, "b": 2 })"_json, LR"({ "a": 1, "c": 2 })"_json));
+      Assert::IsFalse(JsonPatch::Equal(LR"({ "a": 1 })"_json, LR"({ "a": 1, "b": 2 })"_json));
+      Assert::IsFalse(JsonPatch::Equal(LR"([1, 2])"_json, LR"([2, 1])"_json));
+      Assert::IsFalse(JsonPatch::Equal(LR"([])"_json, LR"({})"_json));
+    }
+  };
+}
@@ -0,0 +1,278 @@
+#include "stdafx.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Test
+{
+  TEST_CLASS(JsonPathTest)
+  {
+  private:
+    // The example document of RFC 9535
+    static Json Document()
+    {
+      return LR"({ "store": {
+        "book": [
+          { "category": "reference",
+            "author": "Nigel Rees",
+            "title": "Sayings of the Century",
+            "price": 8.95
+          },
+          { "category": "fiction",
+            "author": "Evelyn Waugh",
+            "title": "Sword of Honour",
+            "price": 12.99
+          },
+          { "category": "fiction",
+            "author": "Herman Melville",
+            "title": "Moby Dick",
+            "isbn": "0-553-21311-3",
+            "price": 8.99
+          },
+          { "category": "fiction",
+            "author": "J. R. R. Tolkien",
+            "title": "The Lord of the Rings",
+            "isbn": "0-395-19395-8",
+            "price": 22.99
+          }
+        ],
+        "bicycle": {
+          "color": "red",
+          "price": 399
+        }
+      }})"_json;
+    }
+
+    // The matches of path in json as an array
+    static Json Query(Json const& json, wstring_view path)
+    {
+      auto results = vector<Json const*>();
+      JsonPath(path).Evaluate(json, results);
+      auto array = JsonArray();
+      for (auto result : results)
+      {
+        array.PushBack(*result);
+      }
+      return array;
+    }
+  public:
+    TEST_METHOD(TestConstructor)
+    {
+      Assert::AreEqual<wstring>(L"$.store.book[*]", JsonPath(L"$.store.book[*]").ToString());
+      JsonPath(L"$");
+      JsonPath(L"$.a.b['c'][\"d\"][0][-1][*].*");
+      JsonPath(L"$[1:2][::-1][:][1:][:2:3]");
+      JsonPath(L"$..a..*..[0, 'b']");
+      JsonPath(L"$[?@.a == 'b' && (!@.c || @.d[0] >= -1.5e3)]");
+      JsonPath(L"$[?(@.a != null)][?($.x < true)][?@['a b'] > false]");
+      JsonPath(L" $ .a [ 0 , 1 ] ");
+    }
+
+    TEST_METHOD(TestConstructorInvalid)
+    {
+      ExceptException<exception>([]() { JsonPath(L""); }, "Invalid JSONPath at position 0: !");
+      ExceptException<exception>([]() { JsonPath(L"store"); }, "Invalid JSONPath at position 0: store!");
+      ExceptException<exception>([]() { JsonPath(L"$store"); }, "Invalid JSONPath at position 1: $store!");
+      ExceptException<exception>([]() { JsonPath(L"$."); }, "Invalid JSONPath at position 2: $.!");
+      ExceptException<exception>([]() { JsonPath(L"$.0"); }, "Invalid JSONPath at position 2: $.0!");
+      ExceptException<exception>([]() { JsonPath(L"$[0"); }, "Invalid JSONPath at position 3: $[0!");
+      ExceptException<exception>([]() { JsonPath(L"$[]"); }, "Invalid JSONPath at position 2: $[]!");
+      ExceptException<exception>([]() { JsonPath(L"$['a]"); }, "Invalid JSONPath at position 5: $['a]!");
+      ExceptException<exception>([]() { JsonPath(L"$['\\x']"); }, "Invalid JSONPath at position 4: $['\\x']!");
+      ExceptException<exception>([]() { JsonPath(L"$[?1]"); }, "Invalid JSONPath at position 4: $[?1]!");
+      ExceptException<exception>([]() { JsonPath(L"$[?@.a == ]"); }, "Invalid JSONPath at position 10: $[?@.a == ]!");
+      ExceptException<exception>([]() { JsonPath(L"$[?@.a == nil]"); }, "Invalid JSONPath at position 10: $[?@.a == nil]!");
+      ExceptException<exception>([]() { JsonPath(L"$[?(@.a]"); }, "Invalid JSONPath at position 7: $[?(@.a]!");
+      ExceptException<exception>([]() { JsonPath(L"$[?@.*]"); }, "Invalid JSONPath at position 5: $[?@.*]!");
+      ExceptException<exception>([]() { JsonPath(L"$[1234567890123456789]"); }, "Invalid JSONPath at position 2: $[1234567890123456789]!");
+    }
+
+    TEST_METHOD(TestName)
+    {
+      auto json = Document();
+      Assert::AreEqual<Json>({ L"red" }, Query(json, L"$.store.bicycle.color"));
+      Assert::AreEqual<Json>({ L"red" }, Query(json, L"$['store'][\"bicycle\"]['color']"));
+      Assert::AreEqual<Json>(JsonArray(), Query(json, L"$.store.missing"));
+      Assert::AreEqual<Json>(JsonArray(), Query(json, L"$.store.book.color"));
+      Assert::AreEqual<Json>({ 1 }, Query(LR"({ "a b": 1 })"_json, L"$['a b']"));
+      Assert::AreEqual<Json>({ 2 }, Query(LR"({ "'": 2 })"_json, L"$['\\'']"));
+      Assert::AreEqual<Json>({ 3 }, Query(LR"({ "\u00e1": 3 })"_json, L"$['\\u00e1']"));
+    }
+
+    TEST_METHOD(TestIndex)
+    {
+      auto json = Document();
+      Assert::AreEqual<Json>({ L"Nigel Rees" }, Query(json, L"$.store.book[0].author"));
+      Assert::AreEqual<Json>({ L"J. R. R. Tolkien" }, Query(json, L"$.store.book[-1].author"));
+      Assert::AreEqual<Json>({ L"Nigel Rees" }, Query(json, L"$.store.book[-4].author"));
+      Assert::AreEqual<Json>(JsonArray(), Query(json, L"$.store.book[4]"));
+      Assert::AreEqual<Json>(JsonArray(), Query(json, L"$.store.book[-5]"));
+      Assert::AreEqual<Json>(JsonArray(), Query(json, L"$.store[0]"));
+    }
+
+    TEST_METHOD(TestWildcard)
+    {
+      auto json = Document();
+      Assert::AreEqual<Json>({ L"Nigel Rees", L"Evelyn Waugh", L"Herman Melville", L"J. R. R. Tolkien" }, Query(json, L"$.store.book[*].author"));
+      Assert::AreEqual<Json>({ L"red", 399 }, Query(json, L"$.store.bicycle.*"));
+      Assert::AreEqual<Json>(JsonArray(), Query(json, L"$.store.bicycle.color.*"));
+    }
+
+    TEST_METHOD(TestSlice)
+    {
+      auto json = Json{ 0, 1, 2, 3, 4, 5, 6 };
+      Assert::AreEqual<Json>({ 1, 2 }, Query(json, L"$[1:3]"));
+      Assert::AreEqual<Json>({ 5, 6 }, Query(json, L"$[5:]"));
+      Assert::AreEqual<Json>({ 0, 1 }, Query(json, L"$[:2]"));
+      Assert::AreEqual<Json>({ 1, 3 }, Query(json, L"$[1:5:2]"));
+      Assert::AreEqual<Json>({ 5, 3 }, Query(json, L"$[5:1:-2]"));
+      Assert::AreEqual<Json>({ 6, 5, 4, 3, 2, 1, 0 }, Query(json, L"$[::-1]"));
+      Assert::AreEqual<Json>({ 4, 5 }, Query(json, L"$[-3:-1]"));
+      Assert::AreEqual<Json>({ 0, 1, 2, 3, 4, 5, 6 }, Query(json, L"$[-100:100]"));
+      Assert::AreEqual<Json>(JsonArray(), Query(json, L"$[3:1]"));
+      Assert::AreEqual<Json>(JsonArray(), Query(json, L"$[::0]"));
+      Assert::AreEqual<Json>(JsonArray(), Query(Json{ { L"a", 1 } }, L"$[:]"));
+    }
+
+    TEST_METHOD(TestUnion)
+    {
+      auto json = Document();
+      Assert::AreEqual<Json>({ L"Sayings of the Century", L"Moby Dick" }, Query(json, L"$.store.book[0, 2].title"));
+      Assert::AreEqual<Json>({ L"Moby Dick", L"Sayings of the Century", L"Moby Dick" }, Query(json, L"$.store.book[2, 0:3:2].title"));
+      Assert::AreEqual<Json>({ L"red", 399 }, Query(json, L"$.store.bicycle['color', 'price']"));
+    }
+
+    TEST_METHOD(TestDescendant)
+    {
+      auto json = Document();
+      Assert::AreEqual<Json>({ L"Nigel Rees", L"Evelyn Waugh", L"Herman Melville", L"J. R. R. Tolkien" }, Query(json, L"$..author"));
+      Assert::AreEqual<Json>({ 8.95, 12.99, 8.99, 22.99, 399 }, Query(json, L"$.store..price"));
+      Assert::AreEqual<Json>({ L"The Lord of the Rings" }, Query(json, L"$..book[-1].title"));
+      Assert::AreEqual<Json>({ L"Sayings of the Century", L"Sword of Honour" }, Query(json, L"$..book[:2].title"));
+      Assert::AreEqual(27i64, Query(json, L"$..*").Size());
+      Assert::AreEqual<Json>({ 1, 2, 3 }, Query(LR"({ "a": 1, "b": { "a": 2, "c": [ { "a": 3 } ] } })"_json, L"$..a"));
+      Assert::AreEqual<Json>(LR"([[1, 2], 1, 3])"_json, Query(LR"([[1, 2], [3]])"_json, L"$..[0]"));
+    }
+
+    TEST_METHOD(TestFilter)
+    {
+      auto json = Document();
+      Assert::AreEqual<Json>({ L"Moby Dick", L"The Lord of the Rings" }, Query(json, L"$..book[?@.isbn].title"));
+      Assert::AreEqual<Json>({ L"Sayings of the Century", L"Sword of Honour" }, Query(json, L"$..book[?!@.isbn].title"));
+      Assert::AreEqual<Json>({ L"Sayings of the Century", L"Moby Dick" }, Query(json, L"$..book[?@.price < 10].title"));
+      Assert::AreEqual<Json>({ L"Sayings of the Century", L"Moby Dick" }, Query(json, L"$..book[?(@.price<10)].title"));
+      Assert::AreEqual<Json>({ L"Sword of Honour", L"The Lord of the Rings" }, Query(json, L"$..book[?@.price >= 12.99].title"));
+      Assert::AreEqual<Json>({ L"Sword of Honour" }, Query(json, L"$..book[?@.price > 10 && @.price <= 20].title"));
+      Assert::AreEqual<Json>({ L"Sayings of the Century", L"The Lord of the Rings" }, Query(json, L"$..book[?@.category == 'reference' || @.price > 20].title"));
+      Assert::AreEqual<Json>({ L"Sword of Honour", L"Moby Dick", L"The Lord of the Rings" }, Query(json, L"$..book[?@.category != \"reference\"].title"));
+      Assert::AreEqual<Json>({ L"Moby Dick" }, Query(json, L"$..book[?@.author > 'H' && @.author < 'I'].title"));
+      Assert::AreEqual<Json>({ L"The Lord of the Rings" }, Query(json, L"$..book[?!(@.price < 20 || @.category == 'reference')].title"));
+      Assert::AreEqual<Json>({ L"Sayings of the Century" }, Query(json, L"$..book[?@.price < $.store.book[2].price].title"));
+      Assert::AreEqual<Json>({ L"red" }, Query(json, L"$.store[?@.price == 399].color"));
+      Assert::AreEqual<Json>({ L"red" }, Query(json, L"$.store.bicycle[?@ == 'red']"));
+    }
+
+    TEST_METHOD(TestFilterComparison)
+    {
+      auto json = LR"([1, 1.0, 2, true, false, null, "1", [1], {"a": 1}])"_json;
+      Assert::AreEqual<Json>({ 1, 1.0 }, Query(json, L"$[?@ == 1]"));
+      Assert::AreEqual<Json>({ true }, Query(json, L"$[?@ == true]"));
+      Assert::AreEqual<Json>({ nullptr }, Query(json, L"$[?@ == null]"));
+      Assert::AreEqual<Json>({ L"1" }, Query(json, L"$[?@ == '1']"));
+      Assert::AreEqual<Json>(LR"([[1]])"_json, Query(json, L"$[?@ == $[7]]"));
+      Assert::AreEqual<Json>(LR"([{"a": 1}])"_json, Query(json, L"$[?@ == $[8]]"));
+      Assert::AreEqual<Json>({ 1, 1.0 }, Query(json, L"$[?@ < 2]"));
+      Assert::AreEqual<Json>({ 1, 1.0, 2 }, Query(json, L"$[?@ <= 2]"));
+      Assert::AreEqual<Json>(JsonArray(), Query(json, L"$[?@ < true]"));
+      Assert::AreEqual<Json>({ true }, Query(json, L"$[?@ <= true]"));
+      Assert::AreEqual<Json>(JsonArray(), Query(json, L"$[?@ < null]"));
+      // Missing values are only equal to each other
+      Assert::AreEqual<Json>(LR"([1, 1.0, 2, true, false, null, "1", [1]])"_json, Query(json, L"$[?@.a == @.b]"));
+      Assert::AreEqual<Json>(JsonArray(), Query(json, L"$[?@.a == null]"));
+      Assert::AreEqual<Json>(json, Query(json, L"$[?@.b <= @.c]"));
+      Assert::AreEqual<Json>(JsonArray(), Query(json, L"$[?@.b < @.c]"));
+      Assert::AreEqual<Json>(LR"([[1]])"_json, Query(json, L"$[?@[0]]"));
+      Assert::AreEqual<Json>(LR"([[1]])"_json, Query(json, L"$[?@[-1] == 1]"));
+    }
+
+    TEST_METHOD(TestEvaluate)
+    {
+      auto json = Document();
+      auto path = JsonPath(L"$..price");
+      auto results = vector<Json const*>();
+      path.Evaluate(json, results);
+      Assert::AreEqual<size_t>(5, results.size());
+      Assert::IsTrue(results[0] == &json[L"store"][L"book"][0][L"price"]);
+      Assert::IsTrue(results[4] == &json[L"store"][L"bicycle"][L"price"]);
+      // Evaluate appends to the results
+      path.Evaluate(json, results);
+      Assert::AreEqual<size_t>(10, results.size());
+
+      auto hash = json.Hash();
+      auto matches = vector<Json*>();
+      JsonPath(L"$.store.book[*].price").Evaluate(json, matches);
+      for (auto match : matches)
+      {
+        *match = 1;
+      }
+      Assert::AreEqual<Json>({ 1, 1, 1, 1 }, Query(json, L"$.store.book[*].price"));
+      // The containers on the way drop their cached hash
+      Assert::AreNotEqual(hash, json.Hash());
+      Assert::AreEqual(Json::Parse(json.Dump()).Hash(), json.Hash());
+    }
+
+    TEST_METHOD(TestFirst)
+    {
+      auto json = Document();
+      auto const& constant = json;
+      Assert::IsTrue(JsonPath(L"$").First(constant) == &constant);
+      Assert::IsTrue(JsonPath(L"$..price").First(constant) == &constant.At(L"store").At(L"book").At(0).At(L"price"));
+      Assert::IsTrue(JsonPath(L"$..book[?@.isbn]").First(constant) == &constant.At(L"store").At(L"book").At(2));
+      Assert::IsNull(JsonPath(L"$..missing").First(constant));
+      auto hash = json.Hash();
+      *JsonPath(L"$.store.bicycle.color").First(json) = L"blue";
+      // The containers on the way drop their cached hash
+      Assert::AreNotEqual(hash, json.Hash());
+      *JsonPath(L"$..color").First(json) = L"red";
+      Assert::AreEqual(hash, json.Hash());
+      *JsonPath(L"$..color").First(json) = L"blue";
+      Assert::AreEqual<Json>(L"blue", json[L"store"][L"bicycle"][L"color"]);
+    }
+
+    TEST_METHOD(TestShared)
+    {
+      // The non-const overloads detach only the containers on the way to the matches from the copies sharing their contents
+      auto json = Document();
+      auto copy = json;
+      auto const& constant = json;
+      auto const& constCopy = copy;
+      auto matches = vector<Json*>();
+      JsonPath(L"$..missing").Evaluate(json, matches);
+      Assert::IsNull(JsonPath(L"$..book[?@.price > 100]").First(json));
+      Assert::IsTrue(&constant.At(L"store").At(L"book").At(1).At(L"price") == &constCopy.At(L"store").At(L"book").At(1).At(L"price"));
+      Assert::IsTrue(&constant.At(L"store").At(L"bicycle").At(L"color") == &constCopy.At(L"store").At(L"bicycle").At(L"color"));
+
+      *JsonPath(L"$.store.book[1].price").First(json) = 1;
+      Assert::AreEqual<Json>(1, constant.At(L"store").At(L"book").At(1).At(L"price"));
+      Assert::AreEqual<Json>(12.99, constCopy.At(L"store").At(L"book").At(1).At(L"price"));
+      Assert::IsTrue(&constant.At(L"store").At(L"book").At(1).At(L"title") != &constCopy.At(L"store").At(L"book").At(1).At(L"title"));
+      // The siblings of the containers on the way stay shared
+      Assert::IsTrue(&constant.At(L"store").At(L"book").At(0).At(L"price") == &constCopy.At(L"store").At(L"book").At(0).At(L"price"));
+      Assert::IsTrue(&constant.At(L"store").At(L"bicycle").At(L"color") == &constCopy.At(L"store").At(L"bicycle").At(L"color"));
+
+      // The same for every match of a query
+      JsonPath(L"$..book[?@.isbn].price").Evaluate(json, matches);
+      Assert::AreEqual<size_t>(2, matches.size());
+      for (auto match : matches)
+      {
+        *match = 2;
+      }
+      Assert::AreEqual<Json>({ 8.95, 1, 2, 2 }, Query(json, L"$.store.book[*].price"));
+      Assert::AreEqual<Json>({ 8.95, 12.99, 8.99, 22.99 }, Query(copy, L"$.store.book[*].price"));
+      Assert::IsTrue(&constant.At(L"store").At(L"book").At(0).At(L"price") == &constCopy.At(L"store").At(L"book").At(0).At(L"price"));
+      Assert::IsTrue(&constant.At(L"store").At(L"bicycle").At(L"color") == &constCopy.At(L"store").At(L"bicycle").At(L"color"));
+    }
+  };
+}
\ No newline at end of file
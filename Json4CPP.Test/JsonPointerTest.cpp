@@ -0,0 +1,118 @@
+#include "stdafx.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Test
+{
+  TEST_CLASS(JsonPointerTest)
+  {
+  private:
+    // The example document of RFC 6901
+    static Json Document()
+    {
+      return LR"({
+        "foo": ["bar", "baz"],
+        "": 0,
+        "a/b": 1,
+        "c%d": 2,
+        "e^f": 3,
+        "g|h": 4,
+        "i\\j": 5,
+        "k\"l": 6,
+        " ": 7,
+        "m~n": 8
+      })"_json;
+    }
+  public:
+    TEST_METHOD(TestConstructor)
+    {
+      Assert::AreEqual<wstring>(L"", JsonPointer(L"").ToString());
+      Assert::AreEqual(0i64, JsonPointer(L"").Size());
+      Assert::AreEqual<wstring>(L"/foo/0", JsonPointer(L"/foo/0").ToString());
+      Assert::AreEqual(2i64, JsonPointer(L"/foo/0").Size());
+      Assert::AreEqual(1i64, JsonPointer(L"/").Size());
+      Assert::AreEqual(3i64, JsonPointer(L"/a//b").Size());
+      Assert::AreEqual(1i64, JsonPointer(L"/m~0n~1").Size());
+      ExceptException<exception>([]() { JsonPointer(L"foo"); }, "Invalid JSON Pointer, it has to start with '/': foo!");
+      ExceptException<exception>([]() { JsonPointer(L"/foo~"); }, "Invalid JSON Pointer, '~' has to be followed by '0' or '1': /foo~!");
+      ExceptException<exception>([]() { JsonPointer(L"/foo~2"); }, "Invalid JSON Pointer, '~' has to be followed by '0' or '1': /foo~2!");
+    }
+
+    TEST_METHOD(TestFind)
+    {
+      auto json = Document();
+      Assert::IsTrue(JsonPointer(L"").Find(json) == &json);
+      Assert::IsTrue(JsonPointer(L"/foo").Find(json) == &json[L"foo"]);
+      Assert::AreEqual<Json>({ L"bar", L"baz" }, *JsonPointer(L"/foo").Find(json));
+      Assert::AreEqual<Json>(L"bar", *JsonPointer(L"/foo/0").Find(json));
+      Assert::AreEqual<Json>(L"baz", *JsonPointer(L"/foo/1").Find(json));
+      Assert::AreEqual<Json>(0, *JsonPointer(L"/").Find(json));
+      Assert::AreEqual<Json>(1, *JsonPointer(L"/a~1b").Find(json));
+      Assert::AreEqual<Json>(2, *JsonPointer(L"/c%d").Find(json));
+      Assert::AreEqual<Json>(3, *JsonPointer(L"/e^f").Find(json));
+      Assert::AreEqual<Json>(4, *JsonPointer(L"/g|h").Find(json));
+      Assert::AreEqual<Json>(5, *JsonPointer(L"/i\\j").Find(json));
+      Assert::AreEqual<Json>(6, *JsonPointer(L"/k\"l").Find(json));
+      Assert::AreEqual<Json>(7, *JsonPointer(L"/ ").Find(json));
+      Assert::AreEqual<Json>(8, *JsonPointer(L"/m~0n").Find(json));
+
+      Assert::IsNull(JsonPointer(L"/missing").Find(json));
+      Assert::IsNull(JsonPointer(L"/foo/2").Find(json));
+      Assert::IsNull(JsonPointer(L"/foo/-").Find(json));
+      Assert::IsNull(JsonPointer(L"/foo/01").Find(json));
+      Assert::IsNull(JsonPointer(L"/foo/-1").Find(json));
+      Assert::IsNull(JsonPointer(L"/foo/0/bar").Find(json));
+      Assert::IsNull(JsonPointer(L"/a~1b/0").Find(json));
+
+      // Numeric keys of objects are looked up as keys
+      auto object = Json{ { L"0", L"zero" }, { L"01", L"one" } };
+      Assert::AreEqual<Json>(L"zero", *JsonPointer(L"/0").Find(object));
+      Assert::AreEqual<Json>(L"one", *JsonPointer(L"/01").Find(object));
+    }
+
+    TEST_METHOD(TestFindNonConst)
+    {
+      auto json = Document();
+      auto hash = json.Hash();
+      auto pointer = JsonPointer(L"/foo/1");
+      *pointer.Find(json) = L"qux";
+      // The containers on the way drop their cached hash
+      Assert::AreNotEqual(hash, json.Hash());
+      JsonPointer(L"/foo/1").At(json) = L"baz";
+      Assert::AreEqual(hash, json.Hash());
+      *pointer.Find(json) = L"qux";
+      Assert::AreEqual<Json>({ L"bar", L"qux" }, json[L"foo"]);
+    }
+
+    TEST_METHOD(TestAt)
+    {
+      auto json = Document();
+      auto const& constant = json;
+      Assert::IsTrue(&JsonPointer(L"/foo/0").At(constant) == &constant.At(L"foo").At(0));
+      Assert::AreEqual<Json>(8, JsonPointer(L"/m~0n").At(constant));
+      JsonPointer(L"/ ").At(json) = 70;
+      Assert::AreEqual<Json>(70, json[L" "]);
+      ExceptException<out_of_range>([&]() { JsonPointer(L"/foo/2").At(constant); }, "Path not found: /foo/2!");
+      ExceptException<out_of_range>([&]() { JsonPointer(L"/missing").At(json); }, "Path not found: /missing!");
+    }
+
+    TEST_METHOD(TestLargeObject)
+    {
+      // Objects larger than JsonObject::LinearSearchLimit are searched through their index with the precomputed hashes
+      auto object = JsonObject();
+      for (int i = 0; i < 100; ++i)
+      {
+        object.Insert({ L"Key" + to_wstring(i), i });
+      }
+      auto json = Json(object);
+      for (int i = 0; i < 100; ++i)
+      {
+        Assert::AreEqual<Json>(i, JsonPointer(L"/Key" + to_wstring(i)).At(json));
+      }
+      Assert::IsNull(JsonPointer(L"/Key100").Find(json));
+    }
+  };
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include "stdafx.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Test
+{
+  TEST_CLASS(JsonPushParserTest)
+  {
+  private:
+    // Collects the tokens the same way as JsonLinter::Read does.
+    class TokenHandler : public JsonHandler
+    {
+    public:
+      deque<TOKEN> tokens;
+
+      void Null        (               ) override { tokens.emplace_back(JsonTokenType::Null        , nullptr    ); }
+      void String      (wstring&& value) override { tokens.emplace_back(JsonTokenType::String      , move(value)); }
+      void Boolean     (bool      value) override { tokens.emplace_back(JsonTokenType::Boolean     , value      ); }
+      void Real        (double    value) override { tokens.emplace_back(JsonTokenType::Real        , value      ); }
+      void Integer     (int64_t   value) override { tokens.emplace_back(JsonTokenType::Integer     , value      ); }
+      void PropertyName(wstring&& value) override { tokens.emplace_back(JsonTokenType::PropertyName, move(value)); }
+      void StartObject (               ) override { tokens.emplace_back(JsonTokenType::StartObject , L"{"s       ); }
+      void EndObject   (               ) override { tokens.emplace_back(JsonTokenType::EndObject   , L"}"s       ); }
+      void StartArray  (               ) override { tokens.emplace_back(JsonTokenType::StartArray  , L"["s       ); }
+      void EndArray    (               ) override { tokens.emplace_back(JsonTokenType::EndArray    , L"]"s       ); }
+    };
+
+    // Pushes text in chunks of the sizes returned by next, and returns the tokens or the error.
+    template<typename F>
+    static pair<deque<TOKEN>, string> Push(string const& text, F next)
+    {
+      auto handler = TokenHandler();
+      auto parser = JsonPushParser(handler);
+      try
+      {
+        for (size_t position = 0; position < text.size();)
+        {
+          auto size = min(next(), text.size() - position);
+          parser.Push(string_view(text).substr(position, size));
+          position += size;
+        }
+        parser.Finish();
+      }
+      catch (exception const& e)
+      {
+        return { handler.tokens, e.what() };
+      }
+      return { handler.tokens, ""s };
+    }
+
+    static void Compare(string const& text, pair<deque<TOKEN>, string> const& actual)
+    {
+      auto expected = pair<deque<TOKEN>, string>();
+      try
+      {
+        expected.first = JsonLinter::Read(string_view(text));
+      }
+      catch (exception const& e)
+      {
+        expected.second = e.what();
+      }
+      Assert::AreEqual(expected.second, actual.second);
+      if (expected.second.empty())
+      {
+        Assert::AreEqual<size_t>(expected.first.size(), actual.first.size());
+        for (size_t i = 0; i < expected.first.size(); ++i)
+        {
+          Assert::AreEqual<JsonTokenType>(expected.first[i].first, actual.first[i].first);
+          Assert::AreEqual<VALUE_TOKEN>(expected.first[i].second, actual.first[i].second);
+        }
+      }
+    }
+  public:
+    TEST_METHOD(TestPush)
+    {
+      auto texts = vector<string>();
+      for (auto& file : CorpusFiles(true))
+      {
+        texts.push_back(ReadAllBytes(file));
+      }
+      auto inputs = vector<wstring>
+      {
+        L""s, L"  \r\n "s, L"["s, L"{"s, L"[1,"s, L"{\"a\""s, L"{\"a\":"s, L"{\"a\":1"s, L"\"abc"s, L"[\"abc"s, L"[1 2]"s, L"[12x]"s,
+        L"[-]"s, L"[01]"s, L"[1.]"s, L"[1e+]"s, L"[truex]"s, L"[tru]"s, L"[nul"s, L"[1,]"s, L"[] x"s, L"[]\r\n\r\n  2"s, L"1337"s,
+        L"[\"\\\\\\\"\", \"\\u00e9\\\"\"]"s, L"[\"\\u12G4\"]"s, L"[\"a\tb\"]"s, L"{ \"a\" : [ 1.5e3, -0, true, false, null ] }\r\n"s,
+        L"[\"\u00E9\u03A9\u20AC\", { \"\u20AC\": [ \"\u03A9\" ] }]"s, L"\r\n\r\n[\r\n  1,\r\n  x\r\n]"s, L"[\r\n\"\u00E9\", \u00E9]"s,
+        wstring(19, L'[') + wstring(19, L']'), wstring(20, L'[') + wstring(20, L']'),
+      };
+      for (auto& input : inputs)
+      {
+        texts.push_back(WString2String(input));
+      }
+      texts.push_back("[\"\xC3\xA9\xC3\"]"s);
+      texts.push_back("[\r\n\"\xE2\x82\"]"s);
+
+      // Every text in chunks of a fixed size, and of pseudo random sizes up to 8 and up to 256 bytes
+      auto state = uint64_t(0x9E3779B97F4A7C15);
+      for (auto& text : texts)
+      {
+        for (size_t size : { 1, 2, 3, 5, 64, 4096 })
+        {
+          Compare(text, Push(text, [&] { return size; }));
+        }
+        for (int i = 0; i < 8; ++i)
+        {
+          auto limit = i < 4 ? 8 : 256;
+          Compare(text, Push(text, [&]
+          {
+            state = state * 6364136223846793005ui64 + 1442695040888963407ui64;
+            return (size_t)(state >> 33) % limit + 1;
+          }));
+        }
+      }
+    }
+
+    TEST_METHOD(TestPending)
+    {
+      // Only the token which is not complete yet is kept, and a number is only complete after the character which ends it
+      auto handler = TokenHandler();
+      auto parser = JsonPushParser(handler);
+      parser.Push("{ \"abc"sv);
+      Assert::AreEqual<size_t>(1, handler.tokens.size());
+      Assert::AreEqual<size_t>(5, parser.Pending());
+      Assert::AreEqual<int64_t>(1, parser.Depth());
+      parser.Push("def\" : [ 12"sv);
+      Assert::AreEqual<size_t>(3, handler.tokens.size());
+      Assert::AreEqual<size_t>(3, parser.Pending());
+      Assert::AreEqual<int64_t>(2, parser.Depth());
+      parser.Push("34"sv);
+      Assert::AreEqual<size_t>(3, handler.tokens.size());
+      parser.Push(" ]"sv);
+      Assert::AreEqual<size_t>(5, handler.tokens.size());
+      Assert::AreEqual(VALUE_TOKEN(1234ll), handler.tokens[3].second);
+      Assert::AreEqual<int64_t>(1, parser.Depth());
+      parser.Push(" }"sv);
+      Assert::AreEqual<size_t>(6, handler.tokens.size());
+      Assert::AreEqual<int64_t>(0, parser.Depth());
+      parser.Finish();
+      Assert::AreEqual<size_t>(6, handler.tokens.size());
+      ExceptException<exception>([&]() { parser.Push("1"sv); }, "The input has already been finished!"s);
+
+      // A large document in small chunks does not keep more than a chunk and a value
+      auto text = "["s;
+      for (int i = 0; i < 10000; ++i)
+      {
+        text += (i ? ", "s : ""s) + "{ \"id\": "s + to_string(i) + ", \"name\": \"item "s + to_string(i) + "\" }"s;
+      }
+      text += "]"s;
+      auto dom = Json();
+      auto builder = JsonDomHandler(dom);
+      auto large = JsonPushParser(builder);
+      for (size_t position = 0; position < text.size(); position += 100)
+      {
+        large.Push(string_view(text).substr(position, 100));
+        Assert::IsTrue(large.Pending() < 150);
+      }
+      large.Finish();
+      Assert::AreEqual(Json::Parse(text), dom);
+
+      // After an error, every call throws it again
+      auto failing = JsonPushParser(handler);
+      ExceptException<exception>([&]() { failing.Push("[1 2"sv); }, "Expected ',' or ']' at position Line: 1 Column: 4!"s);
+      ExceptException<exception>([&]() { failing.Push("]"sv); }, "Expected ',' or ']' at position Line: 1 Column: 4!"s);
+      ExceptException<exception>([&]() { failing.Finish(); }, "Expected ',' or ']' at position Line: 1 Column: 4!"s);
+    }
+  };
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+﻿#include "stdafx.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Test
+{
+  TEST_CLASS(JsonReaderTest)
+  {
+  private:
+    static deque<TOKEN> ReadAll(JsonReader& reader)
+    {
+      auto tokens = deque<TOKEN>();
+      while (reader.Read())
+      {
+        tokens.push_back({ reader.TokenType(), reader.Value() });
+      }
+      return tokens;
+    }
+
+    template<typename F>
+    static string Message(F func)
+    {
+      try
+      {
+        func();
+      }
+      catch (exception const& e)
+      {
+        return e.what();
+      }
+      return ""s;
+    }
+
+  public:
+    TEST_METHOD(TestRead)
+    {
+      for (auto& file : CorpusFiles())
+      {
+        auto text = ReadAllText(file);
+        auto utf8 = WString2String(text);
+        auto expected = JsonLinter::Read(text);
+        // Small buffers are refilled many times, even in the middle of multi-byte sequences
+        for (auto bufferSize : { 1, 5, 7, 64, 65536 })
+        {
+          auto is = istringstream(utf8);
+          auto reader = JsonReader(is, bufferSize);
+          Assert::IsTrue(expected == ReadAll(reader));
+          Assert::AreEqual<JsonTokenType>(JsonTokenType::Undefined, reader.TokenType());
+        }
+        auto reader1 = JsonReader(wstring_view(text));
+        auto reader2 = JsonReader(string_view(utf8));
+        auto is = wistringstream(text);
+        auto reader3 = JsonReader(is);
+        Assert::IsTrue(expected == ReadAll(reader1));
+        Assert::IsTrue(expected == ReadAll(reader2));
+        Assert::IsTrue(expected == ReadAll(reader3));
+      }
+    }
+
+    TEST_METHOD(TestReadHandler)
+    {
+      for (auto& file : Files(L"pass"s, 3))
+      {
+        auto is = istringstream(WString2String(ReadAllText(file)));
+        auto json = Json();
+        auto handler = JsonDomHandler(json);
+        JsonLinter::Read(is, handler);
+        Assert::AreEqual(Json::Read(file), json);
+      }
+
+      // The rest of the document can be handed over after reading the first few tokens
+      auto json = Json();
+      auto handler = JsonDomHandler(json);
+      auto reader = JsonReader(u8"[ 1, { \"a\": [ true, null ] }, \"Ω\" ]"sv);
+      reader.Read();
+      handler.StartArray();
+      reader.Read(handler);
+      Assert::AreEqual(Json{ 1, Json{ { L"a"s, Json{ true, nullptr } } }, L"Ω"s }, json);
+    }
+
+    TEST_METHOD(TestDepth)
+    {
+      auto reader = JsonReader(L"{ \"a\": [ 1 ], \"b\": {} }"sv);
+      auto expected = vector<pair<JsonTokenType, int64_t>>
+      {
+        { JsonTokenType::StartObject , 1 },
+        { JsonTokenType::PropertyName, 1 },
+        { JsonTokenType::StartArray  , 2 },
+        { JsonTokenType::Integer     , 2 },
+        { JsonTokenType::EndArray    , 1 },
+        { JsonTokenType::PropertyName, 1 },
+        { JsonTokenType::StartObject , 2 },
+        { JsonTokenType::EndObject   , 1 },
+        { JsonTokenType::EndObject   , 0 },
+      };
+      for (auto& [token, depth] : expected)
+      {
+        Assert::IsTrue(reader.Read());
+        Assert::AreEqual<JsonTokenType>(token, reader.TokenType());
+        Assert::AreEqual(depth, reader.Depth());
+      }
+      Assert::IsFalse(reader.Read());
+      Assert::IsFalse(reader.Read());
+    }
+
+    TEST_METHOD(TestFail)
+    {
+      // Everything before the error is still read
+      auto is = istringstream("[ 1, 2 3 ]"s);
+      auto reader = JsonReader(is, 1);
+      Assert::IsTrue(reader.Read());
+      Assert::IsTrue(reader.Read());
+      Assert::IsTrue(reader.Read());
+      ExceptException<exception>([&]() { reader.Read(); }, "Expected ',' or ']' at position Line: 1 Column: 8!"s);
+
+      for (auto& file : Files(L"fail"s, 33))
+      {
+        auto text = ReadAllText(file);
+        auto expected = Message([&]() { JsonLinter::Read(text); });
+        for (auto bufferSize : { 1, 65536 })
+        {
+          auto is = istringstream(WString2String(text));
+          auto reader = JsonReader(is, bufferSize);
+          Assert::AreEqual(expected, Message([&]() { ReadAll(reader); }));
+        }
+      }
+
+      auto pairs = vector<pair<string, string>>
+      {
+        { "[\r\n  1,\r\n  2\r\n  3\r\n]"s, "Expected ',' or ']' at position Line: 4 Column: 3!"s },
+        { u8"{\r\n  \"Ω\": tru\r\n}"s, "Expected 'true' at position Line: 2 Column: 8!"s },
+        { u8"[ \"\U0001F600\", \"€\" ] 0"s, "Unexpected '0' at position Line: 1 Column: 15!"s },
+        { "[\r\n  \"a\r\n"s, "Invalid character found at position Line: 2 Column: 5!"s },
+        { "{ \"a\": 1"s, "Expected ',' or '}' at position Line: 1 Column: 9!"s },
+        { "[\r\n  \"ab\xE2\x82\"]"s, "Invalid UTF-8 sequence at position Line: 2 Column: 6!"s },
+        { "[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]]]]"s, "Depth is greater or equal to the maximum 20!"s },
+      };
+      for (auto& [input, expected] : pairs)
+      {
+        for (auto bufferSize : { 1, 2, 3, 65536 })
+        {
+          auto is = istringstream(input);
+          auto reader = JsonReader(is, bufferSize);
+          ExceptException<exception>([&]() { ReadAll(reader); }, expected);
+        }
+        ExceptException<exception>([&]() { JsonLinter::Read(string_view(input)); }, expected);
+      }
+    }
+  };
+}
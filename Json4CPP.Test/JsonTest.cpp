@@ -378,6 +378,99 @@ namespace Json4CPP::Test
       }
     }
 
+    TEST_METHOD(TestHash)
+    {
+      // Consistent with operator==, where numbers and booleans are compared by their value
+      Assert::AreEqual(Json(1).Hash(), Json(1.0).Hash());
+      Assert::AreEqual(Json(1).Hash(), Json(true).Hash());
+      Assert::AreEqual(Json(0).Hash(), Json(-0.0).Hash());
+      Assert::AreEqual(Json(nullptr).Hash(), Json().Hash());
+      Assert::AreEqual(Json(L"Test").Hash(), Json(L"Test"s).Hash());
+      Assert::AreNotEqual(Json(1).Hash(), Json(2).Hash());
+      Assert::AreNotEqual(Json(1).Hash(), Json(1.5).Hash());
+      Assert::AreNotEqual(Json(L"Test").Hash(), Json(L"test").Hash());
+      Assert::AreEqual(Json(JsonObject{ { L"Key1", 1 } }).Hash(), JsonObject{ { L"Key1", 1 } }.Hash());
+      Assert::AreEqual(Json(JsonArray{ 1, 2 }).Hash(), JsonArray{ 1, 2 }.Hash());
+      Assert::IsTrue(hash<Json>()(Json(L"Test")) == (size_t)Json(L"Test").Hash());
+
+      // Json values as keys of hash containers
+      auto documents = vector<Json>{
+        L"{ \"Key1\": [1, 2, 3], \"Key2\": { \"Key3\": null } }"_json,
+        L"{ \"Key1\": [1, 2, 3], \"Key2\": { \"Key3\": false } }"_json,
+        L"{ \"Key1\": [1.0, 2, 3], \"Key2\": { \"Key3\": null } }"_json,
+        L"{ \"Key2\": { \"Key3\": null }, \"Key1\": [1, 2, 3] }"_json,
+        L"[1, 2, 3]"_json,
+        L"[true, 2, 3]"_json,
+      };
+      auto unique = unordered_set<Json>(documents.begin(), documents.end());
+      Assert::AreEqual<size_t>(4, unique.size());
+      auto counts = unordered_map<Json, int>();
+      for (auto& document : documents)
+      {
+        ++counts[document];
+      }
+      Assert::AreEqual(2, counts[documents[0]]);
+      Assert::AreEqual(1, counts[documents[1]]);
+      Assert::AreEqual(1, counts[documents[3]]);
+      Assert::AreEqual(2, counts[documents[4]]);
+    }
+
+    TEST_METHOD(TestCopyOnWrite)
+    {
+      // A modified copy detaches only the objects and arrays on the path to the modified value, the others stay shared
+      auto original = LR"({ "Key1": { "Key2": [1, 2], "Key3": [3, 4] }, "Key4": { "Key5": 5 } })"_json;
+      auto copy = original;
+      auto const& constOriginal = original;
+      auto const& constCopy = copy;
+      Assert::IsTrue(&constOriginal.At(L"Key1").At(L"Key2").At(0) == &constCopy.At(L"Key1").At(L"Key2").At(0));
+      copy[L"Key1"][L"Key2"][0] = 10;
+      Assert::AreEqual<Json>(1, constOriginal.At(L"Key1").At(L"Key2").At(0));
+      Assert::AreEqual<Json>(10, constCopy.At(L"Key1").At(L"Key2").At(0));
+      Assert::IsTrue(&constOriginal.At(L"Key1").At(L"Key2").At(1) != &constCopy.At(L"Key1").At(L"Key2").At(1));
+      Assert::IsTrue(&constOriginal.At(L"Key1").At(L"Key3").At(0) == &constCopy.At(L"Key1").At(L"Key3").At(0));
+      Assert::IsTrue(&constOriginal.At(L"Key4").At(L"Key5") == &constCopy.At(L"Key4").At(L"Key5"));
+      Assert::AreEqual(LR"({ "Key1": { "Key2": [1, 2], "Key3": [3, 4] }, "Key4": { "Key5": 5 } })"_json, original);
+
+      copy = original;
+      copy[L"Key1"][L"Key3"].PushBack(5);
+      copy[L"Key4"].Insert({ L"Key6", 6 });
+      copy[L"Key1"][L"Key2"].Erase(0);
+      copy.Erase(L"Key4");
+      Assert::AreEqual(LR"({ "Key1": { "Key2": [2], "Key3": [3, 4, 5] } })"_json, copy);
+      Assert::AreEqual(LR"({ "Key1": { "Key2": [1, 2], "Key3": [3, 4] }, "Key4": { "Key5": 5 } })"_json, original);
+
+      // The original is detached in the same way when it is modified first
+      copy = original;
+      original[L"Key4"][L"Key5"] = 50;
+      Assert::AreEqual<Json>(5, constCopy.At(L"Key4").At(L"Key5"));
+      Assert::IsTrue(&constOriginal.At(L"Key1").At(L"Key2").At(0) == &constCopy.At(L"Key1").At(L"Key2").At(0));
+
+      // Copies of a value of the document itself
+      copy = original;
+      copy[L"Key1"] = copy;
+      Assert::AreEqual<Json>(50, constCopy.At(L"Key1").At(L"Key4").At(L"Key5"));
+      Assert::AreEqual(LR"({ "Key1": { "Key2": [1, 2], "Key3": [3, 4] }, "Key4": { "Key5": 50 } })"_json, original);
+    }
+
+    TEST_METHOD(TestCopyAfterReference)
+    {
+      // References into a document stay bound to it, the copies made after they are obtained are not changed through them
+      auto document = LR"({ "Key1": { "Key2": 1 }, "Key3": [{ "Key4": 2 }] })"_json;
+      auto& child = document[L"Key1"];
+      auto snapshot = document;
+      child[L"Key2"] = 2;
+      Assert::AreEqual(LR"({ "Key1": { "Key2": 1 }, "Key3": [{ "Key4": 2 }] })"_json, snapshot);
+      auto& grandchild = document[L"Key3"][0][L"Key4"];
+      snapshot = document;
+      grandchild = 3;
+      Assert::AreEqual(LR"({ "Key1": { "Key2": 2 }, "Key3": [{ "Key4": 2 }] })"_json, snapshot);
+      auto pointed = JsonPointer(L"/Key3/0/Key4").Find(document);
+      snapshot = document;
+      *pointed = 4;
+      Assert::AreEqual(LR"({ "Key1": { "Key2": 2 }, "Key3": [{ "Key4": 3 }] })"_json, snapshot);
+      Assert::AreEqual(LR"({ "Key1": { "Key2": 2 }, "Key3": [{ "Key4": 4 }] })"_json, document);
+    }
+
     TEST_METHOD(TestDump)
     {
       auto pairs = vector<pair<Json, wstring>>
@@ -683,6 +776,30 @@ namespace Json4CPP::Test
       Assert::AreEqual<Json>(L"rosebud", input[19]);
     }
 
+    TEST_METHOD(TestReadFile)
+    {
+      // Mapped into memory and parsed in place
+      for (auto& file : { L"pass01.json"s, L"pass02.json"s, L"pass03.json"s, L"roundtrip27.json"s })
+      {
+        auto mapping = JsonFileMapping(file);
+        Assert::IsTrue(mapping.IsMapped());
+        Assert::AreEqual(ReadAllBytes(file), string(mapping.Data()));
+        Assert::AreEqual(Json::Parse(ReadAllText(file)), Json::Read(file));
+      }
+
+      // Empty files can not be mapped, they are read as a stream instead
+      WriteAllText(L"empty.json"s, L""s);
+      Assert::IsFalse(JsonFileMapping(L"empty.json"s).IsMapped());
+      ExceptException<exception>([]() { Json::Read(L"empty.json"s); }, "Expected one of the following characters: 'n', '\"', 't', 'f', '-', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '{' or '[' at position Line: 1 Column: 1!"s);
+
+      Assert::IsFalse(JsonFileMapping(L"NonExistent.file"s).IsMapped());
+      ExceptException<exception>([]() { Json::Read(L"NonExistent.file"s); }, "Could not open file: NonExistent.file!"s);
+
+      ofstream(filesystem::path(L"invalid.json"s), ofstream::binary) << "[\r\n  \"\xFF\"\r\n]"s;
+      ExceptException<exception>([]() { Json::Read(L"invalid.json"s); }, "Invalid UTF-8 sequence at position Line: 2 Column: 4!"s);
+      ExceptException<exception>([]() { Json::Read(L"fail18.json"s); }, "Depth is greater or equal to the maximum 20!"s);
+    }
+
     TEST_METHOD(TestWrite)
     {
       Json::Read(L"pass01.json").Write(L"pass01_copy.json");
@@ -1057,10 +1174,10 @@ namespace Json4CPP::Test
       };
       Assert::AreEqual<Json>(1, json.At(L"Key1"s));
       Assert::AreEqual<Json>(2, json.At(L"Key2"s));
-      json.At(L"Key1"s) = 1337;
-      json.At(L"Key2"s) = 31337;
-      Assert::AreEqual<Json>(1, json.At(L"Key1"s));
-      Assert::AreEqual<Json>(2, json.At(L"Key2"s));
+      // The values are returned by reference, without copying them
+      static_assert(is_same_v<decltype(json.At(L"Key1"s)), Json const&>);
+      Assert::IsTrue(&json.At(L"Key1"s) == &json.Get<JsonObject>().At(L"Key1"s));
+      Assert::IsTrue(&json.At(L"Key2"s) == &json.Get<JsonObject>().At(L"Key2"s));
     }
 
     TEST_METHOD(TestAt2)
@@ -1096,14 +1213,12 @@ namespace Json4CPP::Test
       Assert::AreEqual<Json>(3, json.At(1));
       Assert::AreEqual<Json>(3, json.At(2));
       Assert::AreEqual<Json>(7, json.At(3));
-      json.At(0) = 1337;
-      json.At(1) = 1338;
-      json.At(2) = 1339;
-      json.At(3) = 1340;
-      Assert::AreEqual<Json>(1, json.At(0));
-      Assert::AreEqual<Json>(3, json.At(1));
-      Assert::AreEqual<Json>(3, json.At(2));
-      Assert::AreEqual<Json>(7, json.At(3));
+      // The values are returned by reference, without copying them
+      static_assert(is_same_v<decltype(json.At(0)), Json const&>);
+      for (int i = 0; i < 4; ++i)
+      {
+        Assert::IsTrue(&json.At(i) == &json.Get<JsonArray>().At(i));
+      }
     }
 
     TEST_METHOD(TestAt4)
@@ -1129,6 +1244,28 @@ namespace Json4CPP::Test
       Assert::AreEqual<Json>(1340, json.At(3));
     }
 
+    TEST_METHOD(TestFind)
+    {
+      auto json = Json{
+        { L"Key1"s, 1 },
+        { L"Key2"s, { 1, 3, 3, 7 } }
+      };
+      auto const& constJson = json;
+      Assert::IsTrue(json.Find(L"Key1"s) == &json.At(L"Key1"s));
+      Assert::IsTrue(constJson.Find(L"Key2"s) == &constJson.At(L"Key2"s));
+      Assert::IsNull(json.Find(L"Key3"s));
+      Assert::IsTrue(constJson.Find(L"Key2"s)->Find(3) == &constJson.At(L"Key2"s).At(3));
+      Assert::IsNull(constJson.Find(L"Key2"s)->Find(4));
+      Assert::IsNull(constJson.Find(L"Key2"s)->Find(L"Key1"s));
+      Assert::IsNull(json.Find(0));
+      Assert::IsNull(constJson.At(L"Key1"s).Find(L"Key1"s));
+      Assert::IsNull(constJson.At(L"Key1"s).Find(0));
+      Assert::IsNull(Json().Find(L"Key1"s));
+
+      *json.Find(L"Key2"s)->Find(0) = 9999;
+      Assert::AreEqual<Json>(9999, json.At(L"Key2"s).At(0));
+    }
+
     TEST_METHOD(TestOperatorConversionNullptr)
     {
       ExceptException<exception>([]() { auto temp = (nullptr_t)Json(wstring   ()); }, "Invalid conversion!");
@@ -1310,6 +1447,28 @@ namespace Json4CPP::Test
       Assert::AreEqual<JsonArray>(JsonArray{ 1, 3, 3, 7 }, (JsonArray)Json(JsonArray{ 1, 3, 3, 7 }));
     }
 
+    TEST_METHOD(TestOperatorConversionJsonObjectView)
+    {
+      ExceptException<exception>([]() { auto temp = (JsonObjectView)Json(nullptr_t ()); }, "Invalid conversion!");
+      ExceptException<exception>([]() { auto temp = (JsonObjectView)Json(int64_t   ()); }, "Invalid conversion!");
+      ExceptException<exception>([]() { auto temp = (JsonObjectView)Json(JsonArray ()); }, "Invalid conversion!");
+      auto const json = Json(JsonObject{ { L"Key1"s, 1 }, { L"Key2"s, 2 } });
+      auto view = (JsonObjectView)json;
+      Assert::IsTrue(&view.Object() == &json.Get<JsonObject>());
+      Assert::AreEqual<JsonObject>(JsonObject{ { L"Key1"s, 1 }, { L"Key2"s, 2 } }, view.Object());
+    }
+
+    TEST_METHOD(TestOperatorConversionJsonArrayView)
+    {
+      ExceptException<exception>([]() { auto temp = (JsonArrayView)Json(nullptr_t ()); }, "Invalid conversion!");
+      ExceptException<exception>([]() { auto temp = (JsonArrayView)Json(int64_t   ()); }, "Invalid conversion!");
+      ExceptException<exception>([]() { auto temp = (JsonArrayView)Json(JsonObject()); }, "Invalid conversion!");
+      auto const json = Json(JsonArray{ 1, 3, 3, 7 });
+      auto view = (JsonArrayView)json;
+      Assert::IsTrue(&view.Array() == &json.Get<JsonArray>());
+      Assert::AreEqual<JsonArray>(JsonArray{ 1, 3, 3, 7 }, view.Array());
+    }
+
     TEST_METHOD(TestOperatorAssignmentNullptr)
     {
       auto json = Json(1337);
@@ -1640,6 +1799,215 @@ namespace Json4CPP::Test
       }
     }
 
+    TEST_METHOD(TestOperatorInsertionUtf8)
+    {
+      auto pairs = vector<pair<Json, string>>
+      {
+        { Json(nullptr ), "null"s     },
+        { Json(L"Test"s), "\"Test\""s },
+        { Json(L"\"\u00E1rv\u00EDzt\u0171r\u0151 \U0001F600\n\""s), u8"\"\\\"\u00E1rv\u00EDzt\u0171r\u0151 \U0001F600\\n\\\"\""s },
+        { Json(13.37   ), "13.37"s    },
+        { Json{ { L"Key1"s, 1 }, { L"\u03A9"s, 2 } }, u8"{\r\n  \"Key1\": 1,\r\n  \"\u03A9\": 2\r\n}"s },
+        { Json{ 1, 3, 3, 7 }, "[\r\n  1,\r\n  3,\r\n  3,\r\n  7\r\n]"s }
+      };
+      for (auto& [input, expected] : pairs)
+      {
+        stringstream os;
+        os << input;
+        Assert::AreEqual(expected, os.str());
+        Assert::AreEqual(WString2String(input.Dump(JsonDefault::Indentation)), os.str());
+      }
+    }
+
+    TEST_METHOD(TestOperatorExtractionUtf8)
+    {
+      auto pairs = vector<pair<string, Json>>
+      {
+        { "[null]"s    , Json{nullptr } },
+        { u8"[\"\u00E1rv\u00EDzt\u0171r\u0151 \U0001F600\"]"s, Json{ L"\u00E1rv\u00EDzt\u0171r\u0151 \U0001F600"s } },
+        { "[13.37]"s   , Json{13.37   } },
+        { u8"{\r\n  \"Key1\": 1,\r\n  \"\u03A9\": 2\r\n}"s, Json{ { L"Key1"s, 1 }, { L"\u03A9"s, 2 } } },
+      };
+      for (auto& [input, expected] : pairs)
+      {
+        stringstream is(input);
+        Json output;
+        is >> output;
+        Assert::AreEqual(expected, output);
+      }
+      ExceptException<exception>([]()
+      {
+        stringstream is("[\r\n  \"\xC3\"\r\n]"s);
+        Json output;
+        is >> output;
+      }, "Invalid UTF-8 sequence at position Line: 2 Column: 4!"s);
+    }
+
+    TEST_METHOD(TestParse)
+    {
+      auto backend = JsonDefault::Backend;
+      for (auto& file : CorpusFiles())
+      {
+        auto text = ReadAllText(file);
+        JsonDefault::Backend = JsonBackend::Linter;
+        auto expected = Json::Read(JsonLinter::Read(text));
+        for (auto other : { JsonBackend::Linter, JsonBackend::StructuralIndex })
+        {
+          JsonDefault::Backend = other;
+          Assert::AreEqual(expected, Json::Parse(text));
+          Assert::AreEqual(expected, Json::Parse(WString2String(text)));
+        }
+      }
+      JsonDefault::Backend = backend;
+
+      // The first value of a duplicate key is kept, the same way as Insert does
+      Assert::AreEqual(Json{ { L"a"s, 1 } }, Json::Parse(L"{ \"a\": 1, \"a\": { \"b\": [ 2 ] } }"sv));
+      Assert::AreEqual(Json{ { L"a"s, Json{ { L"b"s, 2 } } } }, Json::Parse(L"{ \"a\": { \"b\": 2, \"b\": 3 } }"sv));
+      Assert::AreEqual(Json{ { L"a"s, 1 }, { L"c"s, 4 } }, Json::Parse(L"{ \"a\": 1, \"a\": { \"a\": [ 2, { \"a\": 3, \"a\": 3 } ], \"a\": null }, \"c\": 4 }"sv));
+
+      auto pairs = vector<pair<wstring, string>>
+      {
+        { L"1337"s   , "Invalid token: Integer, with invalid data: 1337!"s },
+        { L"\"a\""s  , "Invalid token: String, with invalid data: \"a\"!"s },
+        { L"null 0"s , "Unexpected '0' at position Line: 1 Column: 6!"s },
+        { L"[1, 2"s  , "Expected ',' or ']' at position Line: 1 Column: 6!"s },
+      };
+      for (auto& [input, expected] : pairs)
+      {
+        ExceptException<exception>([&, input = input]() { Json::Parse(input); }, expected);
+        ExceptException<exception>([&, input = input]() { Json::Read(JsonLinter::Read(input)); }, expected);
+      }
+    }
+
+    TEST_METHOD(TestParseMemoryResource)
+    {
+      for (auto& file : { L"pass01.json"s, L"pass02.json"s, L"pass03.json"s })
+      {
+        auto text = ReadAllText(file);
+        auto resource = CountingResource();
+        Assert::AreEqual(Json::Parse(text), Json::Parse(text, &resource));
+        Assert::AreEqual(Json::Parse(text), Json::Parse(WString2String(text), &resource));
+        Assert::AreEqual(Json::Parse(text), Json::Read(file, &resource));
+        Assert::IsTrue(resource.allocations > 0);
+
+        auto arena = pmr::monotonic_buffer_resource();
+        Assert::AreEqual(Json::Parse(text), Json::Parse(text, &arena));
+      }
+
+      // Nested objects and arrays are allocated from the resource too, but copies are not
+      auto resource = CountingResource();
+      auto json = Json::Parse(L"{ \"a\": [ 1 ], \"b\": { \"c\": {} } }"sv, &resource);
+      auto allocations = resource.allocations;
+      json[L"a"s].PushBack(2);
+      Assert::IsTrue(resource.allocations > allocations);
+      allocations = resource.allocations;
+      json[L"b"s][L"c"s][L"d"s] = 3;
+      Assert::IsTrue(resource.allocations > allocations);
+      allocations = resource.allocations;
+      auto copy = json;
+      copy[L"a"s].PushBack(3);
+      copy[L"b"s][L"e"s] = 4;
+      Assert::AreEqual(allocations, resource.allocations);
+      Assert::AreEqual(Json{ { L"a"s, Json{ 1, 2 } }, { L"b"s, Json{ { L"c"s, Json{ { L"d"s, 3 } } } } } }, json);
+    }
+
+    TEST_METHOD(TestMoveMemoryResource)
+    {
+      // Values moved out of a document parsed into an arena are copied into the resource of their target,
+      // so they stay valid after the arena is released
+      auto text = ReadAllText(L"pass01.json"s);
+      auto expected = Json::Parse(text);
+      auto resource = CountingResource();
+      auto arena = make_unique<pmr::monotonic_buffer_resource>(&resource);
+      auto parse = [&]() { return Json::Parse(text, arena.get()); };
+
+      auto assigned = Json();
+      assigned = parse();
+      auto object = Json(JsonObject());
+      object[L"a"s] = parse();
+      auto array = JsonArray();
+      array.PushBack(parse());
+      array.Insert(0, parse());
+      array.EmplaceBack(parse());
+      array.PushBack(1);
+      array[3] = parse();
+      auto parsed = parse();
+      auto moved = JsonArray();
+      moved = move(*parsed.GetIf<JsonArray>());
+
+      auto modify = [](Json& json)
+      {
+        json[0] = 1;
+        json[1][L"object with 1 member"s].PushBack(2);
+      };
+      auto allocations = resource.allocations;
+      for (auto json : { &assigned, &object[L"a"s], &array[0], &array[3] })
+      {
+        modify(*json);
+      }
+      moved[0] = 1;
+      moved[1][L"object with 1 member"s].PushBack(2);
+      Assert::AreEqual(allocations, resource.allocations);
+
+      parsed = nullptr;
+      arena.reset();
+      auto modified = expected;
+      modify(modified);
+      Assert::AreEqual(modified, assigned);
+      Assert::AreEqual(modified, object[L"a"s]);
+      Assert::AreEqual(modified, array[0]);
+      Assert::AreEqual(expected, array[1]);
+      Assert::AreEqual(expected, array[2]);
+      Assert::AreEqual(modified, array[3]);
+      Assert::AreEqual(modified, Json(moved));
+    }
+
+    TEST_METHOD(TestParseParallel)
+    {
+      // Long enough to be split into 4 parts
+      auto text = L"[\r\n"s;
+      for (int i = 0; text.size() < 5 * JsonLinter::ParallelPartSize; ++i)
+      {
+        text += (i ? L",\r\n"s : L""s) + L"  { \"id\": "s + to_wstring(i) + L", \"name\": \"item, "s + to_wstring(i) + L"\", \"tags\": [ 1.5, true, null ] }"s;
+      }
+      text += L"\r\n]"s;
+      auto inputs = vector<wstring>{ text, text + L" x"s, text.substr(0, text.size() - 1), text };
+      inputs.back()[text.size() / 2] = L'}';
+
+      auto threads = JsonDefault::Threads;
+      for (auto& input : inputs)
+      {
+        auto parse = [&](auto const& value, pmr::memory_resource* resource)
+        {
+          try
+          {
+            return make_pair(Json::Parse(value, resource), ""s);
+          }
+          catch (exception const& e)
+          {
+            return make_pair(Json(), string(e.what()));
+          }
+        };
+        auto utf8 = WString2String(input);
+        JsonDefault::Threads = 1;
+        auto expected = parse(wstring_view(input), pmr::new_delete_resource());
+        for (auto number : { 2, 3, 4, 16 })
+        {
+          JsonDefault::Threads = (uint8_t)number;
+          auto pool = pmr::synchronized_pool_resource();
+          auto resource = CountingResource();
+          for (auto& actual : { parse(wstring_view(input), pmr::new_delete_resource()), parse(string_view(utf8), pmr::new_delete_resource()),
+                                parse(string_view(utf8), &pool), parse(string_view(utf8), &resource) })
+          {
+            Assert::AreEqual(expected.second, actual.second);
+            Assert::AreEqual(expected.first, actual.first);
+          }
+        }
+      }
+      JsonDefault::Threads = threads;
+      Assert::AreEqual<int64_t>(count(text.begin(), text.end(), L'{'), Json::Parse(text).Size());
+    }
+
     //http://json.org/JSON_checker/
     TEST_METHOD(TestFail)
     {
@@ -1679,10 +2047,17 @@ namespace Json4CPP::Test
         { "fail32.json"s, "Expected '\"' at position Line: 1 Column: 41!"s },
         { "fail33.json"s, "Expected ',' or ']' at position Line: 1 Column: 12!"s }
       };
-      for (auto& [input, expected] : pairs)
+      // Both backends report the same errors
+      auto backend = JsonDefault::Backend;
+      for (auto other : { JsonBackend::Linter, JsonBackend::StructuralIndex })
       {
-        ExceptException<exception>([&, input = input]() { Json::Read(input); }, expected);
+        JsonDefault::Backend = other;
+        for (auto& [input, expected] : pairs)
+        {
+          ExceptException<exception>([&, input = input]() { Json::Read(input); }, expected);
+        }
       }
+      JsonDefault::Backend = backend;
     }
 
     //http://json.org/JSON_checker/
@@ -0,0 +1,134 @@
+﻿#include "stdafx.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Json4CPP;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Test
+{
+  TEST_CLASS(JsonWriterTest)
+  {
+  public:
+    TEST_METHOD(TestWrite)
+    {
+      for (auto& file : CorpusFiles())
+      {
+        auto text = ReadAllText(file);
+        auto json = Json::Parse(text);
+        for (uint8_t indentation = 0; indentation <= 4; ++indentation)
+        {
+          auto tokens = JsonLinter::Read(text);
+          wostringstream expected;
+          JsonLinter::Write(expected, tokens, indentation);
+          wostringstream actual;
+          JsonWriter::Write(actual, json, indentation);
+          Assert::AreEqual(expected.str(), actual.str());
+          Assert::AreEqual(expected.str(), JsonWriter::Dump(json, indentation));
+        }
+      }
+    }
+
+    TEST_METHOD(TestWriteValues)
+    {
+      auto pairs = vector<pair<Json, wstring>>
+      {
+        { nullptr                              , L"null"s                                   },
+        { true                                 , L"true"s                                   },
+        { false                                , L"false"s                                  },
+        { 0                                    , L"0"s                                      },
+        { -9223372036854775807i64 - 1          , L"-9223372036854775808"s                   },
+        { 1.5                                  , L"1.5"s                                    },
+        { 0.1                                  , L"0.1"s                                    },
+        { -1.7976931348623157e+308             , L"-1.7976931348623157e+308"s               },
+        { L"\"\\/\b\f\n\r\t\x01\x1f Ω\U0001F600"s, L"\"\\\"\\\\/\\b\\f\\n\\r\\t\\u0001\\u001f Ω\U0001F600\""s },
+        { JsonObject()                         , L"{}"s                                     },
+        { JsonArray()                          , L"[]"s                                     },
+        { Json{ JsonObject(), JsonArray() }    , L"[\r\n  {},\r\n  []\r\n]"s                },
+        { Json{ { L"a"s, 1 }, { L"b"s, Json{ 2, Json{ 3 } } } }, L"{\r\n  \"a\": 1,\r\n  \"b\": [\r\n    2,\r\n    [\r\n      3\r\n    ]\r\n  ]\r\n}"s },
+      };
+      for (auto& [json, expected] : pairs)
+      {
+        Assert::AreEqual(expected, JsonWriter::Dump(json, 2));
+        Assert::AreEqual(expected, json.Dump(2));
+        wostringstream os;
+        os << json;
+        Assert::AreEqual(expected, os.str());
+      }
+      Assert::AreEqual(L"{\"a\":1,\"b\":[2,[3]]}"s, JsonWriter::Dump(JsonObject{ { L"a"s, 1 }, { L"b"s, Json{ 2, Json{ 3 } } } }, 0));
+      Assert::AreEqual(L"[1,{\"a\":null}]"s, JsonWriter::Dump(JsonArray{ 1, JsonObject{ { L"a"s, nullptr } } }, 0));
+    }
+
+    TEST_METHOD(TestWriteUtf8)
+    {
+      for (auto& file : CorpusFiles())
+      {
+        auto json = Json::Read(file);
+        for (uint8_t indentation = 0; indentation <= 4; ++indentation)
+        {
+          ostringstream os;
+          JsonWriter::Write(os, json, indentation);
+          Assert::AreEqual(WString2String(json.Dump(indentation)), os.str());
+        }
+      }
+
+      auto pairs = vector<pair<Json, string>>
+      {
+        { L"\x7F\x80\u07FF\u0800\uFFFF"s                      , u8"\"\x7F\u0080\u07FF\u0800\uFFFF\""s },
+        { L"\U00010000\U0010FFFF"s                             , u8"\"\U00010000\U0010FFFF\""s           },
+        { L"\"\\\x01 \t"s                                        , "\"\\\"\\\\\\u0001 \\t\""s             },
+        // Unpaired surrogates can not be encoded into UTF-8, so they are escaped
+        { wstring(1, (wchar_t)0xD800) + L"a"s + wstring(1, (wchar_t)0xDFFF), "\"\\ud800a\\udfff\""s },
+        { JsonObject{ { L"\u00E9"s, JsonArray{ L"\u00E9"s } } }, u8"{\"\u00E9\":[\"\u00E9\"]}"s           },
+      };
+      for (auto& [json, expected] : pairs)
+      {
+        ostringstream os;
+        JsonWriter::Write(os, json, 0);
+        Assert::AreEqual(expected, os.str());
+      }
+      ostringstream os1, os2;
+      JsonWriter::Write(os1, JsonObject{ { L"a"s, 1 } }, 2);
+      JsonWriter::Write(os2, JsonArray{ 1, L"\u00E9"s }, 0);
+      Assert::AreEqual("{\r\n  \"a\": 1\r\n}"s, os1.str());
+      Assert::AreEqual(u8"[1,\"\u00E9\"]"s, os2.str());
+    }
+
+    TEST_METHOD(TestWriteLarge)
+    {
+      // Large enough to be flushed to the stream several times
+      auto array = JsonArray();
+      for (int i = 0; i < 50000; ++i)
+      {
+        array.PushBack(JsonObject{ { L"index"s, i }, { L"name"s, L"item "s + to_wstring(i) } });
+      }
+      wostringstream os;
+      JsonWriter::Write(os, array, 4);
+      Assert::IsTrue(os.str().size() > 4 * JsonWriter::BufferSize);
+      Assert::AreEqual(array.Dump(4), os.str());
+      Assert::AreEqual(Json(array), Json::Parse(os.str()));
+    }
+
+    TEST_METHOD(TestAppend)
+    {
+      auto json = Json{ { L"a"s, Json{ 1, 2.5, L"\u00E9\u03A9\n"s } }, { L"b"s, nullptr } };
+      for (uint8_t indentation = 0; indentation <= 4; ++indentation)
+      {
+        auto buffer = "prefix"s;
+        Assert::AreEqual("prefix"s + WString2String(json.Dump(indentation)), JsonWriter::Append(buffer, json, indentation));
+        Assert::AreEqual("prefix"s + WString2String(json.Dump(indentation)), buffer);
+      }
+
+      // A buffer which is large enough is not reallocated
+      auto buffer = string();
+      buffer.reserve(1024);
+      auto data = buffer.data();
+      for (int i = 0; i < 10; ++i)
+      {
+        buffer.clear();
+        JsonWriter::Append(buffer, json, 0);
+        Assert::IsTrue(data == buffer.data());
+      }
+    }
+  };
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Json4CPP::Test
+{
+  // Returns the names of the test files from {prefix}01.json to {prefix}{count}.json.
+  inline std::vector<std::wstring> Files(std::wstring const& prefix, int count)
+  {
+    auto files = std::vector<std::wstring>();
+    for (int i = 1; i <= count; ++i)
+    {
+      files.push_back(prefix + (i < 10 ? L"0" : L"") + std::to_wstring(i) + L".json");
+    }
+    return files;
+  }
+
+  // Returns the names of the valid documents of the test corpus, pass01-03.json and roundtrip01-27.json,
+  // followed by the invalid ones, fail01-33.json, if they are asked for too.
+  inline std::vector<std::wstring> CorpusFiles(bool invalid = false)
+  {
+    auto files = Files(L"pass", 3);
+    for (auto& file : Files(L"roundtrip", 27))
+    {
+      files.push_back(file);
+    }
+    if (invalid)
+    {
+      for (auto& file : Files(L"fail", 33))
+      {
+        files.push_back(file);
+      }
+    }
+    return files;
+  }
+}
@@ -19,6 +19,8 @@
 #include <vector>
 #include <deque>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 #define _CRTDBG_MAP_ALLOC  
 #include <stdlib.h>  
@@ -30,6 +32,7 @@
 #define new new
 #endif
 #include "..\Json4CPP\Json.hpp"
+#include "TestHelper.h"
 
 namespace Microsoft::VisualStudio::CppUnitTestFramework
 {
@@ -60,4 +63,31 @@ namespace Microsoft::VisualStudio::CppUnitTestFramework
     }
     Assert::AreEqual(found, true);
   }
+}
+
+namespace Json4CPP::Test
+{
+  // Counts the allocations made through it, and passes them on to the default resource.
+  class CountingResource : public std::pmr::memory_resource
+  {
+  public:
+    size_t allocations = 0;
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+      ++allocations;
+      return std::pmr::get_default_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+      std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(memory_resource const& other) const noexcept override
+    {
+      return this == &other;
+    }
+  };
 }
\ No newline at end of file
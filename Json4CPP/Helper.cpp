@@ -1,57 +1,227 @@
 #include "stdafx.h"
 
 #include "Helper.h"
-#include <locale>
-#include <codecvt>
+#include "JsonBuffer.h"
+
+#include <thread>
+#include <exception>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define JSON4CPP_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+#define JSON4CPP_AVX2
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 using namespace std;
 using namespace std::filesystem;
 
 namespace Json4CPP::Detail
 {
-  wstring ReadAllText(path const& path)
+  string ReadAllBytes(path const& path)
   {
     if (auto is = ifstream(path, fstream::in | fstream::binary))
     {
-      stringstream ss;
-      ss << is.rdbuf();
-      return String2WString(ss.str());
+      // Read straight into the result if the size is known, otherwise in chunks
+      auto result = string();
+      if (auto size = is.seekg(0, ifstream::end).tellg(); size > 0 && is.seekg(0, ifstream::beg))
+      {
+        result.resize((size_t)size);
+        is.read(result.data(), result.size());
+        result.resize((size_t)is.gcount());
+      }
+      else
+      {
+        is.clear();
+        char chunk[64 * 1024];
+        while (is.read(chunk, sizeof(chunk)) || is.gcount())
+        {
+          result.append(chunk, (size_t)is.gcount());
+        }
+      }
+      return result;
     }
     auto message = "Could not open file: "s + path.string() + "!"s;
     throw exception(message.c_str());
   }
 
+  wstring ReadAllText(path const& path)
+  {
+    return String2WString(ReadAllBytes(path));
+  }
+
   void WriteAllText(path const& path, wstring const& value)
   {
-    wfstream(path, wfstream::out | wfstream::binary) << WidenString(WString2String(value));
+    auto bytes = WString2String(value);
+    ofstream(path, ofstream::out | ofstream::binary).write(bytes.data(), bytes.size());
+  }
+
+  // Returns the index of the lowest set bit, mask must not be 0.
+  static uint32_t CountTrailingZeros(uint32_t mask)
+  {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+  }
+
+  size_t ScanString(wchar_t const* value, size_t size, bool ascii)
+  {
+    using Unit = make_unsigned_t<wchar_t>;
+    constexpr auto narrow = sizeof(wchar_t) == 2;
+    // Unsigned comparisons are done as signed ones with the sign bit flipped on both sides.
+    // c - 0x7f < limit finds 0x7f-0x9f, or everything from 0x7f on with ascii.
+    constexpr auto sign = (Unit)((Unit)1 << (sizeof(wchar_t) * 8 - 1));
+    auto limit = ascii ? (Unit)(0 - 0x7F) : (Unit)0x21;
+    size_t i = 0;
+#ifdef JSON4CPP_AVX2
+    {
+      constexpr size_t step = 32 / sizeof(wchar_t);
+      auto set     = [](Unit c)                { if constexpr (narrow) return _mm256_set1_epi16((short)c); else return _mm256_set1_epi32((int)c); };
+      auto equal   = [](__m256i a, __m256i b) { if constexpr (narrow) return _mm256_cmpeq_epi16(a, b);   else return _mm256_cmpeq_epi32(a, b);   };
+      auto greater = [](__m256i a, __m256i b) { if constexpr (narrow) return _mm256_cmpgt_epi16(a, b);   else return _mm256_cmpgt_epi32(a, b);   };
+      auto minus   = [](__m256i a, __m256i b) { if constexpr (narrow) return _mm256_sub_epi16  (a, b);   else return _mm256_sub_epi32  (a, b);   };
+      auto flip = set(sign), quote = set(L'"'), backslash = set(L'\\'), space = set(sign ^ 0x20), del = set(0x7F), high = set(sign ^ limit);
+      for (; i + step <= size; i += step)
+      {
+        auto units = _mm256_loadu_si256((__m256i const*)(value + i));
+        auto special = _mm256_or_si256(
+          _mm256_or_si256(equal(units, quote), equal(units, backslash)),
+          _mm256_or_si256(greater(space, _mm256_xor_si256(units, flip)), greater(high, _mm256_xor_si256(minus(units, del), flip))));
+        if (auto mask = (uint32_t)_mm256_movemask_epi8(special))
+        {
+          return i + CountTrailingZeros(mask) / sizeof(wchar_t);
+        }
+      }
+    }
+#endif
+#ifdef JSON4CPP_SSE2
+    {
+      constexpr size_t step = 16 / sizeof(wchar_t);
+      auto set     = [](Unit c)                { if constexpr (narrow) return _mm_set1_epi16((short)c); else return _mm_set1_epi32((int)c); };
+      auto equal   = [](__m128i a, __m128i b) { if constexpr (narrow) return _mm_cmpeq_epi16(a, b);   else return _mm_cmpeq_epi32(a, b);   };
+      auto greater = [](__m128i a, __m128i b) { if constexpr (narrow) return _mm_cmpgt_epi16(a, b);   else return _mm_cmpgt_epi32(a, b);   };
+      auto minus   = [](__m128i a, __m128i b) { if constexpr (narrow) return _mm_sub_epi16  (a, b);   else return _mm_sub_epi32  (a, b);   };
+      auto flip = set(sign), quote = set(L'"'), backslash = set(L'\\'), space = set(sign ^ 0x20), del = set(0x7F), high = set(sign ^ limit);
+      for (; i + step <= size; i += step)
+      {
+        auto units = _mm_loadu_si128((__m128i const*)(value + i));
+        auto special = _mm_or_si128(
+          _mm_or_si128(equal(units, quote), equal(units, backslash)),
+          _mm_or_si128(greater(space, _mm_xor_si128(units, flip)), greater(high, _mm_xor_si128(minus(units, del), flip))));
+        if (auto mask = (uint32_t)_mm_movemask_epi8(special))
+        {
+          return i + CountTrailingZeros(mask) / sizeof(wchar_t);
+        }
+      }
+    }
+#endif
+    for (; i < size; ++i)
+    {
+      auto c = (Unit)value[i];
+      if (c == L'"' || c == L'\\' || c < 0x20 || (Unit)(c - 0x7F) < limit)
+      {
+        break;
+      }
+    }
+    return i;
+  }
+
+  size_t ScanString(char const* value, size_t size)
+  {
+    // Signed comparisons, so the bytes from 0x80 on are below 0x20 too
+    size_t i = 0;
+#ifdef JSON4CPP_AVX2
+    {
+      auto quote = _mm256_set1_epi8('"'), backslash = _mm256_set1_epi8('\\'), space = _mm256_set1_epi8(0x20), del = _mm256_set1_epi8(0x7F);
+      for (; i + 32 <= size; i += 32)
+      {
+        auto bytes = _mm256_loadu_si256((__m256i const*)(value + i));
+        auto special = _mm256_or_si256(
+          _mm256_or_si256(_mm256_cmpeq_epi8(bytes, quote), _mm256_cmpeq_epi8(bytes, backslash)),
+          _mm256_or_si256(_mm256_cmpgt_epi8(space, bytes), _mm256_cmpeq_epi8(bytes, del)));
+        if (auto mask = (uint32_t)_mm256_movemask_epi8(special))
+        {
+          return i + CountTrailingZeros(mask);
+        }
+      }
+    }
+#endif
+#ifdef JSON4CPP_SSE2
+    {
+      auto quote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\'), space = _mm_set1_epi8(0x20), del = _mm_set1_epi8(0x7F);
+      for (; i + 16 <= size; i += 16)
+      {
+        auto bytes = _mm_loadu_si128((__m128i const*)(value + i));
+        auto special = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)),
+          _mm_or_si128(_mm_cmplt_epi8(bytes, space), _mm_cmpeq_epi8(bytes, del)));
+        if (auto mask = (uint32_t)_mm_movemask_epi8(special))
+        {
+          return i + CountTrailingZeros(mask);
+        }
+      }
+    }
+#endif
+    for (; i < size; ++i)
+    {
+      auto c = (unsigned char)value[i];
+      if (c == '"' || c == '\\' || c < 0x20 || c >= 0x7F)
+      {
+        break;
+      }
+    }
+    return i;
   }
 
   wstring EscapeString(wstring const& value)
   {
-    wostringstream os;
-    for (auto& c : value)
+    // The runs between two characters to escape are appended at once
+    static constexpr wchar_t digits[] = L"0123456789abcdef";
+    auto result = wstring();
+    result.reserve(value.size());
+    auto end = value.data() + value.size();
+    for (auto current = value.data(); current != end; ++current)
     {
+      auto plain = ScanString(current, end - current);
+      result.append(current, plain);
+      current += plain;
+      if (current == end)
+      {
+        break;
+      }
+      auto c = *current;
       switch (c)
       {
-      case L'"' : os << L"\\\""s; break;
-      case L'\\': os << L"\\\\"s; break;
-      case L'\b': os << L"\\b"s ; break;
-      case L'\f': os << L"\\f"s ; break;
-      case L'\n': os << L"\\n"s ; break;
-      case L'\r': os << L"\\r"s ; break;
-      case L'\t': os << L"\\t"s ; break;
+      case L'"' : result += L"\\\""; break;
+      case L'\\': result += L"\\\\"; break;
+      case L'\b': result += L"\\b" ; break;
+      case L'\f': result += L"\\f" ; break;
+      case L'\n': result += L"\\n" ; break;
+      case L'\r': result += L"\\r" ; break;
+      case L'\t': result += L"\\t" ; break;
       default:
         if (L'\x00' <= c && c <= L'\x1f')
         {
-          os << L"\\u"s << hex << setw(4) << setfill(L'0') << (int)c;
+          result += L"\\u00";
+          result += digits[c >> 4];
+          result += digits[c & 0xF];
         }
         else
         {
-          os << c;
+          result += c;
         }
       }
     }
-    return os.str();
+    return result;
   }
 
   wstring WidenString(string const& value)
@@ -74,14 +244,274 @@ namespace Json4CPP::Detail
     return str;
   }
 
+  // Copies the leading ASCII characters of input into output, 32 or 16 at a time, returns the number of copied characters.
+  static size_t WidenAscii(char const* input, size_t size, wchar_t* output)
+  {
+    size_t i = 0;
+#ifdef JSON4CPP_AVX2
+    for (; i + 32 <= size; i += 32)
+    {
+      auto bytes = _mm256_loadu_si256((__m256i const*)(input + i));
+      if (_mm256_movemask_epi8(bytes))
+      {
+        break;
+      }
+      if constexpr (sizeof(wchar_t) == 2)
+      {
+        _mm256_storeu_si256((__m256i*)(output + i     ), _mm256_cvtepu8_epi16(_mm256_castsi256_si128   (bytes   )));
+        _mm256_storeu_si256((__m256i*)(output + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+      }
+      else
+      {
+        for (size_t j = 0; j < 32; j += 8)
+        {
+          _mm256_storeu_si256((__m256i*)(output + i + j), _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i const*)(input + i + j))));
+        }
+      }
+    }
+#endif
+#ifdef JSON4CPP_SSE2
+    auto zero = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16)
+    {
+      auto bytes = _mm_loadu_si128((__m128i const*)(input + i));
+      if (_mm_movemask_epi8(bytes))
+      {
+        break;
+      }
+      auto low  = _mm_unpacklo_epi8(bytes, zero);
+      auto high = _mm_unpackhi_epi8(bytes, zero);
+      if constexpr (sizeof(wchar_t) == 2)
+      {
+        _mm_storeu_si128((__m128i*)(output + i    ), low );
+        _mm_storeu_si128((__m128i*)(output + i + 8), high);
+      }
+      else
+      {
+        _mm_storeu_si128((__m128i*)(output + i     ), _mm_unpacklo_epi16(low , zero));
+        _mm_storeu_si128((__m128i*)(output + i +  4), _mm_unpackhi_epi16(low , zero));
+        _mm_storeu_si128((__m128i*)(output + i +  8), _mm_unpacklo_epi16(high, zero));
+        _mm_storeu_si128((__m128i*)(output + i + 12), _mm_unpackhi_epi16(high, zero));
+      }
+    }
+#endif
+    for (; i < size && (unsigned char)input[i] < 0x80; ++i)
+    {
+      output[i] = input[i];
+    }
+    return i;
+  }
+
+  // Copies the leading ASCII characters of input into output, 32 or 16 at a time, returns the number of copied characters.
+  static size_t NarrowAscii(wchar_t const* input, size_t size, char* output)
+  {
+    size_t i = 0;
+#ifdef JSON4CPP_AVX2
+    {
+      constexpr size_t step = 32 / sizeof(wchar_t);
+      auto mask = sizeof(wchar_t) == 2 ? _mm256_set1_epi16((short)0xFF80) : _mm256_set1_epi32((int)0xFFFFFF80);
+      for (; i + 32 <= size; i += 32)
+      {
+        __m256i units[32 / step];
+        auto any = _mm256_setzero_si256();
+        for (size_t j = 0; j < 32 / step; ++j)
+        {
+          units[j] = _mm256_loadu_si256((__m256i const*)(input + i + j * step));
+          any = _mm256_or_si256(any, units[j]);
+        }
+        if (!_mm256_testz_si256(any, mask))
+        {
+          break;
+        }
+        // The packs work on the 128-bit lanes separately, the permutations put the results back in order
+        if constexpr (sizeof(wchar_t) == 2)
+        {
+          auto bytes = _mm256_packus_epi16(units[0], units[1]);
+          _mm256_storeu_si256((__m256i*)(output + i), _mm256_permute4x64_epi64(bytes, 0xD8));
+        }
+        else
+        {
+          auto low  = _mm256_packs_epi32(units[0], units[1]);
+          auto high = _mm256_packs_epi32(units[2], units[3]);
+          auto bytes = _mm256_packus_epi16(low, high);
+          _mm256_storeu_si256((__m256i*)(output + i), _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)));
+        }
+      }
+    }
+#endif
+#ifdef JSON4CPP_SSE2
+    constexpr size_t step = 16 / sizeof(wchar_t);
+    auto zero = _mm_setzero_si128();
+    auto mask = sizeof(wchar_t) == 2 ? _mm_set1_epi16((short)0xFF80) : _mm_set1_epi32((int)0xFFFFFF80);
+    for (; i + 16 <= size; i += 16)
+    {
+      __m128i units[16 / step];
+      auto any = zero;
+      for (size_t j = 0; j < 16 / step; ++j)
+      {
+        units[j] = _mm_loadu_si128((__m128i const*)(input + i + j * step));
+        any = _mm_or_si128(any, units[j]);
+      }
+      if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(any, mask), zero)) != 0xFFFF)
+      {
+        break;
+      }
+      if constexpr (sizeof(wchar_t) == 2)
+      {
+        _mm_storeu_si128((__m128i*)(output + i), _mm_packus_epi16(units[0], units[1]));
+      }
+      else
+      {
+        auto low  = _mm_packs_epi32(units[0], units[1]);
+        auto high = _mm_packs_epi32(units[2], units[3]);
+        _mm_storeu_si128((__m128i*)(output + i), _mm_packus_epi16(low, high));
+      }
+    }
+#endif
+    for (; i < size && (make_unsigned_t<wchar_t>)input[i] < 0x80; ++i)
+    {
+      output[i] = (char)input[i];
+    }
+    return i;
+  }
+
   wstring String2WString(string const& string)
   {
-    return wstring_convert<codecvt_utf8_utf16<wchar_t>>().from_bytes(string);
+    // Every UTF-8 sequence is at least as long as the UTF-16 or UTF-32 encoding of the same code point
+    auto result = wstring(string.size(), L'\0');
+    auto input = string.data();
+    auto size = string.size();
+    auto output = result.data();
+    size_t i = 0;
+    while (i < size)
+    {
+      auto count = WidenAscii(input + i, size - i, output);
+      i += count;
+      output += count;
+      while (i < size && (unsigned char)input[i] >= 0x80)
+      {
+        char32_t codePoint;
+        auto length = DecodeUtf8(input + i, input + size, codePoint);
+        if (length == 0)
+        {
+          auto message = "Invalid UTF-8 sequence at byte "s + to_string(i) + "!"s;
+          throw exception(message.c_str());
+        }
+        i += length;
+        if (sizeof(wchar_t) == 2 && codePoint >= 0x10000)
+        {
+          codePoint -= 0x10000;
+          *output++ = (wchar_t)(0xD800 + (codePoint >> 10));
+          *output++ = (wchar_t)(0xDC00 + (codePoint & 0x3FF));
+        }
+        else
+        {
+          *output++ = (wchar_t)codePoint;
+        }
+      }
+    }
+    result.resize(output - result.data());
+    return result;
   }
 
   string WString2String(const wstring& string)
   {
-    return wstring_convert<codecvt_utf8_utf16<wchar_t>>().to_bytes(string);
+    // A UTF-16 code unit takes at most 3 bytes, a surrogate pair 4 bytes, a UTF-32 code unit 4 bytes
+    auto result = std::string(string.size() * (sizeof(wchar_t) == 2 ? 3 : 4), '\0');
+    auto input = string.data();
+    auto size = string.size();
+    auto output = result.data();
+    size_t i = 0;
+    while (i < size)
+    {
+      auto count = NarrowAscii(input + i, size - i, output);
+      i += count;
+      output += count;
+      while (i < size && (make_unsigned_t<wchar_t>)input[i] >= 0x80)
+      {
+        auto codePoint = (char32_t)(make_unsigned_t<wchar_t>)input[i++];
+        if (0xD800 <= codePoint && codePoint <= 0xDBFF && sizeof(wchar_t) == 2 && i < size && 0xDC00 <= input[i] && input[i] <= 0xDFFF)
+        {
+          codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (input[i++] - 0xDC00);
+        }
+        else if ((0xD800 <= codePoint && codePoint <= 0xDFFF) || codePoint > 0x10FFFF)
+        {
+          auto message = "Invalid UTF-16 sequence at index "s + to_string(i - 1) + "!"s;
+          throw exception(message.c_str());
+        }
+        if (codePoint < 0x800)
+        {
+          *output++ = (char)(0xC0 | codePoint >> 6);
+        }
+        else if (codePoint < 0x10000)
+        {
+          *output++ = (char)(0xE0 | codePoint >> 12);
+          *output++ = (char)(0x80 | (codePoint >> 6 & 0x3F));
+        }
+        else
+        {
+          *output++ = (char)(0xF0 | codePoint >> 18);
+          *output++ = (char)(0x80 | (codePoint >> 12 & 0x3F));
+          *output++ = (char)(0x80 | (codePoint >> 6 & 0x3F));
+        }
+        *output++ = (char)(0x80 | (codePoint & 0x3F));
+      }
+    }
+    result.resize(output - result.data());
+    return result;
+  }
+
+  void ParallelFor(size_t count, function<void(size_t)> const& function)
+  {
+    auto errors = vector<exception_ptr>(count);
+    auto call = [&](size_t index)
+    {
+      try
+      {
+        function(index);
+      }
+      catch (...)
+      {
+        errors[index] = current_exception();
+      }
+    };
+    auto threads = vector<thread>();
+    for (size_t index = 1; index < count; ++index)
+    {
+      try
+      {
+        threads.emplace_back(call, index);
+      }
+      catch (system_error const&)
+      {
+        call(index);
+      }
+    }
+    if (count)
+    {
+      call(0);
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    for (auto& error : errors)
+    {
+      if (error)
+      {
+        rethrow_exception(error);
+      }
+    }
+  }
+
+  bool IsSynchronized(pmr::memory_resource* resource)
+  {
+    return resource == pmr::new_delete_resource() || dynamic_cast<pmr::synchronized_pool_resource*>(resource);
+  }
+
+  uint64_t CombineHash(uint64_t seed, uint64_t value)
+  {
+    return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 12) + (seed >> 4));
   }
 
   pair<uint64_t, uint64_t> GetStreamPosition(wistream& is, wistream::pos_type pos)
@@ -94,7 +524,8 @@ namespace Json4CPP::Detail
     auto carriageReturn = false;
     while (is.tellg() != pos)
     {
-      if (carriageReturn && is.get() == L'\n')
+      auto c = is.get();
+      if (carriageReturn && c == L'\n')
       {
         carriageReturn = false;
         column = 0;
@@ -102,7 +533,7 @@ namespace Json4CPP::Detail
       }
       else
       {
-        carriageReturn = is.get() == L'\r';
+        carriageReturn = c == L'\r';
         column++;
       }
     }
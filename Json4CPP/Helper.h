@@ -9,6 +9,8 @@
 #include <string>
 #include <istream>
 #include <filesystem>
+#include <functional>
+#include <memory_resource>
 
 namespace Json4CPP::Detail
 {
@@ -23,6 +25,9 @@ namespace Json4CPP::Detail
   template<typename ...Args>
   Overload(Args...)->Overload<Args...>;
 
+  // Reads the file into string as it is, without any conversion.
+  JSON_API std::string  ReadAllBytes(std::filesystem::path const& path);
+
   // Reads UTF-8 without BOM encoded file into UTF-16 encoded wstring.
   JSON_API std::wstring ReadAllText (std::filesystem::path const& path);
 
@@ -32,18 +37,39 @@ namespace Json4CPP::Detail
   // Escapes ", \, \b, \f, \n, \r, \t characters and any other character between 0x00 and 0x1f.
   JSON_API std::wstring EscapeString  (std::wstring const& value);
 
+  // Returns the length of the leading run of characters which are copied between JSON text and a string as they are:
+  // anything but ", \ and the control characters 0x00-0x1f and 0x7f-0x9f, or if ascii is true, anything but ", \ and non-printable ASCII.
+  // Scans 16 bytes at a time with SSE2, or 32 bytes with AVX2.
+  JSON_API size_t       ScanString    (wchar_t const* value, size_t size, bool ascii = false);
+
+  // Same for UTF-8, where only printable ASCII is copied as it is, everything above 0x7e has to be decoded.
+  JSON_API size_t       ScanString    (char    const* value, size_t size);
+
   // Widens the string character by character, for example: 'a' (0x61) -> L'a' (0x0061) or (char)-100 -> (wchar_t)156.
   JSON_API std::wstring WidenString   (std::string  const& value);
 
   // Narrows the wstring character by character, for example: L'a' (0x0061) -> 'a' (0x61) or (wchar_t)156 -> (char)-100.
   JSON_API std::string  NarrowWString (std::wstring const& value);
 
-  // Converts UTF-8 encoded string into UTF-16 encoded wstring.
+  // Converts UTF-8 encoded string into UTF-16 (or UTF-32 where wchar_t is 4 bytes) encoded wstring.
+  // Throws on invalid UTF-8, the same sequences are rejected as by JsonLinter. ASCII is converted 16 characters at a time with SSE2.
   JSON_API std::wstring String2WString(std::string  const& string);
 
-  // Converts UTF-16 encoded wstring into UTF-8 encoded string.
+  // Converts UTF-16 (or UTF-32 where wchar_t is 4 bytes) encoded wstring into UTF-8 encoded string.
+  // Throws on unpaired surrogates. ASCII is converted 16 characters at a time with SSE2.
   JSON_API std::string  WString2String(std::wstring const& string);
 
+  // Calls function with every index from 0 to count - 1, each on a separate thread, 0 on the calling one, and waits for all of them.
+  // If no more threads can be started, the rest are called on the calling thread. Rethrows the exception of the lowest index which threw.
+  JSON_API void         ParallelFor   (size_t count, std::function<void(size_t)> const& function);
+
+  // Returns whether resource can be used by more threads at the same time, which is the case for
+  // std::pmr::new_delete_resource and std::pmr::synchronized_pool_resource.
+  JSON_API bool         IsSynchronized(std::pmr::memory_resource* resource);
+
+  // Mixes value into seed, the order of the values matters.
+  JSON_API uint64_t     CombineHash   (uint64_t seed, uint64_t value);
+
   // Returns the { line, column } pair of the specified position in the stream.
   // Line endings are handled as \r\n.
   JSON_API std::pair<uint64_t, uint64_t> GetStreamPosition(std::wistream& is, std::wistream::pos_type pos);
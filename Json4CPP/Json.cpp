@@ -5,6 +5,8 @@
 #include "JsonBuilder.h"
 #include "Value.h"
 #include "Helper.h"
+#include "JsonFileMapping.h"
+#include "JsonPatch.h"
 
 #include <sstream>
 #include <iostream>
@@ -19,7 +21,7 @@ namespace Json4CPP
 {
   Json operator""_json(const wchar_t* value, size_t size)
   {
-    return Json::Read(JsonLinter::Read(value));
+    return Json::Parse(wstring_view(value, size));
   }
 
   Json Json::Read(deque<TOKEN>& tokens)
@@ -35,6 +37,27 @@ namespace Json4CPP
     }
   }
 
+  void Json::CheckRoot(Json const& json)
+  {
+    // Only JsonObject and JsonArray are valid at the root, report anything else the same way as Read(deque<TOKEN>& tokens) does
+    auto token = JsonTokenType::Undefined;
+    auto value = VALUE_TOKEN();
+    visit(Overload{
+      [&](nullptr_t  const& arg) { token = JsonTokenType::Null   ; value = arg; },
+      [&](wstring    const& arg) { token = JsonTokenType::String ; value = arg; },
+      [&](bool       const& arg) { token = JsonTokenType::Boolean; value = arg; },
+      [&](double     const& arg) { token = JsonTokenType::Real   ; value = arg; },
+      [&](int64_t    const& arg) { token = JsonTokenType::Integer; value = arg; },
+      [&](JsonObject const& arg) { },
+      [&](JsonArray  const& arg) { },
+    }, json._value);
+    if (token != JsonTokenType::Undefined)
+    {
+      auto message = WString2String(L"Invalid token: "s + Json::Stringify(token) + L", with invalid data: "s + JsonLinter::Dump(value) + L"!"s);
+      throw exception(message.c_str());
+    }
+  }
+
   deque<TOKEN>& Json::Write(Json const& json, deque<TOKEN>& tokens)
   {
     switch (Value::GetType(json._value))
@@ -64,19 +87,19 @@ namespace Json4CPP
     {
     case JsonBuilderType::Empty :
     case JsonBuilderType::Object:
-      _value = JsonObject(value);
+      _value = JsonObject(move(value));
       break;
     case JsonBuilderType::Pair  :
     case JsonBuilderType::Array :
-      _value = JsonArray (value);
+      _value = JsonArray (move(value));
       break;
     default:
       visit(Overload{
-        [&](nullptr_t const& arg) { _value = arg; },
-        [&](wstring   const& arg) { _value = arg; },
-        [&](bool      const& arg) { _value = arg; },
-        [&](double    const& arg) { _value = arg; },
-        [&](int64_t   const& arg) { _value = arg; },
+        [&](nullptr_t const& arg) { _value =      arg ; },
+        [&](wstring        & arg) { _value = move(arg); },
+        [&](bool      const& arg) { _value =      arg ; },
+        [&](double    const& arg) { _value =      arg ; },
+        [&](int64_t   const& arg) { _value =      arg ; },
         [&](auto const& arg)
         {
           throw exception("Should not be possible!");
@@ -96,9 +119,43 @@ namespace Json4CPP
     _value = json._value;
   }
 
+  Json::Json(Json&& json) noexcept : _value(move(json._value))
+  {
+
+  }
+
+  Json::Json(pmr::memory_resource* resource, Json const& json)
+  {
+    visit(Overload{
+      [&](JsonObject const& value) { _value.emplace<JsonObject>(resource) = value; },
+      [&](JsonArray  const& value) { _value.emplace<JsonArray >(resource) = value; },
+      [&](auto       const& value) { _value = value; },
+    }, json._value);
+  }
+
+  // Within the same resource, so the vectors of a parsed document can grow without copying their elements out of it
+  Json::Json(pmr::memory_resource* resource, Json&& json)
+  {
+    visit(Overload{
+      [&](JsonObject& value) { value._resource == resource ? _value.emplace<JsonObject>(move(value)) : _value.emplace<JsonObject>(resource) = move(value); },
+      [&](JsonArray & value) { value._resource == resource ? _value.emplace<JsonArray >(move(value)) : _value.emplace<JsonArray >(resource) = move(value); },
+      [&](auto      & value) { _value = move(value); },
+    }, json._value);
+  }
+
+  Json::Json(allocator_arg_t, allocator_type const& allocator, Json const& json) : Json(allocator.resource(), json)
+  {
+
+  }
+
+  Json::Json(allocator_arg_t, allocator_type const& allocator, Json&& json) : Json(allocator.resource(), move(json))
+  {
+
+  }
+
   Json::Json(nullptr_t      value) { _value =         value;  }
   Json::Json(const wchar_t* value) { _value = wstring(value); }
-  Json::Json(wstring        value) { _value =         value;  }
+  Json::Json(wstring        value) { _value = move   (value);  }
   Json::Json(bool           value) { _value =         value;  }
   Json::Json(char           value) { _value = int64_t(value); }
   Json::Json(int8_t         value) { _value = int64_t(value); }
@@ -111,8 +168,8 @@ namespace Json4CPP
   Json::Json(uint64_t       value) { _value = int64_t(value); }
   Json::Json(float          value) { _value = double (value); }
   Json::Json(double         value) { _value =         value;  }
-  Json::Json(JsonObject     value) { _value =         value;  }
-  Json::Json(JsonArray      value) { _value =         value;  }
+  Json::Json(JsonObject     value) { _value = move   (value);  }
+  Json::Json(JsonArray      value) { _value = move   (value);  }
 
   JsonType Json::Type() const
   {
@@ -124,21 +181,103 @@ namespace Json4CPP
     return Type() == type;
   }
 
+  uint64_t Json::Hash() const
+  {
+    return Value::Hash(_value);
+  }
+
   wstring Json::Dump(uint8_t indentation) const
   {
-    wstringstream os;
-    JsonLinter::Write(os, Json::Write(*this, deque<TOKEN>()), indentation);
-    return os.str();
+    return JsonWriter::Dump(*this, indentation);
   }
 
   Json Json::Read(path filePath)
   {
-    return Json::Read(JsonLinter::Read(ReadAllText(filePath)));
+    return Json::Read(filePath, pmr::get_default_resource());
+  }
+
+  Json Json::Parse(wstring_view value)
+  {
+    return Json::Parse(value, pmr::get_default_resource());
+  }
+
+  Json Json::Parse(string_view value)
+  {
+    return Json::Parse(value, pmr::get_default_resource());
+  }
+
+  Json Json::Read(path filePath, pmr::memory_resource* resource)
+  {
+    // Regular files are parsed in place, anything else is read in chunks through a JsonStreamBuffer
+    if (auto file = JsonFileMapping(filePath); file.IsMapped())
+    {
+      return Json::Parse(file.Data(), resource);
+    }
+    if (auto is = ifstream(filePath, ifstream::in | ifstream::binary))
+    {
+      auto json = Json();
+      auto handler = JsonDomHandler(json, resource);
+      JsonLinter::Read(is, handler);
+      CheckRoot(json);
+      return json;
+    }
+    auto message = "Could not open file: "s + filePath.string() + "!"s;
+    throw exception(message.c_str());
+  }
+
+  template<typename Char>
+  Json Json::ParseText(basic_string_view<Char> value, pmr::memory_resource* resource)
+  {
+    // The parts are built on separate threads, so only resources which can be used by more of them at the same time are allowed
+    auto threads = min((size_t)JsonDefault::Threads, value.size() / JsonLinter::ParallelPartSize);
+    if (threads > 1 && IsSynchronized(resource))
+    {
+      auto parts = vector<Json>(threads);
+      auto handlers = vector<JsonDomHandler>();
+      auto pointers = vector<JsonHandler*>();
+      handlers.reserve(threads);
+      for (auto& part : parts)
+      {
+        pointers.push_back(&handlers.emplace_back(part, resource));
+      }
+      if (JsonLinter::ReadParallel(value, pointers))
+      {
+        auto& values = get<JsonArray>(parts[0]._value).Detach().values;
+        auto size = values.size();
+        for (size_t i = 1; i < parts.size(); ++i)
+        {
+          size += get<JsonArray>(parts[i]._value).Size();
+        }
+        values.reserve(size);
+        for (size_t i = 1; i < parts.size(); ++i)
+        {
+          auto& part = get<JsonArray>(parts[i]._value).Detach().values;
+          values.insert(values.end(), make_move_iterator(part.begin()), make_move_iterator(part.end()));
+        }
+        return move(parts[0]);
+      }
+    }
+    auto json = Json();
+    auto handler = JsonDomHandler(json, resource);
+    JsonLinter::Read(value, handler);
+    CheckRoot(json);
+    return json;
+  }
+
+  Json Json::Parse(wstring_view value, pmr::memory_resource* resource)
+  {
+    return ParseText(value, resource);
+  }
+
+  Json Json::Parse(string_view value, pmr::memory_resource* resource)
+  {
+    return ParseText(value, resource);
   }
 
   void Json::Write(path filePath) const
   {
-    WriteAllText(filePath, Dump(JsonDefault::Indentation));
+    auto os = ofstream(filePath, ofstream::out | ofstream::binary);
+    JsonWriter::Write(os, *this, JsonDefault::Indentation);
   }
 
   int64_t Json::Size() const
@@ -175,7 +314,7 @@ namespace Json4CPP
     switch (Type())
     {
     case JsonType::Null: _value = JsonArray(); [[fallthrough]];
-    case JsonType::Array: get<JsonArray>(_value).PushBack(value); break;
+    case JsonType::Array: get<JsonArray>(_value).PushBack(move(value)); break;
     default: throw exception("PushBack(Json value) is only defined for JsonArray!");
     }
   }
@@ -185,7 +324,7 @@ namespace Json4CPP
     switch (Type())
     {
     case JsonType::Null  : _value = JsonObject(); [[fallthrough]];
-    case JsonType::Object: return get<JsonObject>(_value).Insert(pair);
+    case JsonType::Object: return get<JsonObject>(_value).Insert(move(pair));
     default: throw exception("Insert(pair<KEY, Json> pair) is only defined for JsonObject!");
     }
   }
@@ -195,7 +334,7 @@ namespace Json4CPP
     switch (Type())
     {
     case JsonType::Null  : _value = JsonArray(); [[fallthrough]];
-    case JsonType::Array: return get<JsonArray>(_value).Insert(index, value);
+    case JsonType::Array: return get<JsonArray>(_value).Insert(index, move(value));
     default: throw exception("Insert(Json value, int64_t index) is only defined for JsonArray!");
     }
   }
@@ -246,7 +385,7 @@ namespace Json4CPP
     }
   }
 
-  Json Json::At(KEY const& key) const
+  Json const& Json::At(KEY const& key) const
   {
     switch (Type())
     {
@@ -264,7 +403,7 @@ namespace Json4CPP
     }
   }
 
-  Json Json::At(int64_t const& index) const
+  Json const& Json::At(int64_t const& index) const
   {
     switch (Type())
     {
@@ -282,6 +421,45 @@ namespace Json4CPP
     }
   }
 
+  Json const* Json::Find(KEY const& key) const
+  {
+    auto object = get_if<JsonObject>(&_value);
+    return object ? object->Find(key) : nullptr;
+  }
+
+  Json* Json::Find(KEY const& key)
+  {
+    auto object = get_if<JsonObject>(&_value);
+    return object ? object->Find(key) : nullptr;
+  }
+
+  Json const* Json::Find(int64_t const& index) const
+  {
+    auto array = get_if<JsonArray>(&_value);
+    return array ? array->Find(index) : nullptr;
+  }
+
+  Json* Json::Find(int64_t const& index)
+  {
+    auto array = get_if<JsonArray>(&_value);
+    return array ? array->Find(index) : nullptr;
+  }
+
+  Json Json::Diff(Json const& target) const
+  {
+    return JsonPatch::Diff(*this, target);
+  }
+
+  void Json::Apply(Json const& patch)
+  {
+    JsonPatch::Apply(*this, patch);
+  }
+
+  void Json::Merge(Json const& patch)
+  {
+    JsonPatch::Merge(*this, patch);
+  }
+
 #pragma region Conversion operators
 #pragma warning(push)
 #pragma warning(disable : 4244)
@@ -442,12 +620,40 @@ namespace Json4CPP
     default: throw exception("Invalid conversion!");
     }
   }
+
+  Json::operator JsonObjectView() const
+  {
+    switch (Type())
+    {
+    case JsonType::Object: return Get<JsonObject>();
+    default: throw exception("Invalid conversion!");
+    }
+  }
+
+  Json::operator JsonArrayView() const
+  {
+    switch (Type())
+    {
+    case JsonType::Array: return Get<JsonArray>();
+    default: throw exception("Invalid conversion!");
+    }
+  }
 #pragma warning(pop)
 #pragma endregion
 
+  // Moves value into target, see Json::operator=.
+  static void Assign(VALUE& target, VALUE&& value)
+  {
+    visit(Overload{
+      [&](JsonObject& object) { (holds_alternative<JsonObject>(target) ? get<JsonObject>(target) : target.emplace<JsonObject>()) = move(object); },
+      [&](JsonArray & array ) { (holds_alternative<JsonArray >(target) ? get<JsonArray >(target) : target.emplace<JsonArray >()) = move(array ); },
+      [&](auto      & other ) { target = move(other); },
+    }, value);
+  }
+
   Json& Json::operator=(nullptr_t                     value ) { _value =         value;          return *this; }
   Json& Json::operator=(const wchar_t*                value ) { _value = wstring(value);         return *this; }
-  Json& Json::operator=(wstring                       value ) { _value =         value;          return *this; }
+  Json& Json::operator=(wstring                       value ) { _value = move   (value);         return *this; }
   Json& Json::operator=(bool                          value ) { _value =         value;          return *this; }
   Json& Json::operator=(char                          value ) { _value = int64_t(value);         return *this; }
   Json& Json::operator=(int8_t                        value ) { _value = int64_t(value);         return *this; }
@@ -460,20 +666,39 @@ namespace Json4CPP
   Json& Json::operator=(uint64_t                      value ) { _value = int64_t(value);         return *this; }
   Json& Json::operator=(float                         value ) { _value = double (value);         return *this; }
   Json& Json::operator=(double                        value ) { _value =         value;          return *this; }
-  Json& Json::operator=(Json                          value ) { _value =         value._value;   return *this; }
-  Json& Json::operator=(JsonObject                    value ) { _value =         value;          return *this; }
-  Json& Json::operator=(JsonArray                     value ) { _value =         value;          return *this; }
-  Json& Json::operator=(JsonBuilder                   value ) { _value = Json   (value )._value; return *this; }
+  Json& Json::operator=(Json                          value ) { Assign(_value, move(value._value));  return *this; }
+  Json& Json::operator=(JsonObject                    value ) { Assign(_value, move(value));         return *this; }
+  Json& Json::operator=(JsonArray                     value ) { Assign(_value, move(value));         return *this; }
+  Json& Json::operator=(JsonBuilder                   value ) { _value = Json   (move(value))._value; return *this; }
   Json& Json::operator=(initializer_list<JsonBuilder> values) { _value = Json   (values)._value; return *this; }
 
   wostream& operator<<(wostream& os, Json const& json)
   {
-    return JsonLinter::Write(os, Json::Write(json, deque<TOKEN>()), JsonDefault::Indentation);
+    return JsonWriter::Write(os, json, JsonDefault::Indentation);
   }
 
   wistream& operator>>(wistream&is, Json& json)
   {
-    json = Json::Read(JsonLinter::Read(is));
+    auto result = Json();
+    auto handler = JsonDomHandler(result);
+    JsonLinter::Read(is, handler);
+    Json::CheckRoot(result);
+    json = move(result);
+    return is;
+  }
+
+  ostream& operator<<(ostream& os, Json const& json)
+  {
+    return JsonWriter::Write(os, json, JsonDefault::Indentation);
+  }
+
+  istream& operator>>(istream& is, Json& json)
+  {
+    auto result = Json();
+    auto handler = JsonDomHandler(result);
+    JsonLinter::Read(is, handler);
+    Json::CheckRoot(result);
+    json = move(result);
     return is;
   }
 
@@ -10,17 +10,23 @@
 #include "Value.h"
 #include "JsonArray.h"
 #include "JsonObject.h"
+#include "JsonObjectView.h"
+#include "JsonArrayView.h"
 #include "JsonLinter.h"
 #include "JsonTokenType.h"
+#include "JsonDomHandler.h"
+#include "JsonWriter.h"
 
 #include <variant>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <utility>
 #include <initializer_list>
 #include <iostream>
 #include <sstream>
 #include <filesystem>
+#include <memory_resource>
 
 namespace Json4CPP
 {
@@ -31,9 +37,16 @@ namespace Json4CPP
   namespace Detail
   {
     class JSON_API JsonBuilder;
+    class JSON_API JsonDomHandler;
+    class JSON_API JsonWriter;
+    class JSON_API JsonPatch;
   }
   class JSON_API JsonObject;
   class JSON_API JsonArray;
+  class JSON_API JsonObjectView;
+  class JSON_API JsonArrayView;
+  class JSON_API JsonPointer;
+  class JSON_API JsonPath;
 
   JSON_API Json operator""_json(const wchar_t* value, std::size_t size);
 
@@ -44,16 +57,42 @@ namespace Json4CPP
     friend class JsonObject;
     friend class JsonArray;
     friend class Detail::JsonBuilder;
+    friend class Detail::JsonDomHandler;
+    friend class Detail::JsonWriter;
+    friend class Detail::JsonPatch;
+    friend class JsonPointer;
+    friend class JsonPath;
 #pragma warning(suppress: 4251)
     Detail::VALUE _value;
 
     static Json                       Read (                  std::deque<Detail::TOKEN>& tokens);
     static std::deque<Detail::TOKEN>& Write(Json const& json, std::deque<Detail::TOKEN>& tokens);
+    static void                       CheckRoot(Json const& json);
+    // Parses in parts on JsonDefault::Threads threads, if the text is long enough and its root is an array
+    template<typename Char>
+    static Json                       ParseText(std::basic_string_view<Char> value, std::pmr::memory_resource* resource);
+    // Copies or moves json, with its JsonObject or JsonArray value allocated from resource, see allocator_type.
+    Json(std::pmr::memory_resource* resource, Json const& json);
+    Json(std::pmr::memory_resource* resource, Json     && json);
   public:
+    // The Json values in the vectors of a JsonObject or JsonArray are constructed with the memory resource of those, which their
+    // JsonObject and JsonArray values are allocated from. The ones using another resource are copied into it, so a value moved
+    // out of a document parsed into an arena stays valid after the arena is released.
+    using allocator_type = std::pmr::polymorphic_allocator<Json>;
+
     Json();
     Json(Detail::JsonBuilder value);
     Json(std::initializer_list<Detail::JsonBuilder> values);
     Json(Json const& json);
+    // Moves keep the memory resource of the JsonObject and JsonArray values, as the moves of the std::pmr containers do
+    Json(Json&& json) noexcept;
+    template<typename... Args, typename = std::enable_if_t<!(sizeof...(Args) == 1 && (std::is_same_v<std::decay_t<Args>, Json> && ...))>>
+    Json(std::allocator_arg_t, allocator_type const& allocator, Args&&... args) : Json(allocator.resource(), Json(std::forward<Args>(args)...))
+    {
+
+    }
+    Json(std::allocator_arg_t, allocator_type const& allocator, Json const& json);
+    Json(std::allocator_arg_t, allocator_type const& allocator, Json     && json);
 
     Json(std::nullptr_t value);
     Json(const wchar_t* value);
@@ -75,10 +114,20 @@ namespace Json4CPP
 
     JsonType Type() const;
     bool Is(JsonType type) const;
+    // Hash consistent with operator==, the hashes of JsonObject and JsonArray values are cached, see JsonObject::Hash.
+    uint64_t Hash() const;
 
     std::wstring Dump(uint8_t indentation = 0) const;
 
     static Json Read(std::filesystem::path filePath);
+    // Parses UTF-16 or UTF-8 encoded text, building the Json directly without collecting tokens first.
+    static Json Parse(std::wstring_view value);
+    static Json Parse(std::string_view  value);
+    // Every JsonObject and JsonArray of the result is allocated from resource (for example an std::pmr::monotonic_buffer_resource),
+    // which has to outlive it. Strings longer than the small string buffer are still allocated separately.
+    static Json Read (std::filesystem::path filePath, std::pmr::memory_resource* resource);
+    static Json Parse(std::wstring_view     value   , std::pmr::memory_resource* resource);
+    static Json Parse(std::string_view      value   , std::pmr::memory_resource* resource);
     void Write(std::filesystem::path filePath) const;
 
     template<typename T>
@@ -125,10 +174,21 @@ namespace Json4CPP
     std::vector<KEY> Keys() const;
     Json& operator[](KEY const& key);
     Json& operator[](int64_t const& index);
-    Json  At(KEY     const& key  ) const;
-    Json& At(KEY     const& key  );
-    Json  At(int64_t const& index) const;
-    Json& At(int64_t const& index);
+    Json const& At(KEY     const& key  ) const;
+    Json      & At(KEY     const& key  );
+    Json const& At(int64_t const& index) const;
+    Json      & At(int64_t const& index);
+    // Like At, but returns nullptr instead of throwing if the key or index is not present, or if the Json is not a JsonObject or JsonArray.
+    Json const* Find(KEY     const& key  ) const;
+    Json      * Find(KEY     const& key  );
+    Json const* Find(int64_t const& index) const;
+    Json      * Find(int64_t const& index);
+    // Returns the RFC 6902 JSON Patch which turns this Json into target, see Detail::JsonPatch::Diff.
+    Json Diff(Json const& target) const;
+    // Applies an RFC 6902 JSON Patch. Either every operation of it is applied, or none of them and an exception is thrown.
+    void Apply(Json const& patch);
+    // Applies an RFC 7396 JSON Merge Patch.
+    void Merge(Json const& patch);
 
     explicit operator std::nullptr_t () const;
     explicit operator std::wstring   () const;
@@ -146,6 +206,9 @@ namespace Json4CPP
     explicit operator double         () const;
     explicit operator JsonObject     () const;
     explicit operator JsonArray      () const;
+    // Views of the stored JsonObject or JsonArray, which do not copy it.
+    explicit operator JsonObjectView () const;
+    explicit operator JsonArrayView  () const;
 
     Json& operator= (std::nullptr_t      value);
     Json& operator= (const wchar_t*      value);
@@ -162,6 +225,8 @@ namespace Json4CPP
     Json& operator= (uint64_t            value);
     Json& operator= (float               value);
     Json& operator= (double              value);
+    // The JsonObject and JsonArray values are moved into the ones already stored, which keep their memory resource,
+    // or into new ones using the default resource. The ones allocated from another resource are copied.
     Json& operator= (Json                value);
     Json& operator= (JsonObject          value);
     Json& operator= (JsonArray           value);
@@ -178,6 +243,9 @@ namespace Json4CPP
 
     JSON_API friend std::wostream& operator<<(std::wostream& os, Json const& json);
     JSON_API friend std::wistream& operator>>(std::wistream& is, Json      & json);
+    // UTF-8 encoded text
+    JSON_API friend std::ostream & operator<<(std::ostream & os, Json const& json);
+    JSON_API friend std::istream & operator>>(std::istream & is, Json      & json);
 
     JSON_API friend bool   operator==(Json const& left, Json const& right);
     JSON_API friend bool   operator!=(Json const& left, Json const& right);
@@ -204,4 +272,16 @@ namespace Json4CPP
     JSON_API friend bool   operator&&(Json const& left, Json const& right);
     JSON_API friend bool   operator||(Json const& left, Json const& right);
   };
+}
+
+namespace std
+{
+  template<>
+  struct hash<Json4CPP::Json>
+  {
+    size_t operator()(Json4CPP::Json const& json) const
+    {
+      return (size_t)json.Hash();
+    }
+  };
 }
\ No newline at end of file
@@ -4,10 +4,25 @@
 #include "Json.h"
 #include "JsonArray.h"
 #include "JsonObject.h"
+#include "JsonArrayView.h"
+#include "JsonObjectView.h"
 #include "JsonBuilder.h"
 #include "JsonBuilderType.h"
 #include "JsonDefault.h"
+#include "JsonBackend.h"
 #include "JsonType.h"
 #include "JsonTokenType.h"
 #include "JsonLinter.h"
+#include "JsonStructuralIndex.h"
+#include "JsonHandler.h"
+#include "JsonReader.h"
+#include "JsonPushParser.h"
+#include "JsonWriter.h"
+#include "JsonFileMapping.h"
+#include "JsonLazy.h"
+#include "JsonLinesReader.h"
+#include "JsonLinesWriter.h"
+#include "JsonPointer.h"
+#include "JsonPath.h"
+#include "JsonPatch.h"
 #include "Value.h"
\ No newline at end of file
@@ -11,6 +11,49 @@ using namespace Json4CPP::Detail;
 
 namespace Json4CPP
 {
+  JsonArray::Data::Data(pmr::memory_resource* resource) : values(resource)
+  {
+
+  }
+
+  JsonArray::Data::Data(Data const& data, pmr::memory_resource* resource) : values(data.values, resource)
+  {
+
+  }
+
+  JsonArray::Data const& JsonArray::Contents() const
+  {
+    static auto const empty = Data(pmr::new_delete_resource());
+    return _data ? *_data : empty;
+  }
+
+  JsonArray::Data& JsonArray::Detach()
+  {
+    if (!_data)
+    {
+      _data = allocate_shared<Data>(pmr::polymorphic_allocator<Data>(_resource), _resource);
+    }
+    else if (_data.use_count() > 1)
+    {
+      _data = allocate_shared<Data>(pmr::polymorphic_allocator<Data>(_resource), *_data, _resource);
+    }
+    else
+    {
+      // Pairs with the release of the last other copy, so its reads of the values happen before the writes of this one
+      atomic_thread_fence(memory_order_acquire);
+    }
+    _hash.store(0, memory_order_relaxed);
+    _data->referenced = false;
+    return *_data;
+  }
+
+  JsonArray::Data& JsonArray::Reference()
+  {
+    auto& data = Detach();
+    data.referenced = true;
+    return data;
+  }
+
   JsonArray JsonArray::Read(deque<TOKEN>& tokens)
   {
     if (tokens.empty())
@@ -36,13 +79,13 @@ namespace Json4CPP
       tie(token, value) = tokens.front();
       switch (token)
       {
-      case JsonTokenType::Null       : array._values.push_back(Json(get<nullptr_t>(value))); tokens.pop_front(); break;
-      case JsonTokenType::String     : array._values.push_back(Json(get<wstring  >(value))); tokens.pop_front(); break;
-      case JsonTokenType::Boolean    : array._values.push_back(Json(get<bool     >(value))); tokens.pop_front(); break;
-      case JsonTokenType::Real       : array._values.push_back(Json(get<double   >(value))); tokens.pop_front(); break;
-      case JsonTokenType::Integer    : array._values.push_back(Json(get<int64_t  >(value))); tokens.pop_front(); break;
-      case JsonTokenType::StartObject: array._values.push_back(JsonObject::Read   (tokens));                     break;
-      case JsonTokenType::StartArray : array._values.push_back(JsonArray ::Read   (tokens));                     break;
+      case JsonTokenType::Null       : array.Detach().values.push_back(Json(get<nullptr_t>(value))); tokens.pop_front(); break;
+      case JsonTokenType::String     : array.Detach().values.push_back(Json(get<wstring  >(value))); tokens.pop_front(); break;
+      case JsonTokenType::Boolean    : array.Detach().values.push_back(Json(get<bool     >(value))); tokens.pop_front(); break;
+      case JsonTokenType::Real       : array.Detach().values.push_back(Json(get<double   >(value))); tokens.pop_front(); break;
+      case JsonTokenType::Integer    : array.Detach().values.push_back(Json(get<int64_t  >(value))); tokens.pop_front(); break;
+      case JsonTokenType::StartObject: array.Detach().values.push_back(JsonObject::Read   (tokens));                     break;
+      case JsonTokenType::StartArray : array.Detach().values.push_back(JsonArray ::Read   (tokens));                     break;
       case JsonTokenType::EndArray   : tokens.pop_front(); return array;
       default:
       {
@@ -70,13 +113,15 @@ namespace Json4CPP
   {
     if (auto array = get_if<JsonArray>(&builder._value))
     {
-      *this = *array;
+      *this = move(*array);
     }
     else if (auto builders = get_if<vector<JsonBuilder>>(&builder._value))
     {
+      auto& values = Detach().values;
+      values.reserve(builders->size());
       for (auto& builder : *builders)
       {
-        _values.push_back(Json(builder));
+        values.push_back(Json(move(builder)));
       }
     }
     else
@@ -93,99 +138,221 @@ namespace Json4CPP
 
   JsonArray::JsonArray(JsonArray const& array)
   {
-    _values = array._values;
+    *this = array;
+  }
+
+  JsonArray::JsonArray(JsonArray&& array) noexcept :
+    _data(move(array._data)), _resource(array._resource), _hash(array._hash.exchange(0, memory_order_relaxed))
+  {
+
+  }
+
+  JsonArray& JsonArray::operator=(JsonArray const& array)
+  {
+    // Copying referenced values into themselves would leave the references to them dangling
+    if (&array == this)
+    {
+      return *this;
+    }
+    if (!array._data || (array._resource == _resource && !array._data->referenced))
+    {
+      _data = array._data;
+    }
+    else
+    {
+      _data = allocate_shared<Data>(pmr::polymorphic_allocator<Data>(_resource), *array._data, _resource);
+    }
+    _hash.store(array._hash.load(memory_order_relaxed), memory_order_relaxed);
+    return *this;
+  }
+
+  JsonArray& JsonArray::operator=(JsonArray&& array)
+  {
+    if (array._resource != _resource)
+    {
+      return *this = array;
+    }
+    _data = move(array._data);
+    _hash.store(array._hash.exchange(0, memory_order_relaxed), memory_order_relaxed);
+    return *this;
+  }
+
+  JsonArray::JsonArray(pmr::memory_resource* resource) : _resource(resource)
+  {
+
   }
 
   wstring JsonArray::Dump(uint8_t indentation) const
   {
-    wstringstream os;
-    JsonLinter::Write(os, JsonArray::Write(*this, deque<TOKEN>()), indentation);
-    return os.str();
+    return JsonWriter::Dump(*this, indentation);
   }
 
   int64_t JsonArray::Size() const
   {
-    return _values.size();
+    return Contents().values.size();
+  }
+
+  uint64_t JsonArray::Hash() const
+  {
+    if (auto result = _hash.load(memory_order_relaxed))
+    {
+      return result;
+    }
+    // Distinguishes [] from {} and from the scalars
+    auto result = uint64_t(0xbb67ae8584caa73b);
+    for (auto& value : Contents().values)
+    {
+      result = CombineHash(result, value.Hash());
+    }
+    // 0 would mean that it is not computed yet
+    result += !result;
+    // Writes through the references to referenced values do not drop the cached hash, so it is not cached for them
+    if (!_data || !_data->referenced)
+    {
+      _hash.store(result, memory_order_relaxed);
+    }
+    return result;
   }
 
   void JsonArray::Resize(int64_t size)
   {
-    _values.resize(size);
+    Detach().values.resize(size);
   }
 
   void JsonArray::Clear()
   {
-    _values.clear();
+    // Shared values are left to the other copies instead of being copied only to be cleared
+    if (_data.use_count() > 1)
+    {
+      _data = nullptr;
+      _hash.store(0, memory_order_relaxed);
+      return;
+    }
+    if (_data)
+    {
+      Detach().values.clear();
+    }
   }
 
   void JsonArray::PushBack(Json value)
   {
-    _values.push_back(value);
+    Detach().values.push_back(move(value));
   }
 
   void JsonArray::Insert(int64_t index, Json value)
   {
-    _values.insert(_values.begin() + index, value);
+    auto& values = Detach().values;
+    values.insert(values.begin() + index, move(value));
   }
   
   void JsonArray::Erase(int64_t index)
   {
-    _values.erase(_values.begin() + index);
+    auto& values = Detach().values;
+    values.erase(values.begin() + index);
   }
 
   Json& JsonArray::operator[](int64_t const& index)
   {
-    return _values[index];
+    return Reference().values[index];
   }
 
-  Json JsonArray::At(int64_t const& index) const
+  Json const& JsonArray::At(int64_t const& index) const
   {
-    return _values[index];
+    return Contents().values[index];
   }
 
   Json& JsonArray::At(int64_t const& index)
   {
-    return _values[index];
+    return Reference().values[index];
   }
 
-  vector<Json>::iterator JsonArray::begin()
+  Json const* JsonArray::Find(int64_t const& index) const
   {
-    return _values.begin();
+    auto& values = Contents().values;
+    return 0 <= index && index < (int64_t)values.size() ? &values[index] : nullptr;
   }
 
-  vector<Json>::iterator JsonArray::end()
+  Json* JsonArray::Find(int64_t const& index)
   {
-    return _values.end();
+    return 0 <= index && index < Size() ? &Reference().values[index] : nullptr;
   }
 
-  vector<Json>::const_iterator JsonArray::begin() const
+  pmr::vector<Json>::iterator JsonArray::begin()
   {
-    return _values.begin();
+    return Reference().values.begin();
   }
 
-  vector<Json>::const_iterator JsonArray::end() const
+  pmr::vector<Json>::iterator JsonArray::end()
   {
-    return _values.end();
+    return Reference().values.end();
+  }
+
+  pmr::vector<Json>::const_iterator JsonArray::begin() const
+  {
+    return Contents().values.begin();
+  }
+
+  pmr::vector<Json>::const_iterator JsonArray::end() const
+  {
+    return Contents().values.end();
   }
 
   wostream& operator<<(wostream& os, JsonArray const& array)
   {
-    return JsonLinter::Write(os, JsonArray::Write(array, deque<TOKEN>()), JsonDefault::Indentation);
+    return JsonWriter::Write(os, array, JsonDefault::Indentation);
   }
 
   wistream& operator>>(wistream& is, JsonArray& array)
   {
-    array = JsonArray::Read(JsonLinter::Read(is));
-    return is;
+    auto json = Json();
+    auto handler = JsonDomHandler(json);
+    JsonLinter::Read(is, handler);
+    if (auto result = json.GetIf<JsonArray>())
+    {
+      array = move(*result);
+      return is;
+    }
+    auto message = WString2String(L"Expected token: "s + Json::Stringify(JsonTokenType::StartArray) + L"!"s);
+    throw exception(message.c_str());
+  }
+
+  ostream& operator<<(ostream& os, JsonArray const& array)
+  {
+    return JsonWriter::Write(os, array, JsonDefault::Indentation);
+  }
+
+  istream& operator>>(istream& is, JsonArray& array)
+  {
+    auto json = Json();
+    auto handler = JsonDomHandler(json);
+    JsonLinter::Read(is, handler);
+    if (auto result = json.GetIf<JsonArray>())
+    {
+      array = move(*result);
+      return is;
+    }
+    auto message = WString2String(L"Expected token: "s + Json::Stringify(JsonTokenType::StartArray) + L"!"s);
+    throw exception(message.c_str());
   }
 
   bool operator==(JsonArray const& left, JsonArray const& right)
   {
-    return left._values == right._values;
+    if (left._data == right._data)
+    {
+      return true;
+    }
+    // Only the cached hashes are compared, computing them would visit every value anyway
+    auto leftHash = left._hash.load(memory_order_relaxed);
+    auto rightHash = right._hash.load(memory_order_relaxed);
+    if (leftHash && rightHash && leftHash != rightHash)
+    {
+      return false;
+    }
+    return left.Contents().values == right.Contents().values;
   }
 
   bool operator!=(JsonArray const& left, JsonArray const& right)
   {
-    return left._values != right._values;
+    return !(left == right);
   }
 }
\ No newline at end of file
@@ -10,20 +10,28 @@
 #include "JsonLinter.h"
 
 #include <vector>
+#include <utility>
 #include <deque>
 #include <sstream>
 #include <iostream>
 #include <initializer_list>
 #include <string>
+#include <memory_resource>
+#include <atomic>
+#include <memory>
 
 namespace Json4CPP
 {
   namespace Detail
   {
     class JSON_API JsonBuilder;
+    class JSON_API JsonDomHandler;
+    class JSON_API JsonWriter;
+    class JSON_API JsonPatch;
   }
   class JSON_API JsonObject;
   class JSON_API Json;
+  class JSON_API JsonPath;
 
   class JSON_API JsonArray
   {
@@ -31,8 +39,42 @@ namespace Json4CPP
     friend class JsonObject;
     friend class Json;
     friend class Detail::JsonBuilder;
+    friend class Detail::JsonDomHandler;
+    friend class Detail::JsonWriter;
+    friend class Detail::JsonPatch;
+    friend class JsonPath;
+    // The values, shared by the copies of the array until one of them is modified
+    struct Data
+    {
 #pragma warning(suppress: 4251)
-    std::vector<Json> _values;
+      std::pmr::vector<Json> values;
+
+      // Set once references or iterators to the values are handed out, the copies made after that copy them right away.
+      // Cleared by the members which modify the array, as those invalidate the references and iterators handed out before.
+      bool referenced = false;
+
+      explicit Data(std::pmr::memory_resource* resource);
+      Data(Data const& data, std::pmr::memory_resource* resource);
+    };
+    // Allocated on the first write, so empty arrays allocate nothing
+#pragma warning(suppress: 4251)
+    std::shared_ptr<Data> _data;
+    std::pmr::memory_resource* _resource = std::pmr::get_default_resource();
+    // Cached result of Hash, 0 until it is computed
+#pragma warning(suppress: 4251)
+    mutable std::atomic<uint64_t> _hash = 0;
+
+    // The values for reading, an empty Data if nothing is allocated yet.
+    Data const& Contents() const;
+    // The values for writing, called by every member which modifies the array.
+    // Allocates them on the first call, copies them if they are shared with other copies of the array, drops the cached hash,
+    // and clears referenced.
+    // Only the values are copied, the nested objects and arrays stay shared until they are written themselves.
+    Data& Detach();
+    // Detach, for the members which return references or iterators to the values. As the values can be written through those
+    // at any time later, they are marked referenced, and the copies made until the next modification copy them instead of sharing them.
+    // Stops caching the hash until then too.
+    Data& Reference();
 
     static JsonArray                  Read (                        std::deque<Detail::TOKEN>& tokens);
     static std::deque<Detail::TOKEN>& Write(JsonArray const& array, std::deque<Detail::TOKEN>& tokens);
@@ -40,29 +82,72 @@ namespace Json4CPP
     JsonArray() = default;
     JsonArray(Detail::JsonBuilder builder);
     JsonArray(std::initializer_list<Detail::JsonBuilder> builders);
+    // Copies share the values with array until either of them is modified, when only the modified one copies them (copy-on-write).
+    // Once references or iterators to the values are obtained through non-const members, the copies made after that copy the values
+    // right away, so writing through those never changes a copy. The array shares its values again after it is modified, or assigned,
+    // as that invalidates those references and iterators, as with std::vector.
     JsonArray(JsonArray const& array);
+    JsonArray(JsonArray&& array) noexcept;
+    // Assignment keeps the memory resource of the target, the values are shared only if it is the same as the one of array
+    // and they are not referenced
+    JsonArray& operator=(JsonArray const& array);
+    JsonArray& operator=(JsonArray&& array);
+    // The values are allocated from resource, which has to outlive the JsonArray. Copies use the default resource,
+    // so the values of arrays with other resources are copied right away.
+    explicit JsonArray(std::pmr::memory_resource* resource);
 
     std::wstring Dump(uint8_t indentation = 0) const;
 
     int64_t Size() const;
+    // Hash of the values in order, consistent with operator==, so 1, 1.0 and true hash the same.
+    // It is computed on the first call and cached, also in every nested JsonObject and JsonArray, until the array is accessed
+    // through a non-const member. It is not cached while references or iterators to the values can be in use, which is from the
+    // first call of a non-const member returning one, until the next call of a member modifying the array, or an assignment.
+    // Those invalidate the references and iterators handed out before, as with std::vector.
+    uint64_t Hash() const;
     void Resize(int64_t size);
     void Clear();
     void PushBack(               Json value);
+    // Constructs the value in place at the end from args, and returns it.
+    template<typename... Args>
+    Json& EmplaceBack(Args&&... args)
+    {
+      return Reference().values.emplace_back(std::forward<Args>(args)...);
+    }
     void Insert  (int64_t index, Json value);
     void Erase   (int64_t index            );
     Json& operator[](int64_t const& index);
-    Json  At        (int64_t const& index) const;
-    Json& At        (int64_t const& index);
+    Json const& At  (int64_t const& index) const;
+    Json      & At  (int64_t const& index);
+    // Returns the value at index, or nullptr if index is out of range.
+    Json const* Find(int64_t const& index) const;
+    Json      * Find(int64_t const& index);
 
-    std::vector<Json>::      iterator begin();
-    std::vector<Json>::      iterator end  ();
-    std::vector<Json>::const_iterator begin() const;
-    std::vector<Json>::const_iterator end  () const;
+    std::pmr::vector<Json>::      iterator begin();
+    std::pmr::vector<Json>::      iterator end  ();
+    std::pmr::vector<Json>::const_iterator begin() const;
+    std::pmr::vector<Json>::const_iterator end  () const;
 
     JSON_API friend std::wostream& operator<<(std::wostream& os, JsonArray const& array);
     JSON_API friend std::wistream& operator>>(std::wistream& is, JsonArray      & array);
+    // UTF-8 encoded text
+    JSON_API friend std::ostream & operator<<(std::ostream & os, JsonArray const& array);
+    JSON_API friend std::istream & operator>>(std::istream & is, JsonArray      & array);
 
+    // If both arrays share their values, or both hashes are cached already and they differ, returns without comparing the values.
     JSON_API friend bool operator==(JsonArray const& left, JsonArray const& right);
     JSON_API friend bool operator!=(JsonArray const& left, JsonArray const& right);
   };
+}
+
+namespace std
+{
+  template<>
+  struct hash<Json4CPP::JsonArray>
+  {
+    size_t operator()(Json4CPP::JsonArray const& array) const
+    {
+      return (size_t)array.Hash();
+    }
+  };
 }
\ No newline at end of file
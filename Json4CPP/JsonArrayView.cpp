@@ -0,0 +1,53 @@
+#include "stdafx.h"
+
+#include "Json.h"
+
+using namespace std;
+
+namespace Json4CPP
+{
+  JsonArrayView::JsonArrayView(JsonArray const& array) : _array(&array)
+  {
+
+  }
+
+  wstring JsonArrayView::Dump(uint8_t indentation) const
+  {
+    return _array->Dump(indentation);
+  }
+
+  int64_t JsonArrayView::Size() const
+  {
+    return _array->Size();
+  }
+
+  Json const& JsonArrayView::operator[](int64_t const& index) const
+  {
+    return _array->At(index);
+  }
+
+  Json const& JsonArrayView::At(int64_t const& index) const
+  {
+    return _array->At(index);
+  }
+
+  Json const* JsonArrayView::Find(int64_t const& index) const
+  {
+    return _array->Find(index);
+  }
+
+  pmr::vector<Json>::const_iterator JsonArrayView::begin() const
+  {
+    return _array->begin();
+  }
+
+  pmr::vector<Json>::const_iterator JsonArrayView::end() const
+  {
+    return _array->end();
+  }
+
+  JsonArray const& JsonArrayView::Array() const
+  {
+    return *_array;
+  }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include "JsonArray.h"
+
+#include <string>
+
+namespace Json4CPP
+{
+  class JSON_API Json;
+
+  // Read-only view of a JsonArray, which does not copy it. The JsonArray has to outlive the view, and must not be changed while the view is used.
+  class JSON_API JsonArrayView
+  {
+  private:
+    JsonArray const* _array;
+  public:
+    JsonArrayView(JsonArray const& array);
+
+    std::wstring Dump(uint8_t indentation = 0) const;
+
+    int64_t Size() const;
+    Json const& operator[](int64_t const& index) const;
+    Json const& At        (int64_t const& index) const;
+    // Returns the value at index, or nullptr if index is out of range.
+    Json const* Find      (int64_t const& index) const;
+
+    std::pmr::vector<Json>::const_iterator begin() const;
+    std::pmr::vector<Json>::const_iterator end  () const;
+
+    // The viewed JsonArray, copying it gives an owning JsonArray.
+    JsonArray const& Array() const;
+  };
+}
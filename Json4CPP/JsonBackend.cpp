@@ -0,0 +1,18 @@
+#include "stdafx.h"
+
+#include "JsonBackend.h"
+
+using namespace std;
+
+namespace Json4CPP
+{
+  wostream& operator<<(wostream& os, JsonBackend const& backend)
+  {
+    switch (backend)
+    {
+    case JsonBackend::StructuralIndex: return os << L"StructuralIndex"s;
+    default:
+    case JsonBackend::Linter         : return os << L"Linter"s;
+    }
+  }
+}
\ No newline at end of file
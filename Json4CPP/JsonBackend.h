@@ -0,0 +1,22 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include <sstream>
+#include <string>
+
+namespace Json4CPP
+{
+  // How text in memory is parsed, see JsonDefault::Backend. Both of them produce the same values and the same error messages.
+  enum class JSON_API JsonBackend
+  {
+    Linter,          // JsonLinter reads the text character by character.
+    StructuralIndex, // A SIMD pass finds the position of every token first, then JsonLinter only parses the values at those positions.
+  };
+
+  JSON_API std::wostream& operator<<(std::wostream& os, JsonBackend const& backend);
+}
\ No newline at end of file
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <istream>
+#include <cwctype>
+#include <cstdint>
+#include <type_traits>
+
+#include "Helper.h"
+
+namespace Json4CPP::Detail
+{
+  // Decodes the UTF-8 sequence at current into codePoint, returns its length in bytes or 0 if it is invalid or incomplete.
+  // Overlong encodings, surrogates and code points above U+10FFFF are invalid.
+  inline int DecodeUtf8(char const* current, char const* end, char32_t& codePoint)
+  {
+    auto c0 = (unsigned char)current[0];
+    auto available = end - current;
+    auto continuation = [&](int i, unsigned char low = 0x80, unsigned char high = 0xBF)
+    {
+      return i < available && low <= (unsigned char)current[i] && (unsigned char)current[i] <= high;
+    };
+    if (c0 < 0x80)
+    {
+      codePoint = c0;
+      return 1;
+    }
+    if (0xC2 <= c0 && c0 <= 0xDF && continuation(1))
+    {
+      codePoint = (c0 & 0x1F) << 6 | (current[1] & 0x3F);
+      return 2;
+    }
+    if (0xE0 <= c0 && c0 <= 0xEF && continuation(1, c0 == 0xE0 ? 0xA0 : 0x80, c0 == 0xED ? 0x9F : 0xBF) && continuation(2))
+    {
+      codePoint = (c0 & 0x0F) << 12 | (current[1] & 0x3F) << 6 | (current[2] & 0x3F);
+      return 3;
+    }
+    if (0xF0 <= c0 && c0 <= 0xF4 && continuation(1, c0 == 0xF0 ? 0x90 : 0x80, c0 == 0xF4 ? 0x8F : 0xBF) && continuation(2) && continuation(3))
+    {
+      codePoint = (c0 & 0x07) << 18 | (current[1] & 0x3F) << 12 | (current[2] & 0x3F) << 6 | (current[3] & 0x3F);
+      return 4;
+    }
+    return 0;
+  }
+
+  // Advances position over text, the lines end with \r\n, and the column is the number of UTF-16 code units since the last line ending
+  // (UTF-32 code units where wchar_t is 4 bytes), the same as the number of characters JsonBuffer would read.
+  template<typename Char>
+  std::pair<uint64_t, uint64_t> AdvancePosition(std::pair<uint64_t, uint64_t> position, std::basic_string_view<Char> text)
+  {
+    static constexpr Char lineEnding[] = { '\r', '\n' };
+    auto& [line, column] = position;
+    auto lineStart = size_t(0);
+    for (auto i = text.find(lineEnding, 0, 2); i != text.npos; i = text.find(lineEnding, i + 2, 2))
+    {
+      ++line;
+      column = 0;
+      lineStart = i + 2;
+    }
+    if constexpr (std::is_same_v<Char, wchar_t>)
+    {
+      column += text.size() - lineStart;
+    }
+    else
+    {
+      for (auto c : text.substr(lineStart))
+      {
+        // Every byte but the continuation bytes starts a character, which is a surrogate pair above U+FFFF where wchar_t is 2 bytes
+        auto byte = (unsigned char)c;
+        column += (byte & 0xC0) != 0x80;
+        column += sizeof(wchar_t) == 2 && byte >= 0xF0;
+      }
+    }
+    return position;
+  }
+
+  // Non-owning view over contiguous text which exposes the subset of the std::wistream interface used by JsonLinter
+  // (peek, get, eof, tellg and >> std::ws), but scans with a plain pointer instead of going through a sentry and a virtual call per character.
+  // JsonBuffer<wchar_t> reads UTF-16, JsonBuffer<char> reads UTF-8 and yields the same UTF-16 code units that String2WString would produce.
+  template<typename Char>
+  class JsonBuffer
+  {
+  public:
+    using int_type = std::wistream::int_type;
+    using pos_type = uint64_t;
+
+    static constexpr int_type eof_value = std::char_traits<wchar_t>::eof();
+    static constexpr pos_type npos = (pos_type)-1;
+
+  private:
+    Char const* _begin;
+    Char const* _current;
+    Char const* _end;
+    wchar_t _pending;   // Low surrogate of an already consumed 4 byte UTF-8 sequence
+    bool _eof;
+    std::pair<uint64_t, uint64_t> _start; // { line, column } where the text before data ended, for the positions in the error messages
+    std::pair<uint64_t, uint64_t> _line;  // { line, index in data } of the beginning of the last line, whose ending was skipped as whitespace
+
+    template<typename C>
+    friend std::pair<uint64_t, uint64_t> GetStreamPosition(JsonBuffer<C> const& is, typename JsonBuffer<C>::pos_type pos);
+
+    int_type Next(bool consume)
+    {
+      if (_pending)
+      {
+        auto c = _pending;
+        if (consume) _pending = L'\0';
+        return c;
+      }
+      if (_current == _end)
+      {
+        _eof = true;
+        return eof_value;
+      }
+      if constexpr (std::is_same_v<Char, wchar_t>)
+      {
+        return consume ? *_current++ : *_current;
+      }
+      else
+      {
+        if ((unsigned char)*_current < 0x80)
+        {
+          return consume ? *_current++ : *_current;
+        }
+        char32_t codePoint;
+        auto length = DecodeUtf8(_current, _end, codePoint);
+        if (length == 0)
+        {
+          // The offending byte can not be replayed, so report the column after the last decoded character
+          auto [line, column] = GetStreamPosition(*this, tellg());
+          auto message = "Invalid UTF-8 sequence at position Line: " + std::to_string(line) + " Column: " + std::to_string(column + 1) + "!";
+          throw std::exception(message.c_str());
+        }
+        // Code points above U+FFFF are split into a surrogate pair where wchar_t is 2 bytes, the same way as String2WString does
+        if (codePoint < 0x10000 || sizeof(wchar_t) == 4)
+        {
+          if (consume) _current += length;
+          return (wchar_t)codePoint;
+        }
+        codePoint -= 0x10000;
+        if (consume)
+        {
+          _current += length;
+          _pending = (wchar_t)(0xDC00 + (codePoint & 0x3FF));
+        }
+        return (wchar_t)(0xD800 + (codePoint >> 10));
+      }
+    }
+
+  public:
+    JsonBuffer(std::basic_string_view<Char> data) :
+      _begin(data.data()), _current(data.data()), _end(data.data() + data.size()), _pending(L'\0'), _eof(false), _start(1, 0), _line(1, 0)
+    {
+
+    }
+
+    // Starts reading at position, the text before it only counts for the positions in the error messages.
+    JsonBuffer(std::basic_string_view<Char> data, size_t position) :
+      _begin(data.data()), _current(data.data() + position), _end(data.data() + data.size()), _pending(L'\0'), _eof(false), _start(1, 0), _line(1, 0)
+    {
+
+    }
+
+    // Reads data, which continues text that is no longer available, and ended at start. It must not end between \r and \n.
+    JsonBuffer(std::basic_string_view<Char> data, std::pair<uint64_t, uint64_t> start) :
+      _begin(data.data()), _current(data.data()), _end(data.data() + data.size()), _pending(L'\0'), _eof(false), _start(start), _line(start.first, 0)
+    {
+
+    }
+
+    std::basic_string_view<Char> data() const
+    {
+      return std::basic_string_view<Char>(_begin, _end - _begin);
+    }
+
+    std::pair<uint64_t, uint64_t> start() const
+    {
+      return _start;
+    }
+
+    // Index of the next character in data, the same as tellg, but it does not turn into npos at the end.
+    size_t position() const
+    {
+      return _current - _begin;
+    }
+
+    int_type peek()
+    {
+      return Next(false);
+    }
+
+    int_type get()
+    {
+      return Next(true);
+    }
+
+    bool eof() const
+    {
+      return _eof;
+    }
+
+    // Like std::wistream::tellg, returns npos once the end of the buffer has been reached.
+    pos_type tellg() const
+    {
+      return _eof ? npos : (pos_type)(_current - _begin) << 1 | (_pending ? 1 : 0);
+    }
+
+    // Appends the leading run of characters which need neither escaping nor decoding to text, see ScanString.
+    void ReadPlain(std::wstring& text)
+    {
+      if (_pending) return;
+      auto count = ScanString(_current, _end - _current);
+      text.append(_current, _current + count);
+      _current += count;
+    }
+
+    // Only meant to be used with std::ws, skips whitespace the same way.
+    JsonBuffer& operator>>(std::wistream& (*)(std::wistream&))
+    {
+      while (true)
+      {
+        if (_current == _end && !_pending)
+        {
+          _eof = true;
+          break;
+        }
+        auto c = (std::make_unsigned_t<Char>)*_current;
+        if (!_pending && (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f'))
+        {
+          // Nearly every line ending is skipped here, so the error messages only have to count from the last one
+          if (c == '\n' && _current != _begin && _current[-1] == '\r')
+          {
+            _line = { _line.first + 1, _current + 1 - _begin };
+          }
+          ++_current;
+        }
+        else if (!_pending && c < 0x80)
+        {
+          break;
+        }
+        else if (auto p = peek(); std::iswspace((std::wint_t)p))
+        {
+          get();
+        }
+        else
+        {
+          break;
+        }
+      }
+      return *this;
+    }
+  };
+
+  // Returns the { line, column } pair of the specified position in the buffer.
+  // Line endings are handled as \r\n. Only the text after the last line ending skipped before pos is counted.
+  template<typename Char>
+  std::pair<uint64_t, uint64_t> GetStreamPosition(JsonBuffer<Char> const& is, typename JsonBuffer<Char>::pos_type pos)
+  {
+    auto data = is.data();
+    // Like GetStreamPosition for an std::wistream, the end of the buffer is one column after the last character
+    auto end = pos == JsonBuffer<Char>::npos;
+    auto index = end ? data.size() : (size_t)(pos >> 1);
+    auto [line, column] = is._line.second && is._line.second <= index
+      ? AdvancePosition({ is._line.first, 0 }, data.substr(is._line.second, index - is._line.second))
+      : AdvancePosition(is._start, data.substr(0, index));
+    // The high surrogate of the pending pair has already been read
+    column -= pos & 1 && !end;
+    column += end;
+    return { line, column };
+  }
+
+  // Returns the { line, column } data as L"Line: {line} Column: {column}"s of the specified position in the buffer.
+  // Line endings are handled as \r\n.
+  template<typename Char>
+  std::wstring GetFormattedStreamPosition(JsonBuffer<Char> const& is, typename JsonBuffer<Char>::pos_type pos)
+  {
+    auto [line, column] = GetStreamPosition(is, pos);
+    return L"Line: " + std::to_wstring(line) + L" Column: " + std::to_wstring(column);
+  }
+
+  // Returns the { line, column } data as "Line: {line} Column: {column}"s of the specified position in the buffer.
+  // Line endings are handled as \r\n.
+  template<typename Char>
+  std::string GetFormattedStreamPositionA(JsonBuffer<Char> const& is, typename JsonBuffer<Char>::pos_type pos)
+  {
+    auto [line, column] = GetStreamPosition(is, pos);
+    return "Line: " + std::to_string(line) + " Column: " + std::to_string(column);
+  }
+}
@@ -10,10 +10,10 @@ namespace Json4CPP::Detail
 {
   JsonBuilder::JsonBuilder() : JsonBuilder(nullptr) {}
 
-  JsonBuilder::JsonBuilder(VALUE          value) { visit([&](auto arg) { _value = arg; }, value); }
+  JsonBuilder::JsonBuilder(VALUE          value) { visit([&](auto& arg) { _value = move(arg); }, value); }
   JsonBuilder::JsonBuilder(nullptr_t      value) { _value =         value;                        }
   JsonBuilder::JsonBuilder(const wchar_t* value) { _value = wstring(value);                       }
-  JsonBuilder::JsonBuilder(wstring        value) { _value =         value;                        }
+  JsonBuilder::JsonBuilder(wstring        value) { _value = move   (value);                       }
   JsonBuilder::JsonBuilder(bool           value) { _value =         value;                        }
   JsonBuilder::JsonBuilder(char           value) { _value = int64_t(value);                       }
   JsonBuilder::JsonBuilder(int8_t         value) { _value = int64_t(value);                       }
@@ -26,16 +26,16 @@ namespace Json4CPP::Detail
   JsonBuilder::JsonBuilder(uint64_t       value) { _value = int64_t(value);                       }
   JsonBuilder::JsonBuilder(float          value) { _value = double (value);                       }
   JsonBuilder::JsonBuilder(double         value) { _value =         value;                        }
-  JsonBuilder::JsonBuilder(JsonObject     value) { _value =         value;                        }
-  JsonBuilder::JsonBuilder(JsonArray      value) { _value =         value;                        }
-  JsonBuilder::JsonBuilder(Json           value) : JsonBuilder(value._value) {                    }
+  JsonBuilder::JsonBuilder(JsonObject     value) { _value = move   (value);                       }
+  JsonBuilder::JsonBuilder(JsonArray      value) { _value = move   (value);                       }
+  JsonBuilder::JsonBuilder(Json           value) : JsonBuilder(move(value._value)) {              }
   JsonBuilder::JsonBuilder(initializer_list<JsonBuilder> values)
   {
     _value = vector<JsonBuilder>(values.begin(), values.end());
   }
   JsonBuilder::JsonBuilder(vector<JsonBuilder> values)
   {
-    _value = values;
+    _value = move(values);
   }
 
   JsonBuilderType JsonBuilder::Type() const
@@ -8,4 +8,6 @@ namespace Json4CPP
 {
   uint8_t JsonDefault::Indentation = 2;
   uint8_t JsonDefault::MaxDepth = 20;
+  JsonBackend JsonDefault::Backend = JsonBackend::Linter;
+  uint8_t JsonDefault::Threads = 1;
 }
\ No newline at end of file
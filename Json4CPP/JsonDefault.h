@@ -6,11 +6,17 @@
 #define JSON_API __declspec(dllimport)
 #endif
 
+#include "JsonBackend.h"
+
 namespace Json4CPP
 {
   struct JSON_API JsonDefault
   {
     static uint8_t Indentation;
     static uint8_t MaxDepth;
+    // Used by Json::Parse, Json::Read and JsonLinter::Read for text in memory, streams are always read by the linter.
+    static JsonBackend Backend;
+    // Used by Json::Parse and Json::Read for large root arrays in memory, see JsonLinter::ReadParallel. 1 parses on the calling thread only.
+    static uint8_t Threads;
   };
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "stdafx.h"
+
+#include "JsonDomHandler.h"
+#include "Json.h"
+
+using namespace std;
+
+namespace Json4CPP::Detail
+{
+  JsonDomHandler::JsonDomHandler(Json& root, pmr::memory_resource* resource) : _root(root), _resource(resource)
+  {
+
+  }
+
+  void JsonDomHandler::Reset()
+  {
+    _containers.clear();
+    _ignored.clear();
+  }
+
+  Json& JsonDomHandler::Add()
+  {
+    if (_containers.empty())
+    {
+      return _root;
+    }
+    auto& parent = _containers.back()->_value;
+    if (auto array = get_if<JsonArray>(&parent))
+    {
+      return array->Detach().values.emplace_back();
+    }
+    auto& object = get<JsonObject>(parent);
+    if (object.IndexOf(_property) != -1)
+    {
+      return _ignored.emplace_back();
+    }
+    auto& pair = object.Detach().pairs.emplace_back(move(_property), Json());
+    object.IndexLast();
+    return pair.second;
+  }
+
+  template<typename T>
+  void JsonDomHandler::Set(T&& value)
+  {
+    auto& json = Add();
+    json._value = forward<T>(value);
+    if (!_ignored.empty() && &json == &_ignored.back())
+    {
+      _ignored.pop_back();
+    }
+  }
+
+  void JsonDomHandler::Close()
+  {
+    // The values of the duplicate keys nested in this one are dropped already, so it is the last one if it is ignored
+    if (!_ignored.empty() && _containers.back() == &_ignored.back())
+    {
+      _ignored.pop_back();
+    }
+    _containers.pop_back();
+  }
+
+  void JsonDomHandler::Null        (               ) { Set(nullptr);            }
+  void JsonDomHandler::String      (wstring&& value) { Set(move(value));        }
+  void JsonDomHandler::Boolean     (bool      value) { Set(value);              }
+  void JsonDomHandler::Real        (double    value) { Set(value);              }
+  void JsonDomHandler::Integer     (int64_t   value) { Set(value);              }
+  void JsonDomHandler::PropertyName(wstring&& value) { _property = move(value); }
+
+  void JsonDomHandler::StartObject()
+  {
+    auto& json = Add();
+    json._value.emplace<JsonObject>(_resource);
+    _containers.push_back(&json);
+  }
+
+  void JsonDomHandler::EndObject()
+  {
+    Close();
+  }
+
+  void JsonDomHandler::StartArray()
+  {
+    auto& json = Add();
+    json._value.emplace<JsonArray>(_resource);
+    _containers.push_back(&json);
+  }
+
+  void JsonDomHandler::EndArray()
+  {
+    Close();
+  }
+}
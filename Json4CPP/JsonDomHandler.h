@@ -0,0 +1,62 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include "JsonHandler.h"
+#include "Value.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory_resource>
+
+namespace Json4CPP
+{
+  class JSON_API Json;
+
+  namespace Detail
+  {
+    // Builds the JsonObject and JsonArray values directly into root as JsonLinter parses them, without collecting tokens first.
+    // Duplicate keys are handled the same way as JsonObject::Insert does, the first value is kept.
+    // Every JsonObject and JsonArray is created with resource, so a whole document can be allocated from a single arena.
+    class JSON_API JsonDomHandler : public JsonHandler
+    {
+    private:
+      Json& _root;
+      std::pmr::memory_resource* _resource;
+#pragma warning(suppress: 4251)
+      std::vector<Json*> _containers; // The JsonObject and JsonArray values which are not closed yet
+#pragma warning(suppress: 4251)
+      KEY _property;                  // The last property name, the next value belongs to it
+#pragma warning(suppress: 4251)
+      std::deque<Json> _ignored;      // Values of duplicate keys being built, each is dropped as soon as it is complete
+
+      Json& Add();
+      // Adds a scalar value, and drops it right away if it belongs to a duplicate key.
+      template<typename T>
+      void Set(T&& value);
+      // Closes the last container, and drops it if it belongs to a duplicate key.
+      void Close();
+    public:
+      JsonDomHandler(Json& root, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+      // Drops the containers left open by an error, and the values of the duplicate keys in them, so that the next root can be built.
+      void Reset();
+
+      void Null        (                     ) override;
+      void String      (std::wstring&& value ) override;
+      void Boolean     (bool           value ) override;
+      void Real        (double         value ) override;
+      void Integer     (int64_t        value ) override;
+      void PropertyName(std::wstring&& value ) override;
+      void StartObject (                     ) override;
+      void EndObject   (                     ) override;
+      void StartArray  (                     ) override;
+      void EndArray    (                     ) override;
+    };
+  }
+}
@@ -0,0 +1,60 @@
+#include "stdafx.h"
+
+#include "JsonFileMapping.h"
+
+using namespace std;
+using namespace std::filesystem;
+
+namespace Json4CPP::Detail
+{
+  JsonFileMapping::JsonFileMapping(path const& path) : _file(INVALID_HANDLE_VALUE), _mapping(nullptr), _data(nullptr), _size(0)
+  {
+    _file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    auto size = LARGE_INTEGER();
+    if (_file == INVALID_HANDLE_VALUE || GetFileType(_file) != FILE_TYPE_DISK || !GetFileSizeEx(_file, &size) || size.QuadPart == 0)
+    {
+      return;
+    }
+    // Files which do not fit into the address space are left to the caller too
+    if ((uint64_t)size.QuadPart > (uint64_t)SIZE_MAX)
+    {
+      return;
+    }
+    _mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (_mapping == nullptr)
+    {
+      return;
+    }
+    _data = (char const*)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (_data)
+    {
+      _size = (size_t)size.QuadPart;
+    }
+  }
+
+  JsonFileMapping::~JsonFileMapping()
+  {
+    if (_data)
+    {
+      UnmapViewOfFile(_data);
+    }
+    if (_mapping)
+    {
+      CloseHandle(_mapping);
+    }
+    if (_file != INVALID_HANDLE_VALUE)
+    {
+      CloseHandle(_file);
+    }
+  }
+
+  bool JsonFileMapping::IsMapped() const
+  {
+    return _data != nullptr;
+  }
+
+  string_view JsonFileMapping::Data() const
+  {
+    return string_view(_data, _size);
+  }
+}
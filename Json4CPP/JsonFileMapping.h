@@ -0,0 +1,33 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include <string_view>
+#include <filesystem>
+
+namespace Json4CPP::Detail
+{
+  // Maps a file read-only into memory, so it can be parsed in place without copying it into a string first.
+  // IsMapped is false if the file can not be opened or mapped (for example it is empty, or it is not a regular file),
+  // in that case the caller has to read it some other way.
+  class JSON_API JsonFileMapping
+  {
+  private:
+    void* _file;
+    void* _mapping;
+    char const* _data;
+    size_t _size;
+  public:
+    JsonFileMapping(std::filesystem::path const& path);
+    JsonFileMapping(JsonFileMapping const&) = delete;
+    JsonFileMapping& operator=(JsonFileMapping const&) = delete;
+    ~JsonFileMapping();
+
+    bool IsMapped() const;
+    std::string_view Data() const;
+  };
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include <string>
+#include <cstdint>
+
+namespace Json4CPP::Detail
+{
+  // Receives the parsed values from JsonLinter in document order, one call per JsonTokenType.
+  // Strings are passed as rvalues, so the handler can take them over without copying.
+  class JSON_API JsonHandler
+  {
+  public:
+    virtual ~JsonHandler() = default;
+
+    virtual void Null        (                     ) = 0;
+    virtual void String      (std::wstring&& value ) = 0;
+    virtual void Boolean     (bool           value ) = 0;
+    virtual void Real        (double         value ) = 0;
+    virtual void Integer     (int64_t        value ) = 0;
+    virtual void PropertyName(std::wstring&& value ) = 0;
+    virtual void StartObject (                     ) = 0;
+    virtual void EndObject   (                     ) = 0;
+    virtual void StartArray  (                     ) = 0;
+    virtual void EndArray    (                     ) = 0;
+  };
+}
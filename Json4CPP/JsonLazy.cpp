@@ -0,0 +1,420 @@
+#include "stdafx.h"
+
+#include "JsonLazy.h"
+#include "JsonBuffer.h"
+#include "JsonFileMapping.h"
+#include "JsonDomHandler.h"
+#include "JsonDefault.h"
+#include "Helper.h"
+
+using namespace std;
+using namespace std::filesystem;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP::Detail
+{
+  struct JsonLazyDocument
+  {
+    string text;                             // Copy of the parsed text, empty if the file is mapped
+    unique_ptr<JsonFileMapping> file;
+    string_view data;
+    vector<pair<size_t, size_t>> containers; // Position of the opening and the closing bracket of every object and array, in the order they start
+  };
+
+  // A direct child of an object or an array.
+  struct JsonLazyChild
+  {
+    string_view key;  // Raw text of the property name with the quotes, empty for arrays
+    size_t begin;
+    size_t end;
+    size_t container;
+  };
+
+  static constexpr auto npos = string_view::npos;
+
+  // Returns "Line: {line} Column: {column}" of the character at position, counted the same way as by JsonLinter.
+  static string FormatPosition(string_view data, size_t position)
+  {
+    auto [line, column] = GetStreamPosition(JsonBuffer<char>(data), (uint64_t)position << 1);
+    return "Line: "s + to_string(line) + " Column: "s + to_string(column + 1);
+  }
+
+  [[noreturn]] static void Unexpected(string_view data, size_t position)
+  {
+    auto message = "Unexpected '"s + data[position] + "' at position "s + FormatPosition(data, position) + "!"s;
+    throw exception(message.c_str());
+  }
+
+  [[noreturn]] static void Expected(string_view data, size_t position, string const& expected)
+  {
+    auto message = "Expected "s + expected + " at position "s + FormatPosition(data, position) + "!"s;
+    throw exception(message.c_str());
+  }
+
+  static size_t SkipWhitespace(string_view data, size_t position)
+  {
+    while (position < data.size())
+    {
+      switch (data[position])
+      {
+      case ' ': case '\t': case '\n': case '\r': case '\v': case '\f': ++position; break;
+      default: return position;
+      }
+    }
+    return position;
+  }
+
+  // Returns the position of the quote closing the string which starts at begin.
+  static size_t StringEnd(string_view data, size_t begin)
+  {
+    auto position = begin + 1;
+    while (auto quote = (char const*)memchr(data.data() + position, '"', data.size() - position))
+    {
+      position = quote - data.data();
+      // The quote is escaped if it follows an odd number of backslashes
+      auto backslashes = position;
+      while (data[backslashes - 1] == '\\')
+      {
+        --backslashes;
+      }
+      if ((position - backslashes) % 2 == 0)
+      {
+        return position;
+      }
+      ++position;
+    }
+    Expected(data, data.size(), "'\"'");
+  }
+
+  // Walks over the direct children of an object or an array, skipping the nested ones through the index of the document.
+  class JsonLazyCursor
+  {
+  private:
+    JsonLazyDocument const& _document;
+    size_t _position; // After the last child, or the opening bracket
+    size_t _close;    // Position of the closing bracket
+    size_t _next;     // Index of the first object or array which starts after the last child
+    bool _object;
+    bool _first;
+  public:
+    JsonLazyCursor(JsonLazyDocument const& document, size_t container) :
+      _document(document), _position(document.containers[container].first + 1), _close(document.containers[container].second),
+      _next(container + 1), _object(document.data[_position - 1] == '{'), _first(true)
+    {
+
+    }
+
+    // Moves to the next child, returns false after the last one.
+    bool Next(JsonLazyChild& child)
+    {
+      auto data = _document.data;
+      auto position = SkipWhitespace(data, _position);
+      if (position == _close)
+      {
+        return false;
+      }
+      if (!_first)
+      {
+        if (data[position] != ',')
+        {
+          Expected(data, position, _object ? "',' or '}'" : "',' or ']'");
+        }
+        position = SkipWhitespace(data, position + 1);
+      }
+      _first = false;
+      if (_object)
+      {
+        if (data[position] != '"')
+        {
+          Expected(data, position, "'\"'");
+        }
+        auto keyEnd = StringEnd(data, position);
+        child.key = data.substr(position, keyEnd + 1 - position);
+        position = SkipWhitespace(data, keyEnd + 1);
+        if (data[position] != ':')
+        {
+          Expected(data, position, "':'");
+        }
+        position = SkipWhitespace(data, position + 1);
+      }
+      child.begin = position;
+      child.container = npos;
+      switch (data[position])
+      {
+      case '{':
+      case '[':
+      {
+        // The next sibling object or array is the first one which starts after this one ends
+        auto& containers = _document.containers;
+        child.container = _next;
+        child.end = containers[_next].second + 1;
+        _next = lower_bound(containers.begin() + _next + 1, containers.end(), child.end,
+                            [](pair<size_t, size_t> const& container, size_t end) { return container.first < end; }) - containers.begin();
+        break;
+      }
+      case '"':
+        child.end = StringEnd(data, position) + 1;
+        break;
+      default:
+        child.end = position;
+        while (child.end < _close && !strchr(", \t\n\r\v\f]}", data[child.end]))
+        {
+          ++child.end;
+        }
+        if (child.end == position)
+        {
+          Unexpected(data, position);
+        }
+        break;
+      }
+      _position = child.end;
+      return true;
+    }
+  };
+}
+
+namespace Json4CPP
+{
+  JsonLazy::JsonLazy(shared_ptr<JsonLazyDocument const> document, size_t begin, size_t end, size_t container) :
+    _document(move(document)), _begin(begin), _end(end), _container(container)
+  {
+
+  }
+
+  JsonLazy JsonLazy::Index(shared_ptr<JsonLazyDocument> document)
+  {
+    auto data = document->data;
+    auto& containers = document->containers;
+    auto open = vector<size_t>(); // The objects and arrays which are not closed yet
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+      switch (data[i])
+      {
+      case '"':
+        i = StringEnd(data, i);
+        break;
+      case '{':
+      case '[':
+        if (open.size() + 1 >= JsonDefault::MaxDepth)
+        {
+          auto message = "Depth is greater or equal to the maximum "s + to_string(JsonDefault::MaxDepth) + "!"s;
+          throw exception(message.c_str());
+        }
+        open.push_back(containers.size());
+        containers.push_back({ i, npos });
+        break;
+      case '}':
+      case ']':
+        if (open.empty() || data[containers[open.back()].first] != (data[i] == '}' ? '{' : '['))
+        {
+          Unexpected(data, i);
+        }
+        containers[open.back()].second = i;
+        open.pop_back();
+        break;
+      }
+    }
+    if (!open.empty())
+    {
+      Expected(data, data.size(), data[containers[open.back()].first] == '{' ? "',' or '}'" : "',' or ']'");
+    }
+    if (containers.empty() || SkipWhitespace(data, 0) != containers[0].first || SkipWhitespace(data, containers[0].second + 1) != data.size())
+    {
+      // Anything but a single object or array is reported the same way as by Json::Parse
+      Json::Parse(data);
+    }
+    auto [begin, end] = containers[0];
+    return JsonLazy(move(document), begin, end + 1, 0);
+  }
+
+  Json JsonLazy::Materialize() const
+  {
+    // The buffer starts at the beginning of the document, so the positions in the error messages are the same as for Json::Parse
+    auto json = Json();
+    auto handler = JsonDomHandler(json);
+    auto buffer = JsonBuffer<char>(_document->data.substr(0, _end), _begin);
+    JsonLinter::Parse(buffer, handler);
+    return json;
+  }
+
+  JsonLazy JsonLazy::Read(path filePath)
+  {
+    auto document = make_shared<JsonLazyDocument>();
+    document->file = make_unique<JsonFileMapping>(filePath);
+    if (document->file->IsMapped())
+    {
+      document->data = document->file->Data();
+    }
+    else
+    {
+      document->text = ReadAllBytes(filePath);
+      document->data = document->text;
+    }
+    return Index(move(document));
+  }
+
+  JsonLazy JsonLazy::Parse(string_view value)
+  {
+    auto document = make_shared<JsonLazyDocument>();
+    document->text = string(value);
+    document->data = document->text;
+    return Index(move(document));
+  }
+
+  JsonLazy JsonLazy::Parse(wstring_view value)
+  {
+    auto document = make_shared<JsonLazyDocument>();
+    document->text = WString2String(wstring(value));
+    document->data = document->text;
+    return Index(move(document));
+  }
+
+  JsonType JsonLazy::Type() const
+  {
+    switch (_document->data[_begin])
+    {
+    case '{': return JsonType::Object;
+    case '[': return JsonType::Array;
+    case '"': return JsonType::String;
+    case 't':
+    case 'f': return JsonType::Boolean;
+    case 'n': return JsonType::Null;
+    // Integers which do not fit into int64_t are parsed as Real
+    default : return Materialize().Type();
+    }
+  }
+
+  bool JsonLazy::Is(JsonType type) const
+  {
+    return Type() == type;
+  }
+
+  wstring JsonLazy::Dump(uint8_t indentation) const
+  {
+    return Materialize().Dump(indentation);
+  }
+
+  void JsonLazy::VisitKeys(function<void(KEY&&)> const& visitor) const
+  {
+    // Duplicate keys are handled the same way as by Json::Parse, only the first one counts
+    auto seen = unordered_set<KEY>();
+    auto cursor = JsonLazyCursor(*_document, _container);
+    auto child = JsonLazyChild();
+    while (cursor.Next(child))
+    {
+      auto begin = child.key.data() - _document->data.data();
+      auto key = JsonLazy(_document, begin, begin + child.key.size(), npos).Get<wstring>();
+      if (seen.insert(key).second)
+      {
+        visitor(move(key));
+      }
+    }
+  }
+
+  int64_t JsonLazy::Size() const
+  {
+    switch (Type())
+    {
+    case JsonType::Object:
+    {
+      auto size = int64_t(0);
+      VisitKeys([&](KEY&&) { ++size; });
+      return size;
+    }
+    case JsonType::Array :
+    {
+      auto cursor = JsonLazyCursor(*_document, _container);
+      auto child = JsonLazyChild();
+      auto size = int64_t(0);
+      while (cursor.Next(child))
+      {
+        ++size;
+      }
+      return size;
+    }
+    default: throw exception("Size() is only defined for JsonObject and JsonArray!");
+    }
+  }
+
+  vector<KEY> JsonLazy::Keys() const
+  {
+    if (Type() != JsonType::Object)
+    {
+      throw exception("Keys() is only defined for JsonObject!");
+    }
+    auto keys = vector<KEY>();
+    VisitKeys([&](KEY&& key) { keys.push_back(move(key)); });
+    return keys;
+  }
+
+  JsonLazy JsonLazy::operator[](KEY const& key) const
+  {
+    return At(key);
+  }
+
+  JsonLazy JsonLazy::operator[](int64_t const& index) const
+  {
+    return At(index);
+  }
+
+  JsonLazy JsonLazy::At(KEY const& key) const
+  {
+    if (Type() != JsonType::Object)
+    {
+      throw exception("At(KEY key) is only defined for JsonObject!");
+    }
+    // Property names without escapes are compared as they are, only the others have to be parsed
+    auto raw = "\""s + WString2String(key) + "\""s;
+    auto cursor = JsonLazyCursor(*_document, _container);
+    auto child = JsonLazyChild();
+    while (cursor.Next(child))
+    {
+      auto begin = child.key.data() - _document->data.data();
+      if (child.key.find('\\') == npos ? child.key == raw : JsonLazy(_document, begin, begin + child.key.size(), npos).Get<wstring>() == key)
+      {
+        return JsonLazy(_document, child.begin, child.end, child.container);
+      }
+    }
+    auto message = "Key not found: "s + WString2String(key) + "!"s;
+    throw out_of_range(message.c_str());
+  }
+
+  JsonLazy JsonLazy::At(int64_t const& index) const
+  {
+    if (Type() != JsonType::Array)
+    {
+      throw exception("At(int index) is only defined for JsonArray!");
+    }
+    auto cursor = JsonLazyCursor(*_document, _container);
+    auto child = JsonLazyChild();
+    for (auto i = int64_t(0); cursor.Next(child); ++i)
+    {
+      if (i == index)
+      {
+        return JsonLazy(_document, child.begin, child.end, child.container);
+      }
+    }
+    auto message = "Index out of range: "s + to_string(index) + "!"s;
+    throw out_of_range(message.c_str());
+  }
+
+#pragma region Conversion operators
+  JsonLazy::operator Json      () const { return             Materialize(); }
+  JsonLazy::operator nullptr_t () const { return (nullptr_t )Materialize(); }
+  JsonLazy::operator wstring   () const { return (wstring   )Materialize(); }
+  JsonLazy::operator bool      () const { return (bool      )Materialize(); }
+  JsonLazy::operator char      () const { return (char      )Materialize(); }
+  JsonLazy::operator int8_t    () const { return (int8_t    )Materialize(); }
+  JsonLazy::operator uint8_t   () const { return (uint8_t   )Materialize(); }
+  JsonLazy::operator int16_t   () const { return (int16_t   )Materialize(); }
+  JsonLazy::operator uint16_t  () const { return (uint16_t  )Materialize(); }
+  JsonLazy::operator int32_t   () const { return (int32_t   )Materialize(); }
+  JsonLazy::operator uint32_t  () const { return (uint32_t  )Materialize(); }
+  JsonLazy::operator int64_t   () const { return (int64_t   )Materialize(); }
+  JsonLazy::operator uint64_t  () const { return (uint64_t  )Materialize(); }
+  JsonLazy::operator float     () const { return (float     )Materialize(); }
+  JsonLazy::operator double    () const { return (double    )Materialize(); }
+  JsonLazy::operator JsonObject() const { return (JsonObject)Materialize(); }
+  JsonLazy::operator JsonArray () const { return (JsonArray )Materialize(); }
+#pragma endregion
+}
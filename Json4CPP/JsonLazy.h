@@ -0,0 +1,90 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include "JsonType.h"
+#include "Value.h"
+#include "Json.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <filesystem>
+
+namespace Json4CPP
+{
+  namespace Detail
+  {
+    struct JsonLazyDocument;
+  }
+
+  // Read-only view of a UTF-8 encoded document, which is only parsed as far as it is accessed.
+  // Parse and Read make a single pass over the text, which finds the matching closing bracket of every object and array.
+  // At and operator[] skip over whole subtrees through it, and only the values which are converted or dumped are parsed, by JsonLinter.
+  // Only the parts which are reached are validated, an error elsewhere in the document is not reported.
+  // A JsonLazy shares the document with the ones it was reached from, so any of them keeps the text alive.
+  class JSON_API JsonLazy
+  {
+  private:
+#pragma warning(suppress: 4251)
+    std::shared_ptr<Detail::JsonLazyDocument const> _document;
+    size_t _begin;     // Position of the first character of the value
+    size_t _end;       // Position after the last character of the value
+    size_t _container; // Index of the object or array in the document, or npos for other values
+
+    JsonLazy(std::shared_ptr<Detail::JsonLazyDocument const> document, size_t begin, size_t end, size_t container);
+    static JsonLazy Index(std::shared_ptr<Detail::JsonLazyDocument> document);
+    Json Materialize() const;
+    // Calls visitor with the distinct keys of the object, in the order of their first occurrence.
+    void VisitKeys(std::function<void(KEY&&)> const& visitor) const;
+  public:
+    // The text is copied, or mapped in case of a regular file, and indexed. Only JsonObject and JsonArray are valid at the root.
+    static JsonLazy Read (std::filesystem::path filePath);
+    static JsonLazy Parse(std::string_view  value);
+    static JsonLazy Parse(std::wstring_view value);
+
+    JsonType Type() const;
+    bool Is(JsonType type) const;
+
+    std::wstring Dump(uint8_t indentation = 0) const;
+
+    template<typename T>
+    T Get() const
+    {
+      return Materialize().Get<T>();
+    }
+
+    // Like their Json counterparts, but they have to walk the object or array up to the requested value.
+    int64_t Size() const;
+    std::vector<KEY> Keys() const;
+    JsonLazy operator[](KEY     const& key  ) const;
+    JsonLazy operator[](int64_t const& index) const;
+    JsonLazy At        (KEY     const& key  ) const;
+    JsonLazy At        (int64_t const& index) const;
+
+    // Parses the value, and everything below it.
+    explicit operator Json           () const;
+    explicit operator std::nullptr_t () const;
+    explicit operator std::wstring   () const;
+    explicit operator bool           () const;
+    explicit operator char           () const;
+    explicit operator int8_t         () const;
+    explicit operator uint8_t        () const;
+    explicit operator int16_t        () const;
+    explicit operator uint16_t       () const;
+    explicit operator int32_t        () const;
+    explicit operator uint32_t       () const;
+    explicit operator int64_t        () const;
+    explicit operator uint64_t       () const;
+    explicit operator float          () const;
+    explicit operator double         () const;
+    explicit operator JsonObject     () const;
+    explicit operator JsonArray      () const;
+  };
+}
@@ -0,0 +1,128 @@
+#include "stdafx.h"
+
+#include "JsonLinesReader.h"
+#include "JsonDefault.h"
+#include "JsonLinter.h"
+#include "Helper.h"
+
+using namespace std;
+using namespace std::filesystem;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP
+{
+  JsonLinesReader::JsonLinesReader(istream& is, pmr::memory_resource* resource) :
+    _is(is), _resource(resource), _line(0), _record(0), _handler(_root, resource)
+  {
+
+  }
+
+  JsonLinesReader::JsonLinesReader(path filePath, pmr::memory_resource* resource) :
+    _file(make_unique<ifstream>(filePath, ifstream::in | ifstream::binary)), _is(*_file), _resource(resource), _line(0), _record(0), _handler(_root, resource)
+  {
+    if (!*_file)
+    {
+      auto message = "Could not open file: "s + filePath.string() + "!"s;
+      throw exception(message.c_str());
+    }
+  }
+
+  bool JsonLinesReader::ReadLine(string& text)
+  {
+    while (getline(_is, text))
+    {
+      ++_line;
+      if (!text.empty() && text.back() == '\r')
+      {
+        text.pop_back();
+      }
+      if (text.find_first_not_of(" \t\n\v\f\r"sv) != string::npos)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void JsonLinesReader::Parse(string_view text, uint64_t line, JsonDomHandler& handler)
+  {
+    try
+    {
+      JsonLinter::Read(text, handler);
+    }
+    catch (exception const& e)
+    {
+      handler.Reset();
+      // The record is a single line, so only the line of the position has to be replaced
+      auto message = string(e.what());
+      auto prefix = " at position Line: "s;
+      if (auto position = message.rfind(prefix + "1 Column: "s); position != string::npos)
+      {
+        message.replace(position + prefix.size(), 1, to_string(line));
+      }
+      else
+      {
+        message = "Line: "s + to_string(line) + " "s + message;
+      }
+      throw exception(message.c_str());
+    }
+    handler.Reset();
+  }
+
+  bool JsonLinesReader::Read(Json& json)
+  {
+    if (!ReadLine(_text))
+    {
+      return false;
+    }
+    _record = _line;
+    Parse(_text, _line, _handler);
+    json = move(_root);
+    return true;
+  }
+
+  size_t JsonLinesReader::Read(vector<Json>& records, size_t count)
+  {
+    auto size = size_t(0);
+    auto bytes = size_t(0);
+    for (; size < count; ++size)
+    {
+      if (size == _batch.size())
+      {
+        _batch.emplace_back();
+      }
+      auto& [line, text] = _batch[size];
+      if (!ReadLine(text))
+      {
+        break;
+      }
+      line = _line;
+      bytes += text.size();
+    }
+    records.clear();
+    records.resize(size);
+    if (size == 0)
+    {
+      return 0;
+    }
+    _record = _batch[size - 1].first;
+
+    // The records are split into parts of the same count, each part parsed by one thread in order
+    auto threads = IsSynchronized(_resource) ? min({ (size_t)JsonDefault::Threads, bytes / JsonLinter::ParallelPartSize, size }) : 1;
+    threads = max<size_t>(threads, 1);
+    ParallelFor(threads, [&](size_t part)
+    {
+      for (auto i = size * part / threads; i < size * (part + 1) / threads; ++i)
+      {
+        auto handler = JsonDomHandler(records[i], _resource);
+        Parse(_batch[i].second, _batch[i].first, handler);
+      }
+    });
+    return size;
+  }
+
+  uint64_t JsonLinesReader::Line() const
+  {
+    return _record;
+  }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include "Json.h"
+#include "JsonDomHandler.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <istream>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <filesystem>
+#include <cstdint>
+
+namespace Json4CPP
+{
+  // Reads JSON Lines (NDJSON): UTF-8 encoded text with one JSON value on each line, the lines separated by \n or \r\n.
+  // Every line is read into the same buffer and parsed from memory by JsonLinter, building the record with the same handler.
+  // Any value is a valid record, not only JsonObject and JsonArray. Lines which only contain whitespace are skipped.
+  class JSON_API JsonLinesReader
+  {
+  private:
+#pragma warning(suppress: 4251)
+    std::unique_ptr<std::ifstream> _file; // Only if the reader opened the file itself
+    std::istream& _is;
+    std::pmr::memory_resource* _resource;
+    uint64_t _line;   // Number of the lines read so far
+    uint64_t _record; // Number of the line of the last record
+#pragma warning(suppress: 4251)
+    std::string _text;
+#pragma warning(suppress: 4251)
+    std::vector<std::pair<uint64_t, std::string>> _batch; // The lines of the last batch with their numbers, kept to reuse their buffers
+    Json _root;
+    Detail::JsonDomHandler _handler;
+
+    // Reads the next line which is not blank into text, returns false at the end of the input.
+    bool ReadLine(std::string& text);
+    // Parses a record, errors are thrown with the position in the whole input.
+    static void Parse(std::string_view text, uint64_t line, Detail::JsonDomHandler& handler);
+  public:
+    explicit JsonLinesReader(std::istream& is, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    explicit JsonLinesReader(std::filesystem::path filePath, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    JsonLinesReader(JsonLinesReader const&) = delete;
+    JsonLinesReader& operator=(JsonLinesReader const&) = delete;
+
+    // Reads the next record into json, returns false at the end of the input. After an error the next line can be read.
+    bool Read(Json& json);
+    // Reads up to count records into records, which is resized to their number, 0 at the end of the input.
+    // The lines are parsed on up to JsonDefault::Threads threads, if there are at least JsonLinter::ParallelPartSize bytes
+    // for each of them, and resource can be used by all of them (see IsSynchronized). After an error the next batch can be read.
+    size_t Read(std::vector<Json>& records, size_t count);
+
+    // Returns the number of the line of the last record, starting from 1, or 0 before the first one.
+    uint64_t Line() const;
+  };
+}
@@ -0,0 +1,48 @@
+#include "stdafx.h"
+
+#include "JsonLinesWriter.h"
+#include "JsonWriter.h"
+
+using namespace std;
+using namespace std::filesystem;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP
+{
+  JsonLinesWriter::JsonLinesWriter(ostream& os) : _os(os)
+  {
+    _buffer.reserve(JsonWriter::BufferSize);
+  }
+
+  JsonLinesWriter::JsonLinesWriter(path filePath) : _file(make_unique<ofstream>(filePath, ofstream::out | ofstream::binary)), _os(*_file)
+  {
+    if (!*_file)
+    {
+      auto message = "Could not open file: "s + filePath.string() + "!"s;
+      throw exception(message.c_str());
+    }
+    _buffer.reserve(JsonWriter::BufferSize);
+  }
+
+  JsonLinesWriter::~JsonLinesWriter()
+  {
+    _os.write(_buffer.data(), _buffer.size());
+  }
+
+  void JsonLinesWriter::Write(Json const& json)
+  {
+    JsonWriter::Append(_buffer, json, 0) += '\n';
+    if (_buffer.size() >= JsonWriter::BufferSize)
+    {
+      _os.write(_buffer.data(), _buffer.size());
+      _buffer.clear();
+    }
+  }
+
+  void JsonLinesWriter::Flush()
+  {
+    _os.write(_buffer.data(), _buffer.size());
+    _buffer.clear();
+    _os.flush();
+  }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include "Json.h"
+
+#include <string>
+#include <ostream>
+#include <fstream>
+#include <memory>
+#include <filesystem>
+
+namespace Json4CPP
+{
+  // Writes JSON Lines (NDJSON): every record is written UTF-8 encoded without indentation, the same as Dump(0), followed by \n.
+  // The records are appended to the same buffer, which is written to the stream whenever it grows above JsonWriter::BufferSize,
+  // so once it reached that size, writing a record does not allocate.
+  class JSON_API JsonLinesWriter
+  {
+  private:
+#pragma warning(suppress: 4251)
+    std::unique_ptr<std::ofstream> _file; // Only if the writer opened the file itself
+    std::ostream& _os;
+#pragma warning(suppress: 4251)
+    std::string _buffer;
+  public:
+    explicit JsonLinesWriter(std::ostream& os);
+    explicit JsonLinesWriter(std::filesystem::path filePath);
+    JsonLinesWriter(JsonLinesWriter const&) = delete;
+    JsonLinesWriter& operator=(JsonLinesWriter const&) = delete;
+    // Writes the rest of the buffer to the stream.
+    ~JsonLinesWriter();
+
+    void Write(Json const& json);
+    // Writes the buffer to the stream, and flushes the stream.
+    void Flush();
+  };
+}
@@ -1,6 +1,10 @@
 #include "stdafx.h"
 
 #include "JsonLinter.h"
+#include "JsonBuffer.h"
+#include "JsonStreamBuffer.h"
+#include "JsonWideStream.h"
+#include "JsonStructuralIndex.h"
 #include "JsonDefault.h"
 #include "Helper.h"
 
@@ -8,10 +12,29 @@ using namespace std;
 
 namespace Json4CPP::Detail
 {
-  nullptr_t JsonLinter::ParseNull(wistream& is)
+  // Collects the parsed values as tokens, this is what Read returns when no handler is given.
+  class JsonTokenHandler : public JsonHandler
+  {
+  public:
+    std::deque<TOKEN> tokens;
+
+    void Null        (               ) override { tokens.push_back({ JsonTokenType::Null        , nullptr     }); }
+    void String      (wstring&& value) override { tokens.push_back({ JsonTokenType::String      , move(value) }); }
+    void Boolean     (bool      value) override { tokens.push_back({ JsonTokenType::Boolean     , value       }); }
+    void Real        (double    value) override { tokens.push_back({ JsonTokenType::Real        , value       }); }
+    void Integer     (int64_t   value) override { tokens.push_back({ JsonTokenType::Integer     , value       }); }
+    void PropertyName(wstring&& value) override { tokens.push_back({ JsonTokenType::PropertyName, move(value) }); }
+    void StartObject (               ) override { tokens.push_back({ JsonTokenType::StartObject , L"{"s       }); }
+    void EndObject   (               ) override { tokens.push_back({ JsonTokenType::EndObject   , L"}"s       }); }
+    void StartArray  (               ) override { tokens.push_back({ JsonTokenType::StartArray  , L"["s       }); }
+    void EndArray    (               ) override { tokens.push_back({ JsonTokenType::EndArray    , L"]"s       }); }
+  };
+
+  template<typename Stream>
+  nullptr_t JsonLinter::ParseNull(Stream& is)
   {
     auto expected = L"null"s;
-    streampos pos;
+    decltype(is.tellg()) pos{};
     for (int i = 0; i < 4; ++i)
     {
       auto c = is.get();
@@ -25,7 +48,8 @@ namespace Json4CPP::Detail
     return nullptr;
   }
 
-  wstring JsonLinter::ParseString(wistream& is)
+  template<typename Stream>
+  wstring JsonLinter::ParseString(Stream& is)
   {
     auto text = L""s;
     // A string must start with a quote
@@ -38,9 +62,14 @@ namespace Json4CPP::Detail
       }
       else
       {
-        // Read the characters until the closing quote
-        while (is.peek() != L'\"' && !is.eof())
+        // Read the characters until the closing quote, the buffers copy the runs without escapes at once
+        while (true)
         {
+          is.ReadPlain(text);
+          if (is.peek() == L'\"' || is.eof())
+          {
+            break;
+          }
           auto c = is.get();
           if (c == L'\\')
           {
@@ -85,7 +114,7 @@ namespace Json4CPP::Detail
             }
             }
           }
-          else if (!iswcntrl(c))
+          else if (c > 0x1F && (c < 0x7F || c > 0x9F))
           {
             text.push_back(c);
           }
@@ -116,12 +145,13 @@ namespace Json4CPP::Detail
     return text;
   }
 
-  bool JsonLinter::ParseBoolean(wistream& is)
+  template<typename Stream>
+  bool JsonLinter::ParseBoolean(Stream& is)
   {
     auto expected = is.peek() == L't' ? L"true"s : is.peek() == L'f' ? L"false"s : L""s;
     if (!expected.empty())
     {
-      streampos pos;
+      decltype(is.tellg()) pos{};
       for (int i = 0; i < expected.size(); ++i)
       {
         auto c = is.get();
@@ -138,21 +168,80 @@ namespace Json4CPP::Detail
     throw exception(message.c_str());
   }
 
-  NUMBER JsonLinter::ParseNumber(wistream& is)
+  // Converts the validated text of a number, see ParseNumber.
+  static NUMBER ToNumber(char const* first, char const* last, bool isInteger)
+  {
+    if (isInteger)
+    {
+      int64_t number;
+      if (from_chars(first, last, number).ec == errc())
+      {
+        return number;
+      }
+      // Integers outside of the range of int64_t are kept as a double instead of being clamped
+    }
+    double number;
+    if (from_chars(first, last, number).ec == errc::result_out_of_range)
+    {
+      // Denormals are parsed by from_chars, so the number is either too large or too small for a double, which one depends
+      // on the decimal exponent of its first significant digit. It underflows to zero, but overflows to the largest double
+      // instead of infinity, which could not be written as JSON again.
+      auto e = find_if(first, last, [](char c) { return c == 'e' || c == 'E'; });
+      auto point = find(first, e, '.');
+      auto digit = find_if(first, e, [](char c) { return '1' <= c && c <= '9'; });
+      auto exponent = int64_t(0);
+      if (e != last)
+      {
+        auto sign = e[1] == '+' || e[1] == '-' ? e + 1 : nullptr;
+        if (from_chars(sign ? sign + 1 : e + 1, last, exponent).ec == errc::result_out_of_range)
+        {
+          exponent = numeric_limits<int64_t>::max() / 2;
+        }
+        if (sign && *sign == '-')
+        {
+          exponent = -exponent;
+        }
+      }
+      exponent += digit < point ? point - digit : point - digit + 1;
+      number = copysign(digit != e && exponent > 0 ? numeric_limits<double>::max() : 0.0, *first == '-' ? -1.0 : 1.0);
+    }
+    return number;
+  }
+
+  template<typename Stream>
+  NUMBER JsonLinter::ParseNumber(Stream& is)
   {
     auto isInteger = true;
-    wstring text;
+    // The characters of the number are validated here and collected as ASCII for from_chars.
+    // Usual numbers fit into the buffer on the stack, only longer ones are moved to longText.
+    char buffer[64];
+    auto size = size_t(0);
+    auto longText = string();
+    auto append = [&](typename Stream::int_type c)
+    {
+      if (size < sizeof(buffer))
+      {
+        buffer[size] = (char)c;
+      }
+      else
+      {
+        if (longText.empty()) longText.assign(buffer, size);
+        longText.push_back((char)c);
+      }
+      ++size;
+    };
+    auto isDigit = [](typename Stream::int_type c) { return L'0' <= c && c <= L'9'; };
 
     // Can start with '-'
     if (is.peek() == L'-')
     {
-      text.push_back(is.get());
+      append(is.get());
     }
 
     // Either continues with '0'
     if (is.peek() == L'0')
     {
-      text.push_back(is.get());
+      append(is.get());
       if (L'0' <= is.peek() && is.peek() <= L'9' || is.peek() == L'x')
       {
         auto message = "Unexpected '0' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
@@ -163,9 +252,9 @@ namespace Json4CPP::Detail
     else if (L'1' <= is.peek() && is.peek() <= L'9')
     {
       // And then in that case it can continue with zero or more digit
-      while (iswdigit(is.peek()))
+      while (isDigit(is.peek()))
       {
-        text.push_back(is.get());
+        append(is.get());
       }
     }
     // Else it's not a number
@@ -180,12 +269,12 @@ namespace Json4CPP::Detail
     if (is.peek() == L'.')
     {
       isInteger = false;
-      text.push_back(is.get());
+      append(is.get());
       // And then it contains at least one digit
       auto hasAtLeastOneDigit = false;
-      while (iswdigit(is.peek()))
+      while (isDigit(is.peek()))
       {
-        text.push_back(is.get());
+        append(is.get());
         hasAtLeastOneDigit = true;
       }
       if (!hasAtLeastOneDigit)
@@ -200,17 +289,17 @@ namespace Json4CPP::Detail
     if (is.peek() == L'e' || is.peek() == L'E')
     {
       isInteger = false;
-      text.push_back(is.get());
+      append(is.get());
       // And then it can contain either '+' or '-'
       if (is.peek() == L'+' || is.peek() == L'-')
       {
-        text.push_back(is.get());
+        append(is.get());
       }
       // And then it contains at least one digit
       auto hasAtLeastOneDigit = false;
-      while (iswdigit(is.peek()))
+      while (isDigit(is.peek()))
       {
-        text.push_back(is.get());
+        append(is.get());
         hasAtLeastOneDigit = true;
       }
       if (!hasAtLeastOneDigit)
@@ -221,34 +310,102 @@ namespace Json4CPP::Detail
       }
     }
 
-    if (isInteger)
-    {
-      int64_t number;
-      wstringstream(text) >> number;
-      return number;
-    }
-    else
-    {
-      double number;
-      wstringstream(text) >> number;
-      return number;
-    }
+    auto first = longText.empty() ? buffer : longText.data();
+    return ToNumber(first, first + size, isInteger);
   }
 
-  void JsonLinter::ParseObject(wistream& is, std::deque<TOKEN>& tokens, uint8_t depth)
+  template<typename Stream>
+  bool JsonLinter::Next(Stream& is, JsonLinterState& state, JsonHandler& handler)
   {
-    if (depth >= JsonDefault::MaxDepth)
+    using Step = JsonLinterState::Step;
+    // After a value, the next step depends on the container it is in
+    auto afterValue = [&]()
     {
-      auto message = "Depth is greater or equal to the maximum "s + to_string(JsonDefault::MaxDepth) + "!"s;
-      throw exception(message.c_str());
-    }
-    if (is.peek() == L'{')
+      state.step = state.containers.empty()                              ? Step::End        :
+                   state.containers.back() == JsonTokenType::StartObject ? Step::ObjectNext :
+                                                                           Step::ArrayNext;
+    };
+    while (true)
     {
-      tokens.push_back({ JsonTokenType::StartObject, L""s + (wchar_t)is.get() });
-      is >> ws;
-      if (is.peek() != L'}')
+      switch (state.step)
       {
-        tokens.push_back({ JsonTokenType::PropertyName, ParseString(is) });
+      case Step::Value:
+        is >> ws;
+        switch (is.peek())
+        {
+        case L'n':
+          ParseNull(is);
+          handler.Null();
+          afterValue();
+          return true;
+
+        case L'\"':
+          handler.String(ParseString(is));
+          afterValue();
+          return true;
+
+        case L't':
+        case L'f':
+          handler.Boolean(ParseBoolean(is));
+          afterValue();
+          return true;
+
+        case L'-':
+        case L'0':
+        case L'1':
+        case L'2':
+        case L'3':
+        case L'4':
+        case L'5':
+        case L'6':
+        case L'7':
+        case L'8':
+        case L'9':
+          visit(Overload{
+            [&](double  const& value) { handler.Real   (value); },
+            [&](int64_t const& value) { handler.Integer(value); }
+          }, ParseNumber(is));
+          afterValue();
+          return true;
+
+        case L'{':
+        case L'[':
+        {
+          if (state.containers.size() + 1 >= JsonDefault::MaxDepth)
+          {
+            auto message = "Depth is greater or equal to the maximum "s + to_string(JsonDefault::MaxDepth) + "!"s;
+            throw exception(message.c_str());
+          }
+          auto isObject = is.get() == L'{';
+          state.containers.push_back(isObject ? JsonTokenType::StartObject : JsonTokenType::StartArray);
+          state.step = isObject ? Step::ObjectFirst : Step::ArrayFirst;
+          isObject ? handler.StartObject() : handler.StartArray();
+          return true;
+        }
+
+        default:
+        {
+          is.get();
+          auto message = "Expected one of the following characters: 'n', '\"', 't', 'f', '-', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '{' or '[' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
+          throw exception(message.c_str());
+        }
+        }
+
+      case Step::ObjectFirst:
+        is >> ws;
+        if (is.peek() != L'}')
+        {
+          state.step = Step::Property;
+          continue;
+        }
+        is.get();
+        state.containers.pop_back();
+        afterValue();
+        handler.EndObject();
+        return true;
+
+      case Step::Property:
+        handler.PropertyName(ParseString(is));
         is >> ws;
         if (is.get() == L':')
         {
@@ -259,79 +416,67 @@ namespace Json4CPP::Detail
           auto message = "Expected ':' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
           throw exception(message.c_str());
         }
-        Read(is, tokens, depth);
+        state.step = Step::Value;
+        return true;
+
+      case Step::ObjectNext:
         is >> ws;
-        while (is.peek() == L',')
+        if (is.peek() == L',')
         {
           is.get();
           is >> ws;
-          tokens.push_back({ JsonTokenType::PropertyName, ParseString(is) });
-          is >> ws;
-          if (is.get() == L':')
-          {
-            is >> ws;
-          }
-          else
-          {
-            auto message = "Expected ':' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
-            throw exception(message.c_str());
-          }
-          Read(is, tokens, depth);
-          is >> ws;
+          state.step = Step::Property;
+          continue;
         }
         if (is.peek() == L'}')
         {
-          tokens.push_back({ JsonTokenType::EndObject, L""s + (wchar_t)is.get() });
+          is.get();
+          state.containers.pop_back();
+          afterValue();
+          handler.EndObject();
+          return true;
         }
         else
         {
           auto message = "Expected ',' or '}' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
           throw exception(message.c_str());
         }
-      }
-      else
-      {
-        tokens.push_back({ JsonTokenType::EndObject, L""s + (wchar_t)is.get() });
-      }
-    }
-    else
-    {
-      auto message = "Expected '{' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
-      throw exception(message.c_str());
-    }
-  }
 
-  void JsonLinter::ParseArray(wistream& is, std::deque<TOKEN>& tokens, uint8_t depth)
-  {
-    if (depth >= JsonDefault::MaxDepth)
-    {
-      auto message = "Depth is greater or equal to the maximum "s + to_string(JsonDefault::MaxDepth) + "!"s;
-      throw exception(message.c_str());
-    }
-    if (is.peek() == L'[')
-    {
-      tokens.push_back({ JsonTokenType::StartArray, L""s + (wchar_t)is.get() });
-      is >> ws;
-      if (is.peek() == L',')
-      {
+      case Step::ArrayFirst:
+        is >> ws;
+        if (is.peek() == L',')
+        {
+          is.get();
+          auto message = "Unexpected ',' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
+          throw exception(message.c_str());
+        }
+        if (is.peek() != L']')
+        {
+          state.step = Step::Value;
+          continue;
+        }
         is.get();
-        auto message = "Unexpected ',' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
-        throw exception(message.c_str());
-      }
-      if (is.peek() != L']')
-      {
-        Read(is, tokens, depth);
+        state.containers.pop_back();
+        afterValue();
+        handler.EndArray();
+        return true;
+
+      case Step::ArrayNext:
         is >> ws;
-        while (is.peek() == L',')
+        if (is.peek() == L',')
         {
           is.get();
           is >> ws;
-          Read(is, tokens, depth);
-          is >> ws;
+          state.step = Step::Value;
+          continue;
         }
         if (is.peek() == L']')
         {
-          tokens.push_back({ JsonTokenType::EndArray, L""s + (wchar_t)is.get() });
+          is.get();
+          state.containers.pop_back();
+          afterValue();
+          handler.EndArray();
+          return true;
         }
         else
         {
@@ -339,72 +484,423 @@ namespace Json4CPP::Detail
           auto message = "Expected ',' or ']' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
           throw exception(message.c_str());
         }
+
+      case Step::End:
+      {
+        is >> ws;
+        if (is.peek(), is.eof())
+        {
+          state.step = Step::Done;
+          return false;
+        }
+        auto c = WString2String(L""s + (wchar_t)is.get());
+        auto message = "Unexpected '"s + c + "' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
+        throw exception(message.c_str());
       }
-      else
+
+      case Step::Done:
+      default:
+        return false;
+      }
+    }
+  }
+
+  // Reads the number at position into buffer the same way as ParseNumber, and returns its length.
+  // Returns 0 if it is not valid or does not fit into buffer, then ParseNumber has to read it for the error or the long text.
+  template<typename Char>
+  static size_t ScanNumber(basic_string_view<Char> value, size_t position, char (&buffer)[64], bool& isInteger)
+  {
+    auto current = position;
+    auto is = [&](char c) { return current < value.size() && value[current] == c; };
+    auto isDigit = [&]() { return current < value.size() && L'0' <= value[current] && value[current] <= L'9'; };
+    auto digits = [&]()
+    {
+      auto first = current;
+      while (isDigit())
       {
-        tokens.push_back({ JsonTokenType::EndArray, L""s + (wchar_t)is.get() });
+        ++current;
       }
+      return current != first;
+    };
+    if (is('-'))
+    {
+      ++current;
     }
-    else
+    if (is('0'))
     {
-      auto message = "Expected '[' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
-      throw exception(message.c_str());
+      ++current;
+      if (isDigit() || is('x'))
+      {
+        return 0;
+      }
+    }
+    else if (!digits())
+    {
+      return 0;
+    }
+    if (is('.'))
+    {
+      isInteger = false;
+      ++current;
+      if (!digits())
+      {
+        return 0;
+      }
     }
+    if (is('e') || is('E'))
+    {
+      isInteger = false;
+      ++current;
+      if (is('+') || is('-'))
+      {
+        ++current;
+      }
+      if (!digits())
+      {
+        return 0;
+      }
+    }
+    auto length = current - position;
+    if (length > sizeof(buffer))
+    {
+      return 0;
+    }
+    for (size_t i = 0; i < length; ++i)
+    {
+      buffer[i] = (char)value[position + i];
+    }
+    return length;
   }
 
-  void JsonLinter::Read(wistream& is, std::deque<TOKEN>& tokens, uint8_t depth)
+  template<typename Char>
+  void JsonLinter::WalkIndex(basic_string_view<Char> value, vector<uint32_t> const& positions, size_t first, size_t last, JsonLinterState& state, JsonHandler& handler)
   {
-    is >> ws;
-    switch (is.peek())
+    using Step = JsonLinterState::Step;
+    // token is the position of the next character which is not whitespace, it is the entry of the index at next,
+    // except after a value which ended before a character that does not start a token, that is always an error
+    auto next = first;
+    auto token = next < positions.size() ? (size_t)positions[next] : value.size();
+    auto peek = [&]() { return token < value.size() ? (wint_t)(make_unsigned_t<Char>)value[token] : WEOF; };
+    auto advance = [&]() { token = ++next < positions.size() ? (size_t)positions[next] : value.size(); };
+    // Positions the buffer, which the values are read from, at the token. The text before it is there for the positions in the error messages.
+    auto at = [&]() { return JsonBuffer<Char>(value, token); };
+    // Continues after a value which ends before position, the whitespace is skipped the same way as between the tokens of the index
+    auto skip = [&](size_t position)
     {
-    case L'n':
-      tokens.push_back({ JsonTokenType::Null   , ParseNull   (is) });
-      break;
+      token = position;
+      while (token < value.size() && (value[token] == ' ' || (0x09 <= value[token] && value[token] <= 0x0D)))
+      {
+        ++token;
+      }
+      while (next < positions.size() && positions[next] < token)
+      {
+        ++next;
+      }
+    };
+    // The same errors at the same positions as in Next, which either gets the offending character or only peeks at it
+    auto fail = [&](string const& text, bool consume)
+    {
+      auto is = at();
+      consume ? is.get() : is.peek();
+      auto message = text + " at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
+      throw exception(message.c_str());
+    };
+    auto afterValue = [&]()
+    {
+      state.step = state.containers.empty()                              ? Step::End        :
+                   state.containers.back() == JsonTokenType::StartObject ? Step::ObjectNext :
+                                                                           Step::ArrayNext;
+    };
+    // Valid numbers and literals, and strings without escapes are read directly from the text, as long as UTF-8 ones are ASCII.
+    // Everything else is read by the functions above from a buffer, which report the same errors as with the other backend.
+    auto literal = [&](char const* text)
+    {
+      for (auto current = token; *text; ++text, ++current)
+      {
+        if (current == value.size() || value[current] != *text)
+        {
+          return false;
+        }
+      }
+      return true;
+    };
+    auto readString = [&]()
+    {
+      if (peek() == L'\"')
+      {
+        auto first = value.data() + token + 1;
+        auto last = first + ScanString(first, value.size() - token - 1);
+        if (last != value.data() + value.size() && *last == '"')
+        {
+          auto text = wstring(first, last);
+          skip(last + 1 - value.data());
+          return text;
+        }
+      }
+      auto is = at();
+      auto text = ParseString(is);
+      skip(is.position());
+      return text;
+    };
+    auto readNumber = [&]()
+    {
+      char buffer[64];
+      auto isInteger = true;
+      if (auto length = ScanNumber(value, token, buffer, isInteger))
+      {
+        skip(token + length);
+        return ToNumber(buffer, buffer + length, isInteger);
+      }
+      auto is = at();
+      auto number = ParseNumber(is);
+      skip(is.position());
+      return number;
+    };
+    while (state.step != Step::Done)
+    {
+      switch (state.step)
+      {
+      case Step::Value:
+        switch (peek())
+        {
+        case L'n':
+          if (!literal("null"))
+          {
+            auto is = at();
+            ParseNull(is);
+          }
+          handler.Null();
+          skip(token + 4);
+          break;
 
-    case L'\"':
-      tokens.push_back({ JsonTokenType::String , ParseString (is) });
-      break;
+        case L'\"':
+          handler.String(readString());
+          break;
 
-    case L't':
-    case L'f':
-      tokens.push_back({ JsonTokenType::Boolean, ParseBoolean(is) });
-      break;
+        case L't':
+        case L'f':
+        {
+          auto isTrue = peek() == L't';
+          if (!literal(isTrue ? "true" : "false"))
+          {
+            auto is = at();
+            ParseBoolean(is);
+          }
+          handler.Boolean(isTrue);
+          skip(token + (isTrue ? 4 : 5));
+          break;
+        }
 
-    case L'-':
-    case L'0':
-    case L'1':
-    case L'2':
-    case L'3':
-    case L'4':
-    case L'5':
-    case L'6':
-    case L'7':
-    case L'8':
-    case L'9':
-      visit(Overload{
-        [&](double  const& value) { tokens.push_back({ JsonTokenType::Real    , value }); },
-        [&](int64_t const& value) { tokens.push_back({ JsonTokenType::Integer , value }); }
-      }, ParseNumber(is));
-      break;
+        case L'-':
+        case L'0':
+        case L'1':
+        case L'2':
+        case L'3':
+        case L'4':
+        case L'5':
+        case L'6':
+        case L'7':
+        case L'8':
+        case L'9':
+          visit(Overload{
+            [&](double  const& value) { handler.Real   (value); },
+            [&](int64_t const& value) { handler.Integer(value); }
+          }, readNumber());
+          break;
 
-    case L'{':
-      ParseObject(is, tokens, depth + 1);
-      break;
+        case L'{':
+        case L'[':
+        {
+          if (state.containers.size() + 1 >= JsonDefault::MaxDepth)
+          {
+            auto message = "Depth is greater or equal to the maximum "s + to_string(JsonDefault::MaxDepth) + "!"s;
+            throw exception(message.c_str());
+          }
+          auto isObject = peek() == L'{';
+          advance();
+          state.containers.push_back(isObject ? JsonTokenType::StartObject : JsonTokenType::StartArray);
+          state.step = isObject ? Step::ObjectFirst : Step::ArrayFirst;
+          isObject ? handler.StartObject() : handler.StartArray();
+          continue;
+        }
 
-    case L'[':
-      ParseArray(is, tokens, depth + 1);
-      break;
+        default:
+          fail("Expected one of the following characters: 'n', '\"', 't', 'f', '-', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '{' or '['"s, true);
+        }
+        afterValue();
+        break;
 
-    default:
+      case Step::ObjectFirst:
+        if (peek() != L'}')
+        {
+          state.step = Step::Property;
+          continue;
+        }
+        advance();
+        state.containers.pop_back();
+        afterValue();
+        handler.EndObject();
+        break;
+
+      case Step::Property:
+        handler.PropertyName(readString());
+        if (peek() != L':')
+        {
+          fail("Expected ':'"s, true);
+        }
+        advance();
+        state.step = Step::Value;
+        break;
+
+      case Step::ObjectNext:
+        if (peek() == L',')
+        {
+          advance();
+          state.step = Step::Property;
+          continue;
+        }
+        if (peek() != L'}')
+        {
+          fail("Expected ',' or '}'"s, false);
+        }
+        advance();
+        state.containers.pop_back();
+        afterValue();
+        handler.EndObject();
+        break;
+
+      case Step::ArrayFirst:
+        if (peek() == L',')
+        {
+          fail("Unexpected ','"s, true);
+        }
+        if (peek() != L']')
+        {
+          state.step = Step::Value;
+          continue;
+        }
+        advance();
+        state.containers.pop_back();
+        afterValue();
+        handler.EndArray();
+        break;
+
+      case Step::ArrayNext:
+        if (peek() == L',')
+        {
+          // A part of ReadParts ends at the comma of the root array at last
+          if (next == last && state.containers.size() == 1)
+          {
+            return;
+          }
+          advance();
+          state.step = Step::Value;
+          continue;
+        }
+        if (peek() != L']')
+        {
+          fail("Expected ',' or ']'"s, true);
+        }
+        advance();
+        state.containers.pop_back();
+        afterValue();
+        handler.EndArray();
+        break;
+
+      case Step::End:
+      {
+        if (token == value.size())
+        {
+          state.step = Step::Done;
+          break;
+        }
+        auto is = at();
+        auto c = WString2String(L""s + (wchar_t)is.get());
+        auto message = "Unexpected '"s + c + "' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
+        throw exception(message.c_str());
+      }
+
+      default:
+        state.step = Step::Done;
+        break;
+      }
+    }
+  }
+
+  template<typename Char>
+  bool JsonLinter::ParseIndexed(basic_string_view<Char> value, JsonHandler& handler)
+  {
+    auto positions = vector<uint32_t>();
+    if (!JsonStructuralIndex::Build(value, positions))
     {
-      is.get();
-      auto message = "Expected one of the following characters: 'n', '\"', 't', 'f', '-', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '{' or '[' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
-      throw exception(message.c_str());
+      return false;
     }
+    auto state = JsonLinterState();
+    WalkIndex(value, positions, 0, positions.size(), state, handler);
+    return true;
+  }
+
+  template<typename Char>
+  bool JsonLinter::ReadParts(basic_string_view<Char> value, vector<JsonHandler*> const& handlers)
+  {
+    auto positions = vector<uint32_t>();
+    if (handlers.empty() || !JsonStructuralIndex::Build(value, positions) || positions.empty() || value[positions[0]] != '[')
+    {
+      return false;
     }
+    // The parts end at the first comma of the root array after an equal share of the text
+    auto splits = vector<size_t>();
+    auto depth = 0;
+    for (size_t i = 0; i < positions.size() && depth >= 0 && splits.size() + 1 < handlers.size(); ++i)
+    {
+      switch (value[positions[i]])
+      {
+      case '{':
+      case '[':
+        ++depth;
+        break;
+      case '}':
+      case ']':
+        depth = depth == 1 ? -1 : depth - 1;
+        break;
+      case ',':
+        if (depth == 1 && positions[i] >= value.size() / handlers.size() * (splits.size() + 1))
+        {
+          splits.push_back(i);
+        }
+        break;
+      }
+    }
+
+    // Each part is walked as the rest of the root array, until the comma it ends at. A part can only run past it if there
+    // is an error before, which is then thrown by that part, as it follows the same steps as the walk of the whole text would.
+    // So the first error in the text is the one of the first part which has an error.
+    auto parts = splits.size() + 1;
+    ParallelFor(parts, [&](size_t part)
+    {
+      auto& handler = *handlers[part];
+      auto state = JsonLinterState();
+      if (part > 0)
+      {
+        state.containers.push_back(JsonTokenType::StartArray);
+        handler.StartArray();
+      }
+      WalkIndex(value, positions, part > 0 ? splits[part - 1] + 1 : 0, part < splits.size() ? splits[part] : positions.size(), state, handler);
+      if (state.step != JsonLinterState::Step::Done)
+      {
+        handler.EndArray();
+      }
+    });
+    // There may be fewer elements than handlers
+    for (size_t part = parts; part < handlers.size(); ++part)
+    {
+      handlers[part]->StartArray();
+      handlers[part]->EndArray();
+    }
+    return true;
   }
 
-  wostream& JsonLinter::WriteNumber(wostream& os, NUMBER number)
+  char* JsonLinter::FormatNumber(char* buffer, NUMBER number)
   {
     enum class Type { IntegerI, IntegerD, Float, Double };
     Type type;
@@ -412,21 +908,24 @@ namespace Json4CPP::Detail
       [&](double  const& value) { type = (int64_t)value == value ? Type::IntegerD : (float)value == value ? Type::Float : Type::Double; },
       [&](int64_t const& value) { type = Type::IntegerI; }
     }, number);
-    auto convertedNumber = string();
-    auto conversionResult = to_chars_result{ nullptr, errc::value_too_large };
-    for (int count = 10; conversionResult.ec == errc::value_too_large; count = count * 2)
+    auto end = buffer + NumberSize;
+    switch (type)
     {
-      convertedNumber = string(count, ' ');
-      switch (type)
-      {
-      case Type::IntegerI: conversionResult = to_chars(convertedNumber.data(), convertedNumber.data() + convertedNumber.size(),          get<int64_t>(number)); break;
-      case Type::IntegerD: conversionResult = to_chars(convertedNumber.data(), convertedNumber.data() + convertedNumber.size(), (int64_t)get<double >(number)); break;
-      case Type::Float   : conversionResult = to_chars(convertedNumber.data(), convertedNumber.data() + convertedNumber.size(), (float  )get<double >(number)); break;
-      case Type::Double  : conversionResult = to_chars(convertedNumber.data(), convertedNumber.data() + convertedNumber.size(),          get<double >(number)); break;
-      }
+    case Type::IntegerI: return to_chars(buffer, end,          get<int64_t>(number)).ptr;
+    case Type::IntegerD: return to_chars(buffer, end, (int64_t)get<double >(number)).ptr;
+    case Type::Float   : return to_chars(buffer, end, (float  )get<double >(number)).ptr;
+    case Type::Double  :
+    default            : return to_chars(buffer, end,          get<double >(number)).ptr;
     }
-    os << WidenString(string(convertedNumber.data(), conversionResult.ptr));
-    return os;
+  }
+
+  wostream& JsonLinter::WriteNumber(wostream& os, NUMBER number)
+  {
+    char buffer[NumberSize];
+    wchar_t wide[NumberSize];
+    auto end = FormatNumber(buffer, number);
+    copy(buffer, end, wide);
+    return os.write(wide, end - buffer);
   }
 
   wostream& JsonLinter::WriteObject(wostream& os, std::deque<TOKEN>& tokens, uint8_t indentation, uint8_t depth)
@@ -689,23 +1188,81 @@ namespace Json4CPP::Detail
     return os;
   }
 
-  std::deque<TOKEN> JsonLinter::Read(wistream     & is   )
+  template<typename Stream>
+  void JsonLinter::Parse(Stream& is, JsonHandler& handler)
+  {
+    auto state = JsonLinterState();
+    while (Next(is, state, handler));
+  }
+
+  std::deque<TOKEN> JsonLinter::Read(wistream& is)
+  {
+    auto handler = JsonTokenHandler();
+    Read(is, handler);
+    return move(handler.tokens);
+  }
+
+  std::deque<TOKEN> JsonLinter::Read(wstring_view value)
+  {
+    auto handler = JsonTokenHandler();
+    Read(value, handler);
+    return move(handler.tokens);
+  }
+
+  std::deque<TOKEN> JsonLinter::Read(string_view value)
+  {
+    auto handler = JsonTokenHandler();
+    Read(value, handler);
+    return move(handler.tokens);
+  }
+
+  std::deque<TOKEN> JsonLinter::Read(istream& is)
+  {
+    auto handler = JsonTokenHandler();
+    Read(is, handler);
+    return move(handler.tokens);
+  }
+
+  void JsonLinter::Read(wistream& is, JsonHandler& handler)
+  {
+    auto stream = JsonWideStream(is);
+    Parse(stream, handler);
+  }
+
+  void JsonLinter::Read(istream& is, JsonHandler& handler)
   {
-    auto tokens = std::deque<TOKEN>();
-    Read(is, tokens, 0);
-    is >> ws;
-    if (is.peek(), is.eof())
+    auto buffer = JsonStreamBuffer(is);
+    Parse(buffer, handler);
+  }
+
+  void JsonLinter::Read(wstring_view value, JsonHandler& handler)
+  {
+    if (JsonDefault::Backend == JsonBackend::StructuralIndex && ParseIndexed(value, handler))
     {
-      return tokens;
+      return;
     }
-    auto c = WString2String(L""s + (wchar_t)is.get());
-    auto message = "Unexpected '"s + c + "' at position "s + GetFormattedStreamPositionA(is, is.tellg()) + "!"s;
-    throw exception(message.c_str());
+    auto buffer = JsonBuffer<wchar_t>(value);
+    Parse(buffer, handler);
   }
 
-  std::deque<TOKEN> JsonLinter::Read(wstring const& value)
+  bool JsonLinter::ReadParallel(wstring_view value, vector<JsonHandler*> const& handlers)
   {
-    return Read(wstringstream(value));
+    return ReadParts(value, handlers);
+  }
+
+  bool JsonLinter::ReadParallel(string_view value, vector<JsonHandler*> const& handlers)
+  {
+    return ReadParts(value, handlers);
+  }
+
+  void JsonLinter::Read(string_view value, JsonHandler& handler)
+  {
+    if (JsonDefault::Backend == JsonBackend::StructuralIndex && ParseIndexed(value, handler))
+    {
+      return;
+    }
+    auto buffer = JsonBuffer<char>(value);
+    Parse(buffer, handler);
   }
 
   wostream& JsonLinter::Write(wostream& os, std::deque<TOKEN>& tokens, uint8_t indentation)
@@ -731,4 +1288,10 @@ namespace Json4CPP::Detail
     Write(os, JsonTokenType::Undefined, value);
     return os.str();
   }
+
+  template bool JsonLinter::Next(JsonWideStream        & is, JsonLinterState& state, JsonHandler& handler);
+  template bool JsonLinter::Next(JsonBuffer<wchar_t>   & is, JsonLinterState& state, JsonHandler& handler);
+  template bool JsonLinter::Next(JsonBuffer<char>      & is, JsonLinterState& state, JsonHandler& handler);
+  template bool JsonLinter::Next(JsonStreamBuffer      & is, JsonLinterState& state, JsonHandler& handler);
+  template void JsonLinter::Parse(JsonBuffer<char>      & is, JsonHandler& handler);
 }
\ No newline at end of file
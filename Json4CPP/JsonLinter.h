@@ -7,37 +7,102 @@
 #endif
 
 #include "JsonTokenType.h"
+#include "JsonHandler.h"
 
 #include <variant>
 #include <string>
+#include <string_view>
 #include <deque>
+#include <vector>
 #include <utility>
 #include <sstream>
 
+namespace Json4CPP
+{
+  class JSON_API JsonLazy;
+}
+
 namespace Json4CPP::Detail
 {
   using VALUE_TOKEN = std::variant<std::nullptr_t, std::wstring, bool, double, int64_t>;
   using TOKEN = std::pair<JsonTokenType, VALUE_TOKEN>;
   using NUMBER = std::variant<double, int64_t>;
 
+  class JSON_API JsonReader;
+  class JSON_API JsonWriter;
+  class JSON_API JsonPushParser;
+
+  // Where an iterative parse continues, see JsonLinter::Next.
+  struct JsonLinterState
+  {
+    enum class Step : uint8_t { Value, ObjectFirst, Property, ObjectNext, ArrayFirst, ArrayNext, End, Done };
+
+    Step step = Step::Value;
+#pragma warning(suppress: 4251)
+    std::vector<JsonTokenType> containers; // StartObject or StartArray for each of the open containers
+  };
+
   class JSON_API JsonLinter
   {
   private:
-    static std::nullptr_t ParseNull   (std::wistream& is);
-    static std::wstring   ParseString (std::wistream& is);
-    static bool           ParseBoolean(std::wistream& is);
-    static NUMBER         ParseNumber (std::wistream& is);
-    static void           ParseObject (std::wistream& is, std::deque<TOKEN>& tokens, uint8_t depth);
-    static void           ParseArray  (std::wistream& is, std::deque<TOKEN>& tokens, uint8_t depth);
-    static void           Read        (std::wistream& is, std::deque<TOKEN>& tokens, uint8_t depth);
+    friend class JsonReader;
+    friend class JsonWriter;
+    friend class JsonPushParser;
+    friend class ::Json4CPP::JsonLazy;
+
+    // The parser is templated on the input, which is either a JsonWideStream, a JsonBuffer or a JsonStreamBuffer.
+    // All of them provide peek, get, eof, tellg and >> std::ws, so the tokens and the error messages are the same.
+    template<typename Stream> static std::nullptr_t    ParseNull   (Stream& is);
+    template<typename Stream> static std::wstring      ParseString (Stream& is);
+    template<typename Stream> static bool              ParseBoolean(Stream& is);
+    template<typename Stream> static NUMBER            ParseNumber (Stream& is);
+    // Parses until the next value is passed to handler, returns false if the end of the input was reached instead.
+    // Objects and arrays are tracked in state instead of recursion, so the parse can be suspended between any two values.
+    template<typename Stream> static bool              Next        (Stream& is, JsonLinterState& state, JsonHandler& handler);
+    template<typename Stream> static void              Parse       (Stream& is, JsonHandler& handler);
+    // Second stage of JsonBackend::StructuralIndex, the first one is JsonStructuralIndex. It follows the same steps as Next,
+    // but moves from token to token by the index, and reads the values directly from the text, or by the functions above if they are not simple.
+    // Returns false if the text can not be indexed, before anything is passed to handler.
+    template<typename Char>   static bool              ParseIndexed(std::basic_string_view<Char> value, JsonHandler& handler);
+    // Walks the tokens of the index from first, until the one at last, if it is a comma of the root array, or until the end of the text.
+    template<typename Char>   static void              WalkIndex   (std::basic_string_view<Char> value, std::vector<uint32_t> const& positions,
+                                                                    size_t first, size_t last, JsonLinterState& state, JsonHandler& handler);
+    template<typename Char>   static bool              ReadParts   (std::basic_string_view<Char> value, std::vector<JsonHandler*> const& handlers);
 
+    // Formats number into buffer, which has to have room for NumberSize characters, and returns the end of the text.
+    // Integers and integral doubles are written as integers, doubles exactly representable as float with the shortest float
+    // representation, and every other double with the shortest representation which parses back to the same value.
+    static constexpr size_t NumberSize = 32;
+    static char* FormatNumber(char* buffer, NUMBER number);
     static std::wostream& WriteNumber (std::wostream& os, NUMBER number);
     static std::wostream& WriteObject (std::wostream& os, std::deque<TOKEN>& tokens, uint8_t indentation, uint8_t depth);
     static std::wostream& WriteArray  (std::wostream& os, std::deque<TOKEN>& tokens, uint8_t indentation, uint8_t depth);
     static std::wostream& Write(std::wostream& os, JsonTokenType const& token, VALUE_TOKEN const& value);
   public:
-    static std::deque<TOKEN> Read(std::wistream     & is   );
-    static std::deque<TOKEN> Read(std::wstring const& value);
+    static std::deque<TOKEN> Read(std::wistream   & is   );
+    // Parses UTF-16 encoded text directly from memory.
+    static std::deque<TOKEN> Read(std::wstring_view value);
+    // Parses UTF-8 encoded text directly from memory, without converting it into a wstring first.
+    static std::deque<TOKEN> Read(std::string_view  value);
+    // Parses UTF-8 encoded text from the stream through a fixed size buffer.
+    static std::deque<TOKEN> Read(std::istream    & is   );
+
+    // Same as above, but passes the values to handler as they are parsed, instead of collecting them as tokens.
+    // With an std::istream, the memory usage does not depend on the size of the input.
+    static void Read(std::wistream   & is   , JsonHandler& handler);
+    static void Read(std::wstring_view value, JsonHandler& handler);
+    static void Read(std::string_view  value, JsonHandler& handler);
+    static void Read(std::istream    & is   , JsonHandler& handler);
+
+    // Parses a root array in parts on separate threads, each part passed to the next handler as an array of its elements.
+    // The text is split at commas of the root array, so that each part has about the same size, and the elements of the
+    // handlers in order are the elements of the root array. There may be fewer parts than handlers, the rest get empty arrays.
+    // The first error in the text is thrown, the same as with Read, after all of the parts were parsed.
+    // Returns false if the root is not an array, or the text can not be indexed, before anything is passed to the handlers.
+    static bool ReadParallel(std::wstring_view value, std::vector<JsonHandler*> const& handlers);
+    static bool ReadParallel(std::string_view  value, std::vector<JsonHandler*> const& handlers);
+    // Below this many characters for each part, the threads cost more than they save.
+    static constexpr size_t ParallelPartSize = 256 * 1024;
 
     static std::wostream& Write(std::wostream& os, std::deque<TOKEN>& tokens, uint8_t indentation);
 
@@ -12,6 +12,185 @@ using namespace Json4CPP::Detail;
 
 namespace Json4CPP
 {
+  uint32_t JsonObject::HashKey(KEY const& key)
+  {
+    return (uint32_t)hash<KEY>()(key);
+  }
+
+  JsonObject::Data::Data(pmr::memory_resource* resource) : pairs(resource), indexes(resource)
+  {
+
+  }
+
+  JsonObject::Data::Data(Data const& data, pmr::memory_resource* resource) : pairs(data.pairs, resource), indexes(data.indexes, resource)
+  {
+
+  }
+
+  JsonObject::Data const& JsonObject::Contents() const
+  {
+    static auto const empty = Data(pmr::new_delete_resource());
+    return _data ? *_data : empty;
+  }
+
+  JsonObject::Data& JsonObject::Detach()
+  {
+    if (!_data)
+    {
+      _data = allocate_shared<Data>(pmr::polymorphic_allocator<Data>(_resource), _resource);
+    }
+    else if (_data.use_count() > 1)
+    {
+      _data = allocate_shared<Data>(pmr::polymorphic_allocator<Data>(_resource), *_data, _resource);
+    }
+    else
+    {
+      // Pairs with the release of the last other copy, so its reads of the pairs happen before the writes of this one
+      atomic_thread_fence(memory_order_acquire);
+    }
+    _hash.store(0, memory_order_relaxed);
+    _data->referenced = false;
+    return *_data;
+  }
+
+  JsonObject::Data& JsonObject::Reference()
+  {
+    auto& data = Detach();
+    data.referenced = true;
+    return data;
+  }
+
+  int64_t JsonObject::IndexOf(KEY const& key) const
+  {
+    return IndexOf(key, Contents().indexes.empty() ? 0 : HashKey(key));
+  }
+
+  int64_t JsonObject::IndexOf(KEY const& key, uint32_t hash) const
+  {
+    auto& data = Contents();
+    auto& pairs = data.pairs;
+    auto& indexes = data.indexes;
+    if (indexes.empty())
+    {
+      for (int64_t i = 0; i < (int64_t)pairs.size(); ++i)
+      {
+        if (pairs[i].first == key) return i;
+      }
+      return -1;
+    }
+    auto mask = indexes.size() - 1;
+    for (auto i = hash & mask; indexes[i].index; i = (i + 1) & mask)
+    {
+      auto& slot = indexes[i];
+      if (slot.hash == hash && pairs[slot.index - 1].first == key) return slot.index - 1;
+    }
+    return -1;
+  }
+
+  void JsonObject::IndexLast()
+  {
+    auto& pairs = _data->pairs;
+    auto& indexes = _data->indexes;
+    auto size = pairs.size();
+    if (size <= LinearSearchLimit) return;
+    // Keeps the load factor under 3/4, this also builds the index when the object outgrows the linear search
+    if (size * 4 > indexes.size() * 3)
+    {
+      Reindex();
+    }
+    else
+    {
+      AddToIndex(size - 1);
+    }
+  }
+
+  void JsonObject::AddToIndex(int64_t index)
+  {
+    auto& pairs = _data->pairs;
+    auto& indexes = _data->indexes;
+    auto hash = HashKey(pairs[index].first);
+    auto mask = indexes.size() - 1;
+    auto i = hash & mask;
+    while (indexes[i].index)
+    {
+      i = (i + 1) & mask;
+    }
+    indexes[i] = { hash, (uint32_t)index + 1 };
+  }
+
+  size_t JsonObject::FindSlot(int64_t index) const
+  {
+    auto& pairs = _data->pairs;
+    auto& indexes = _data->indexes;
+    auto mask = indexes.size() - 1;
+    auto i = HashKey(pairs[index].first) & mask;
+    while (indexes[i].index != index + 1)
+    {
+      i = (i + 1) & mask;
+    }
+    return i;
+  }
+
+  void JsonObject::RemoveFromIndex(int64_t index)
+  {
+    auto& pairs = _data->pairs;
+    auto& indexes = _data->indexes;
+    auto mask = indexes.size() - 1;
+    auto i = FindSlot(index);
+    // Backward shift deletion: moves back the following slots of the cluster which are not at their home position,
+    // so lookups never stop early at the freed slot
+    for (auto j = (i + 1) & mask; indexes[j].index; j = (j + 1) & mask)
+    {
+      auto home = indexes[j].hash & mask;
+      auto between = i <= j ? i < home && home <= j : i < home || home <= j;
+      if (!between)
+      {
+        indexes[i] = indexes[j];
+        i = j;
+      }
+    }
+    indexes[i] = { 0, 0 };
+    // The positions of the pairs after index move back by one. When only a few of them shift, their slots are looked up one by one,
+    // so erasing near the end costs about the same as moving the pairs. Otherwise every slot is visited once, without branches.
+    auto shifted = (int64_t)pairs.size() - index - 1;
+    if (shifted * 32 < (int64_t)indexes.size())
+    {
+      for (auto i = index + 1; i < (int64_t)pairs.size(); ++i)
+      {
+        --indexes[FindSlot(i)].index;
+      }
+      return;
+    }
+    auto position = (uint32_t)index + 1;
+    for (auto& slot : indexes)
+    {
+      slot.index -= slot.index > position;
+    }
+  }
+
+  void JsonObject::Reindex()
+  {
+    auto& pairs = _data->pairs;
+    auto& indexes = _data->indexes;
+    indexes.clear();
+    if (pairs.size() <= LinearSearchLimit)
+    {
+      indexes.shrink_to_fit();
+      return;
+    }
+    // Power of two size with a load factor of at most 3/8 right after rebuilding
+    auto slots = size_t(16);
+    while (slots * 3 < pairs.size() * 8)
+    {
+      slots *= 2;
+    }
+    indexes.resize(slots, Slot{ 0, 0 });
+    for (int64_t i = 0; i < (int64_t)pairs.size(); ++i)
+    {
+      AddToIndex(i);
+    }
+  }
+
   JsonObject JsonObject::Read(deque<TOKEN>& tokens)
   {
     if (tokens.empty())
@@ -81,17 +260,17 @@ namespace Json4CPP
   {
     if (auto object = get_if<JsonObject>(&builder._value))
     {
-      *this = *object;
+      *this = move(*object);
     }
     else if (auto builders = get_if<vector<JsonBuilder>>(&builder._value))
     {
+      Detach().pairs.reserve(builders->size());
       for (auto& builder : *builders)
       {
         if (auto pair = get_if<vector<JsonBuilder>>(&builder._value))
         {
-          auto key = get<KEY>((*pair)[0]._value);
-          auto value = Json((*pair)[1]);
-          Insert({ key, value });
+          auto& key = get<KEY>((*pair)[0]._value);
+          Emplace(move(key), move((*pair)[1]));
         }
         else
         {
@@ -120,108 +299,280 @@ namespace Json4CPP
 
   JsonObject::JsonObject(JsonObject const& object)
   {
-    _pairs = object._pairs;
-    _indexes = object._indexes;
+    *this = object;
+  }
+
+  JsonObject::JsonObject(JsonObject&& object) noexcept :
+    _data(move(object._data)), _resource(object._resource), _hash(object._hash.exchange(0, memory_order_relaxed))
+  {
+
+  }
+
+  JsonObject& JsonObject::operator=(JsonObject const& object)
+  {
+    // Copying referenced pairs into themselves would leave the references to them dangling
+    if (&object == this)
+    {
+      return *this;
+    }
+    if (!object._data || (object._resource == _resource && !object._data->referenced))
+    {
+      _data = object._data;
+    }
+    else
+    {
+      _data = allocate_shared<Data>(pmr::polymorphic_allocator<Data>(_resource), *object._data, _resource);
+    }
+    _hash.store(object._hash.load(memory_order_relaxed), memory_order_relaxed);
+    return *this;
+  }
+
+  JsonObject& JsonObject::operator=(JsonObject&& object)
+  {
+    if (object._resource != _resource)
+    {
+      return *this = object;
+    }
+    _data = move(object._data);
+    _hash.store(object._hash.exchange(0, memory_order_relaxed), memory_order_relaxed);
+    return *this;
+  }
+
+  JsonObject::JsonObject(pmr::memory_resource* resource) : _resource(resource)
+  {
+
   }
 
   wstring JsonObject::Dump(uint8_t indentation) const
   {
-    wstringstream os;
-    JsonLinter::Write(os, JsonObject::Write(*this, deque<TOKEN>()), indentation);
-    return os.str();
+    return JsonWriter::Dump(*this, indentation);
   }
 
   int64_t JsonObject::Size() const
   {
-    return _pairs.size();
+    return Contents().pairs.size();
+  }
+
+  uint64_t JsonObject::Hash() const
+  {
+    if (auto result = _hash.load(memory_order_relaxed))
+    {
+      return result;
+    }
+    // Distinguishes {} from [] and from the scalars
+    auto result = uint64_t(0x6a09e667f3bcc908);
+    for (auto& [key, value] : Contents().pairs)
+    {
+      result = CombineHash(result, hash<KEY>()(key));
+      result = CombineHash(result, value.Hash());
+    }
+    // 0 would mean that it is not computed yet
+    result += !result;
+    // Writes through the references to referenced pairs do not drop the cached hash, so it is not cached for them
+    if (!_data || !_data->referenced)
+    {
+      _hash.store(result, memory_order_relaxed);
+    }
+    return result;
   }
 
   void JsonObject::Clear()
   {
-    _pairs.clear();
-    _indexes.clear();
+    // Shared pairs are left to the other copies instead of being copied only to be cleared
+    if (_data.use_count() > 1)
+    {
+      _data = nullptr;
+      _hash.store(0, memory_order_relaxed);
+      return;
+    }
+    if (_data)
+    {
+      auto& data = Detach();
+      data.pairs.clear();
+      data.indexes.clear();
+    }
   }
 
   bool JsonObject::Insert(pair<KEY, Json> pair)
   {
-    if (_indexes.count(pair.first)) return false;
-    _pairs.push_back(pair);
-    _indexes[pair.first] = _pairs.size() - 1;
+    if (IndexOf(pair.first) != -1) return false;
+    Detach().pairs.push_back(move(pair));
+    IndexLast();
     return true;
   }
 
   void JsonObject::Erase(KEY key)
   {
-    if (!_indexes.count(key)) return;
-    _pairs.erase(remove_if(_pairs.begin(), _pairs.end(), [&](pair<KEY, Json> const& pair) { return pair.first == key; }), _pairs.end());
-    _indexes.clear();
-    for (int i = 0; i < _pairs.size(); ++i)
+    auto index = IndexOf(key);
+    if (index == -1) return;
+    auto& pairs = Detach().pairs;
+    if (pairs.size() - 1 <= LinearSearchLimit)
+    {
+      pairs.erase(pairs.begin() + index);
+      Reindex();
+      return;
+    }
+    RemoveFromIndex(index);
+    pairs.erase(pairs.begin() + index);
+  }
+
+  int64_t JsonObject::EraseIf(function<bool(pair<KEY, Json> const&)> predicate)
+  {
+    // The pairs are only detached once one of them is going to be erased, so erasing nothing leaves them shared
+    // and keeps the cached hash
+    auto& contents = Contents().pairs;
+    auto first = find_if(contents.begin(), contents.end(), predicate);
+    if (first == contents.end())
+    {
+      return 0;
+    }
+    auto index = first - contents.begin();
+    auto& pairs = Detach().pairs;
+    auto end = pairs.begin() + index;
+    for (auto i = end + 1; i != pairs.end(); ++i)
     {
-      _indexes[_pairs[i].first] = i;
+      if (!predicate(*i))
+      {
+        *end++ = move(*i);
+      }
     }
+    auto count = pairs.end() - end;
+    pairs.erase(end, pairs.end());
+    Reindex();
+    return count;
   }
 
   vector<KEY> JsonObject::Keys() const
   {
     vector<KEY> keys;
-    transform(_pairs.begin(), _pairs.end(), back_inserter(keys), [](pair<KEY, Json> const& pair) { return pair.first; });
+    auto& pairs = Contents().pairs;
+    transform(pairs.begin(), pairs.end(), back_inserter(keys), [](pair<KEY, Json> const& pair) { return pair.first; });
     return keys;
   }
 
   Json& JsonObject::operator[](KEY const& key)
   {
-    if (!_indexes.count(key)) Insert({ key, Json{} });
-    return _pairs[_indexes.at(key)].second;
+    auto& pairs = Reference().pairs;
+    auto index = IndexOf(key);
+    if (index == -1)
+    {
+      pairs.emplace_back(key, Json());
+      IndexLast();
+      return pairs.back().second;
+    }
+    return pairs[index].second;
   }
 
-  Json JsonObject::At(KEY const& key) const
+  Json const& JsonObject::At(KEY const& key) const
   {
-    return _pairs[_indexes.at(key)].second;
+    auto index = IndexOf(key);
+    if (index == -1)
+    {
+      auto message = WString2String(L"Key not found: "s + key + L"!"s);
+      throw out_of_range(message.c_str());
+    }
+    return Contents().pairs[index].second;
   }
 
   Json& JsonObject::At(KEY const& key)
   {
-    return _pairs[_indexes.at(key)].second;
+    auto index = IndexOf(key);
+    if (index == -1)
+    {
+      auto message = WString2String(L"Key not found: "s + key + L"!"s);
+      throw out_of_range(message.c_str());
+    }
+    return Reference().pairs[index].second;
+  }
+
+  Json const* JsonObject::Find(KEY const& key) const
+  {
+    auto index = IndexOf(key);
+    return index == -1 ? nullptr : &Contents().pairs[index].second;
   }
 
-  vector<pair<KEY, Json>>::iterator JsonObject::begin()
+  Json* JsonObject::Find(KEY const& key)
   {
-    return _pairs.begin();
+    auto index = IndexOf(key);
+    return index == -1 ? nullptr : &Reference().pairs[index].second;
   }
 
-  vector<pair<KEY, Json>>::iterator JsonObject::end()
+  pmr::vector<pair<KEY, Json>>::iterator JsonObject::begin()
   {
-    return _pairs.end();
+    return Reference().pairs.begin();
   }
 
-  vector<pair<KEY, Json>>::const_iterator JsonObject::begin() const
+  pmr::vector<pair<KEY, Json>>::iterator JsonObject::end()
   {
-    return _pairs.begin();
+    return Reference().pairs.end();
   }
 
-  vector<pair<KEY, Json>>::const_iterator JsonObject::end() const
+  pmr::vector<pair<KEY, Json>>::const_iterator JsonObject::begin() const
   {
-    return _pairs.end();
+    return Contents().pairs.begin();
+  }
+
+  pmr::vector<pair<KEY, Json>>::const_iterator JsonObject::end() const
+  {
+    return Contents().pairs.end();
   }
 
   wostream& operator<<(wostream& os, JsonObject const& object)
   {
-    return JsonLinter::Write(os, JsonObject::Write(object, deque<TOKEN>()), JsonDefault::Indentation);
+    return JsonWriter::Write(os, object, JsonDefault::Indentation);
   }
 
   wistream& operator>>(wistream& is, JsonObject& object)
   {
-    object = JsonObject::Read(JsonLinter::Read(is));
-    return is;
+    auto json = Json();
+    auto handler = JsonDomHandler(json);
+    JsonLinter::Read(is, handler);
+    if (auto result = json.GetIf<JsonObject>())
+    {
+      object = move(*result);
+      return is;
+    }
+    auto message = WString2String(L"Expected token: "s + Json::Stringify(JsonTokenType::StartObject) + L"!"s);
+    throw exception(message.c_str());
+  }
+
+  ostream& operator<<(ostream& os, JsonObject const& object)
+  {
+    return JsonWriter::Write(os, object, JsonDefault::Indentation);
+  }
+
+  istream& operator>>(istream& is, JsonObject& object)
+  {
+    auto json = Json();
+    auto handler = JsonDomHandler(json);
+    JsonLinter::Read(is, handler);
+    if (auto result = json.GetIf<JsonObject>())
+    {
+      object = move(*result);
+      return is;
+    }
+    auto message = WString2String(L"Expected token: "s + Json::Stringify(JsonTokenType::StartObject) + L"!"s);
+    throw exception(message.c_str());
   }
 
   bool operator==(JsonObject const& left, JsonObject const& right)
   {
-    return left._pairs == right._pairs;
+    if (left._data == right._data)
+    {
+      return true;
+    }
+    // Only the cached hashes are compared, computing them would visit every value anyway
+    auto leftHash = left._hash.load(memory_order_relaxed);
+    auto rightHash = right._hash.load(memory_order_relaxed);
+    if (leftHash && rightHash && leftHash != rightHash)
+    {
+      return false;
+    }
+    return left.Contents().pairs == right.Contents().pairs;
   }
 
   bool operator!=(JsonObject const& left, JsonObject const& right)
   {
-    return left._pairs != right._pairs;
+    return !(left == right);
   }
 }
\ No newline at end of file
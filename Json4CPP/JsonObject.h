@@ -11,21 +11,30 @@
 
 #include <vector>
 #include <deque>
-#include <unordered_map>
 #include <utility>
+#include <tuple>
 #include <sstream>
 #include <iostream>
 #include <initializer_list>
 #include <string>
+#include <memory_resource>
+#include <functional>
+#include <atomic>
+#include <memory>
 
 namespace Json4CPP
 {
   namespace Detail
   {
     class JSON_API JsonBuilder;
+    class JSON_API JsonDomHandler;
+    class JSON_API JsonWriter;
+    class JSON_API JsonPatch;
   }
   class JSON_API JsonArray;
   class JSON_API Json;
+  class JSON_API JsonPointer;
+  class JSON_API JsonPath;
 
   class JSON_API JsonObject
   {
@@ -33,10 +42,69 @@ namespace Json4CPP
     friend class JsonArray;
     friend class Json;
     friend class Detail::JsonBuilder;
+    friend class Detail::JsonDomHandler;
+    friend class Detail::JsonWriter;
+    friend class Detail::JsonPatch;
+    friend class JsonPointer;
+    friend class JsonPath;
+    // Slot of the open addressing index, index is the position in the pairs plus one, 0 marks an empty slot
+    struct Slot
+    {
+      uint32_t hash;
+      uint32_t index;
+    };
+    // Objects up to this size are searched linearly and have no index
+    static constexpr int64_t LinearSearchLimit = 8;
+    // The pairs and their index, shared by the copies of the object until one of them is modified
+    struct Data
+    {
 #pragma warning(suppress: 4251)
-    std::vector<std::pair<KEY, Json>> _pairs;
+      std::pmr::vector<std::pair<KEY, Json>> pairs;
 #pragma warning(suppress: 4251)
-    std::unordered_map<KEY, int64_t> _indexes;
+      std::pmr::vector<Slot> indexes;
+
+      // Set once references or iterators to the pairs are handed out, the copies made after that copy them right away.
+      // Cleared by the members which modify the object, as those invalidate the references and iterators handed out before.
+      bool referenced = false;
+
+      explicit Data(std::pmr::memory_resource* resource);
+      Data(Data const& data, std::pmr::memory_resource* resource);
+    };
+    // Allocated on the first write, so empty objects allocate nothing
+#pragma warning(suppress: 4251)
+    std::shared_ptr<Data> _data;
+    std::pmr::memory_resource* _resource = std::pmr::get_default_resource();
+    // Cached result of Hash, 0 until it is computed
+#pragma warning(suppress: 4251)
+    mutable std::atomic<uint64_t> _hash = 0;
+
+    static uint32_t HashKey(KEY const& key);
+    // The contents for reading, an empty Data if nothing is allocated yet.
+    Data const& Contents() const;
+    // The contents for writing, called by every member which modifies the object.
+    // Allocates them on the first call, copies them if they are shared with other copies of the object, drops the cached hash,
+    // and clears referenced.
+    // Only the pairs are copied, the nested objects and arrays stay shared until they are written themselves.
+    Data& Detach();
+    // Detach, for the members which return references or iterators to the pairs. As the pairs can be written through those
+    // at any time later, they are marked referenced, and the copies made until the next modification copy them instead of sharing them.
+    // Stops caching the hash until then too.
+    Data& Reference();
+    // Returns the position of key in the pairs, or -1 if it is not present.
+    int64_t IndexOf(KEY const& key) const;
+    // Same, with the HashKey of key computed in advance, as JsonPointer and JsonPath do.
+    int64_t IndexOf(KEY const& key, uint32_t hash) const;
+    // The members below modify _data, so they have to be called after Detach.
+    // Adds the last pair to the index, has to be called after every push_back on the pairs.
+    void IndexLast();
+    // Puts the pair at index into a free slot, the index has to have room for it.
+    void AddToIndex(int64_t index);
+    // Returns the position of the slot of the pair at index in the index.
+    size_t FindSlot(int64_t index) const;
+    // Removes the slot of the pair at index, and shifts the positions after it, as the pair is about to be erased.
+    void RemoveFromIndex(int64_t index);
+    // Rebuilds the index from the pairs.
+    void Reindex();
 
     static JsonObject                 Read (                          std::deque<Detail::TOKEN>& tokens);
     static std::deque<Detail::TOKEN>& Write(JsonObject const& object, std::deque<Detail::TOKEN>& tokens);
@@ -44,28 +112,76 @@ namespace Json4CPP
     JsonObject() = default;
     JsonObject(Detail::JsonBuilder builder);
     JsonObject(std::initializer_list<Detail::JsonBuilder> builders);
+    // Copies share the pairs with object until either of them is modified, when only the modified one copies them (copy-on-write).
+    // Once references or iterators to the pairs are obtained through non-const members, the copies made after that copy the pairs
+    // right away, so writing through those never changes a copy. The object shares its pairs again after it is modified, or assigned,
+    // as that invalidates those references and iterators, as with std::vector.
     JsonObject(JsonObject const& object);
+    JsonObject(JsonObject&& object) noexcept;
+    // Assignment keeps the memory resource of the target, the pairs are shared only if it is the same as the one of object
+    // and they are not referenced
+    JsonObject& operator=(JsonObject const& object);
+    JsonObject& operator=(JsonObject&& object);
+    // The pairs and the index are allocated from resource, which has to outlive the JsonObject. Copies use the default resource,
+    // so the pairs of objects with other resources are copied right away.
+    explicit JsonObject(std::pmr::memory_resource* resource);
 
     std::wstring Dump(uint8_t indentation = 0) const;
 
     int64_t Size() const;
+    // Hash of the keys and values in order, consistent with operator==, so 1, 1.0 and true hash the same.
+    // It is computed on the first call and cached, also in every nested JsonObject and JsonArray, until the object is accessed
+    // through a non-const member. It is not cached while references or iterators to the pairs can be in use, which is from the
+    // first call of a non-const member returning one, until the next call of a member modifying the object, or an assignment.
+    // Those invalidate the references and iterators handed out before, as with std::vector.
+    uint64_t Hash() const;
     void Clear();
     bool Insert(std::pair<KEY, Json> pair);
+    // Constructs the value in place from args if key is not present yet. Like Insert, returns false and leaves the object unchanged otherwise.
+    template<typename... Args>
+    bool Emplace(KEY key, Args&&... args)
+    {
+      if (IndexOf(key) != -1) return false;
+      Detach().pairs.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+      IndexLast();
+      return true;
+    }
     void Erase(KEY key);
+    // Erases every pair for which predicate returns true in a single pass, and returns the number of erased pairs.
+    int64_t EraseIf(std::function<bool(std::pair<KEY, Json> const&)> predicate);
     std::vector<KEY> Keys() const;
     Json& operator[](KEY const& key);
-    Json  At        (KEY const& key) const;
-    Json& At        (KEY const& key);
+    Json const& At  (KEY const& key) const;
+    Json      & At  (KEY const& key);
+    // Returns the value of key, or nullptr if it is not present.
+    Json const* Find(KEY const& key) const;
+    Json      * Find(KEY const& key);
 
-    std::vector<std::pair<KEY, Json>>::      iterator begin();
-    std::vector<std::pair<KEY, Json>>::      iterator end  ();
-    std::vector<std::pair<KEY, Json>>::const_iterator begin() const;
-    std::vector<std::pair<KEY, Json>>::const_iterator end  () const;
+    std::pmr::vector<std::pair<KEY, Json>>::      iterator begin();
+    std::pmr::vector<std::pair<KEY, Json>>::      iterator end  ();
+    std::pmr::vector<std::pair<KEY, Json>>::const_iterator begin() const;
+    std::pmr::vector<std::pair<KEY, Json>>::const_iterator end  () const;
 
     JSON_API friend std::wostream& operator<<(std::wostream& os, JsonObject const& object);
     JSON_API friend std::wistream& operator>>(std::wistream& is, JsonObject      & object);
+    // UTF-8 encoded text
+    JSON_API friend std::ostream & operator<<(std::ostream & os, JsonObject const& object);
+    JSON_API friend std::istream & operator>>(std::istream & is, JsonObject      & object);
 
+    // If both objects share their pairs, or both hashes are cached already and they differ, returns without comparing the pairs.
     JSON_API friend bool operator==(JsonObject const& left, JsonObject const& right);
     JSON_API friend bool operator!=(JsonObject const& left, JsonObject const& right);
   };
+}
+
+namespace std
+{
+  template<>
+  struct hash<Json4CPP::JsonObject>
+  {
+    size_t operator()(Json4CPP::JsonObject const& object) const
+    {
+      return (size_t)object.Hash();
+    }
+  };
 }
\ No newline at end of file
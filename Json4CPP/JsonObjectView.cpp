@@ -0,0 +1,58 @@
+#include "stdafx.h"
+
+#include "Json.h"
+
+using namespace std;
+
+namespace Json4CPP
+{
+  JsonObjectView::JsonObjectView(JsonObject const& object) : _object(&object)
+  {
+
+  }
+
+  wstring JsonObjectView::Dump(uint8_t indentation) const
+  {
+    return _object->Dump(indentation);
+  }
+
+  int64_t JsonObjectView::Size() const
+  {
+    return _object->Size();
+  }
+
+  vector<KEY> JsonObjectView::Keys() const
+  {
+    return _object->Keys();
+  }
+
+  Json const& JsonObjectView::operator[](KEY const& key) const
+  {
+    return _object->At(key);
+  }
+
+  Json const& JsonObjectView::At(KEY const& key) const
+  {
+    return _object->At(key);
+  }
+
+  Json const* JsonObjectView::Find(KEY const& key) const
+  {
+    return _object->Find(key);
+  }
+
+  pmr::vector<pair<KEY, Json>>::const_iterator JsonObjectView::begin() const
+  {
+    return _object->begin();
+  }
+
+  pmr::vector<pair<KEY, Json>>::const_iterator JsonObjectView::end() const
+  {
+    return _object->end();
+  }
+
+  JsonObject const& JsonObjectView::Object() const
+  {
+    return *_object;
+  }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include "JsonObject.h"
+
+#include <vector>
+#include <utility>
+#include <string>
+
+namespace Json4CPP
+{
+  class JSON_API Json;
+
+  // Read-only view of a JsonObject, which does not copy it. The JsonObject has to outlive the view, and must not be changed while the view is used.
+  class JSON_API JsonObjectView
+  {
+  private:
+    JsonObject const* _object;
+  public:
+    JsonObjectView(JsonObject const& object);
+
+    std::wstring Dump(uint8_t indentation = 0) const;
+
+    int64_t Size() const;
+    std::vector<KEY> Keys() const;
+    // Same as At, a view can not insert.
+    Json const& operator[](KEY const& key) const;
+    Json const& At        (KEY const& key) const;
+    // Returns the value of key, or nullptr if it is not present.
+    Json const* Find      (KEY const& key) const;
+
+    std::pmr::vector<std::pair<KEY, Json>>::const_iterator begin() const;
+    std::pmr::vector<std::pair<KEY, Json>>::const_iterator end  () const;
+
+    // The viewed JsonObject, copying it gives an owning JsonObject.
+    JsonObject const& Object() const;
+  };
+}
@@ -0,0 +1,515 @@
+#include "stdafx.h"
+
+#include "JsonPatch.h"
+#include "Json.h"
+#include "JsonObject.h"
+#include "JsonArray.h"
+#include "JsonPointer.h"
+#include "Helper.h"
+
+using namespace std;
+
+namespace Json4CPP::Detail
+{
+  Json JsonPatch::Diff(Json const& source, Json const& target)
+  {
+    auto patch = JsonArray();
+    auto path = wstring();
+    DiffValue(source, target, path, patch);
+    return patch;
+  }
+
+  void JsonPatch::DiffValue(Json const& source, Json const& target, wstring& path, JsonArray& patch)
+  {
+    auto sourceObject = get_if<JsonObject>(&source._value);
+    auto targetObject = get_if<JsonObject>(&target._value);
+    if (sourceObject && targetObject)
+    {
+      DiffObject(*sourceObject, *targetObject, path, patch);
+      return;
+    }
+    auto sourceArray = get_if<JsonArray>(&source._value);
+    auto targetArray = get_if<JsonArray>(&target._value);
+    if (sourceArray && targetArray)
+    {
+      DiffArray(*sourceArray, *targetArray, path, patch);
+      return;
+    }
+    if (!Equal(source, target))
+    {
+      patch.PushBack(Operation(L"replace", path, target));
+    }
+  }
+
+  void JsonPatch::DiffObject(JsonObject const& source, JsonObject const& target, wstring& path, JsonArray& patch)
+  {
+    if (source._data == target._data)
+    {
+      return;
+    }
+    auto size = path.size();
+    for (auto& [key, value] : source)
+    {
+      AppendToken(path, key);
+      if (auto other = target.Find(key))
+      {
+        DiffValue(value, *other, path, patch);
+      }
+      else
+      {
+        patch.PushBack(Operation(L"remove", path));
+      }
+      path.resize(size);
+    }
+    for (auto& [key, value] : target)
+    {
+      if (source.IndexOf(key) == -1)
+      {
+        AppendToken(path, key);
+        patch.PushBack(Operation(L"add", path, value));
+        path.resize(size);
+      }
+    }
+  }
+
+  void JsonPatch::DiffArray(JsonArray const& source, JsonArray const& target, wstring& path, JsonArray& patch)
+  {
+    if (source._data == target._data)
+    {
+      return;
+    }
+    auto& before = source.Contents().values;
+    auto& after  = target.Contents().values;
+    // The common beginning and end are left out of the search
+    auto begin = int64_t(0);
+    auto sourceEnd = (int64_t)before.size();
+    auto targetEnd = (int64_t)after.size();
+    while (begin < sourceEnd && begin < targetEnd && Matches(before[begin], after[begin]))
+    {
+      ++begin;
+    }
+    while (begin < sourceEnd && begin < targetEnd && Matches(before[sourceEnd - 1], after[targetEnd - 1]))
+    {
+      --sourceEnd;
+      --targetEnd;
+    }
+    auto n = sourceEnd - begin;
+    auto m = targetEnd - begin;
+    if (n + m == 0)
+    {
+      return;
+    }
+
+    // Shortest edit script by the Myers algorithm. After d edits, furthest[k] is the furthest position in before which is reached
+    // on the diagonal k = x - y, and trace[d] keeps it for the diagonals -d..d, so the path can be followed back from the end.
+    enum class Edit : uint8_t { Keep, Remove, Add };
+    auto edits = vector<Edit>();
+    auto limit = min(n + m, ArrayEditLimit);
+    auto furthest = vector<int64_t>(2 * limit + 3, 0);
+    auto at = [&](int64_t k) -> int64_t& { return furthest[k + limit + 1]; };
+    auto trace = vector<vector<int64_t>>();
+    auto found = int64_t(-1);
+    for (int64_t d = 0; d <= limit && found == -1; ++d)
+    {
+      for (auto k = -d; k <= d; k += 2)
+      {
+        auto x = k == -d || (k != d && at(k - 1) < at(k + 1)) ? at(k + 1) : at(k - 1) + 1;
+        auto y = x - k;
+        while (x < n && y < m && Matches(before[begin + x], after[begin + y]))
+        {
+          ++x;
+          ++y;
+        }
+        at(k) = x;
+        if (x >= n && y >= m)
+        {
+          found = d;
+          break;
+        }
+      }
+      trace.emplace_back(&at(-d), &at(d) + 1);
+    }
+    if (found != -1)
+    {
+      auto x = n;
+      auto y = m;
+      for (auto d = found; d > 0; --d)
+      {
+        auto& previous = trace[d - 1];
+        auto reached = [&](int64_t k) { return previous[k + d - 1]; };
+        auto k = x - y;
+        auto add = k == -d || (k != d && reached(k - 1) < reached(k + 1));
+        auto previousK = add ? k + 1 : k - 1;
+        auto previousX = reached(previousK);
+        auto previousY = previousX - previousK;
+        // The elements matched after the edit
+        for (auto start = add ? previousX : previousX + 1; x > start; --x, --y)
+        {
+          edits.push_back(Edit::Keep);
+        }
+        edits.push_back(add ? Edit::Add : Edit::Remove);
+        x = previousX;
+        y = previousY;
+      }
+      edits.insert(edits.end(), x, Edit::Keep);
+      reverse(edits.begin(), edits.end());
+    }
+    else
+    {
+      edits.insert(edits.end(), n, Edit::Remove);
+      edits.insert(edits.end(), m, Edit::Add);
+    }
+
+    // Between two kept elements, the removed and added elements are paired and diffed in place, the rest are removed or added.
+    // The indexes are the ones in the array as it is changed by the operations before.
+    auto size = path.size();
+    auto index = begin;
+    auto i = begin;
+    auto j = begin;
+    for (size_t e = 0; e < edits.size();)
+    {
+      if (edits[e] == Edit::Keep)
+      {
+        ++index;
+        ++i;
+        ++j;
+        ++e;
+        continue;
+      }
+      auto removed = int64_t(0);
+      auto added = int64_t(0);
+      for (; e < edits.size() && edits[e] != Edit::Keep; ++e)
+      {
+        ++(edits[e] == Edit::Remove ? removed : added);
+      }
+      auto changed = min(removed, added);
+      for (int64_t c = 0; c < changed; ++c, ++index)
+      {
+        AppendToken(path, to_wstring(index));
+        DiffValue(before[i + c], after[j + c], path, patch);
+        path.resize(size);
+      }
+      AppendToken(path, to_wstring(index));
+      for (auto r = changed; r < removed; ++r)
+      {
+        patch.PushBack(Operation(L"remove", path));
+      }
+      path.resize(size);
+      for (auto a = changed; a < added; ++a, ++index)
+      {
+        AppendToken(path, to_wstring(index));
+        patch.PushBack(Operation(L"add", path, after[j + a]));
+        path.resize(size);
+      }
+      i += removed;
+      j += added;
+    }
+  }
+
+  bool JsonPatch::Shared(Json const& left, Json const& right)
+  {
+    auto leftObject = get_if<JsonObject>(&left._value);
+    auto rightObject = get_if<JsonObject>(&right._value);
+    if (leftObject && rightObject)
+    {
+      return leftObject->_data == rightObject->_data;
+    }
+    auto leftArray = get_if<JsonArray>(&left._value);
+    auto rightArray = get_if<JsonArray>(&right._value);
+    return leftArray && rightArray && leftArray->_data == rightArray->_data;
+  }
+
+  bool JsonPatch::Matches(Json const& left, Json const& right)
+  {
+    return Shared(left, right) || (left.Hash() == right.Hash() && Equal(left, right));
+  }
+
+  void JsonPatch::AppendToken(wstring& path, KEY const& key)
+  {
+    path += L'/';
+    for (auto c : key)
+    {
+      switch (c)
+      {
+      case L'~': path += L"~0"; break;
+      case L'/': path += L"~1"; break;
+      default  : path += c;     break;
+      }
+    }
+  }
+
+  Json JsonPatch::Operation(wchar_t const* op, wstring const& path)
+  {
+    auto operation = JsonObject();
+    operation.Emplace(L"op"s, op);
+    operation.Emplace(L"path"s, path);
+    return operation;
+  }
+
+  Json JsonPatch::Operation(wchar_t const* op, wstring const& path, Json const& value)
+  {
+    auto operation = JsonObject();
+    operation.Emplace(L"op"s, op);
+    operation.Emplace(L"path"s, path);
+    operation.Emplace(L"value"s, value);
+    return operation;
+  }
+
+  void JsonPatch::Apply(Json& json, Json const& patch)
+  {
+    auto operations = get_if<JsonArray>(&patch._value);
+    if (!operations)
+    {
+      auto message = "Invalid JSON Patch, it has to be an array of operations!"s;
+      throw exception(message.c_str());
+    }
+    auto result = json;
+    for (int64_t i = 0; i < operations->Size(); ++i)
+    {
+      ApplyOperation(result, operations->At(i), i);
+    }
+    json = move(result);
+  }
+
+  void JsonPatch::ApplyOperation(Json& json, Json const& operation, int64_t index)
+  {
+    auto object = get_if<JsonObject>(&operation._value);
+    if (!object)
+    {
+      Fail(index, L"it has to be an object"s);
+    }
+    auto member = [&](KEY const& key) -> Json const&
+    {
+      if (auto value = object->Find(key))
+      {
+        return *value;
+      }
+      Fail(index, L"missing member: "s + key);
+    };
+    auto text = [&](KEY const& key) -> wstring const&
+    {
+      auto& value = member(key);
+      if (!value.Is(JsonType::String))
+      {
+        Fail(index, L"member "s + key + L" has to be a string"s);
+      }
+      return value.Get<wstring>();
+    };
+    auto pointer = [&](KEY const& key)
+    {
+      auto& value = text(key);
+      try
+      {
+        return JsonPointer(value);
+      }
+      catch (exception const&)
+      {
+        Fail(index, L"member "s + key + L" is not a valid JSON Pointer: "s + value);
+      }
+    };
+
+    auto& op = text(L"op"s);
+    auto path = pointer(L"path"s);
+    if (op == L"add")
+    {
+      Add(json, path, member(L"value"s), index);
+    }
+    else if (op == L"remove")
+    {
+      Remove(json, path, index);
+    }
+    else if (op == L"replace")
+    {
+      Find(json, path, index) = member(L"value"s);
+    }
+    else if (op == L"move")
+    {
+      auto from = pointer(L"from"s);
+      auto& source = from.ToString();
+      auto& destination = path.ToString();
+      if (destination.size() > source.size() && destination.compare(0, source.size(), source) == 0 && destination[source.size()] == L'/')
+      {
+        Fail(index, L"a value can not be moved into itself: "s + destination);
+      }
+      Add(json, path, Remove(json, from, index), index);
+    }
+    else if (op == L"copy")
+    {
+      Add(json, path, Find(as_const(json), pointer(L"from"s), index), index);
+    }
+    else if (op == L"test")
+    {
+      if (!Equal(Find(as_const(json), path, index), member(L"value"s)))
+      {
+        Fail(index, L"test failed at: "s + path.ToString());
+      }
+    }
+    else
+    {
+      Fail(index, L"unknown op: "s + op);
+    }
+  }
+
+  void JsonPatch::Add(Json& json, JsonPointer const& path, Json value, int64_t index)
+  {
+    if (path.Size() == 0)
+    {
+      json = move(value);
+      return;
+    }
+    auto parent = path.Resolve(json, path.Size() - 1);
+    auto& token = path._tokens.back();
+    if (auto object = parent ? get_if<JsonObject>(&parent->_value) : nullptr)
+    {
+      // Replaces the member if it is present already
+      (*object)[token.key] = move(value);
+    }
+    else if (auto array = parent ? get_if<JsonArray>(&parent->_value) : nullptr)
+    {
+      if (token.key == L"-")
+      {
+        array->PushBack(move(value));
+      }
+      else if (0 <= token.index && token.index <= array->Size())
+      {
+        array->Insert(token.index, move(value));
+      }
+      else
+      {
+        Fail(index, L"index out of range: "s + path.ToString());
+      }
+    }
+    else
+    {
+      Fail(index, L"path not found: "s + path.ToString());
+    }
+  }
+
+  Json JsonPatch::Remove(Json& json, JsonPointer const& path, int64_t index)
+  {
+    if (path.Size() == 0)
+    {
+      Fail(index, L"the whole document can not be removed"s);
+    }
+    if (auto parent = path.Resolve(json, path.Size() - 1))
+    {
+      auto& token = path._tokens.back();
+      if (auto object = get_if<JsonObject>(&parent->_value))
+      {
+        auto position = object->IndexOf(token.key, token.hash);
+        if (position != -1)
+        {
+          auto value = move(object->Detach().pairs[position].second);
+          object->Erase(token.key);
+          return value;
+        }
+      }
+      else if (auto array = get_if<JsonArray>(&parent->_value))
+      {
+        if (0 <= token.index && token.index < array->Size())
+        {
+          auto value = move(array->At(token.index));
+          array->Erase(token.index);
+          return value;
+        }
+      }
+    }
+    Fail(index, L"path not found: "s + path.ToString());
+  }
+
+  template<typename JSON>
+  JSON& JsonPatch::Find(JSON& json, JsonPointer const& path, int64_t index)
+  {
+    if (auto value = path.Find(json))
+    {
+      return *value;
+    }
+    Fail(index, L"path not found: "s + path.ToString());
+  }
+
+  void JsonPatch::Fail(int64_t index, wstring const& reason)
+  {
+    auto message = WString2String(L"JSON Patch operation "s + to_wstring(index) + L" failed, "s + reason + L"!"s);
+    throw exception(message.c_str());
+  }
+
+  void JsonPatch::Merge(Json& json, Json const& patch)
+  {
+    // The copy shares the contents of patch, and keeps them unchanged while json is modified, even if patch is a part of json
+    MergeValue(json, Json(patch));
+  }
+
+  void JsonPatch::MergeValue(Json& json, Json const& patch)
+  {
+    auto members = get_if<JsonObject>(&patch._value);
+    if (!members)
+    {
+      json = patch;
+      return;
+    }
+    if (!json.Is(JsonType::Object))
+    {
+      json = JsonObject();
+    }
+    auto& object = get<JsonObject>(json._value);
+    for (auto& [key, value] : *members)
+    {
+      if (value.Is(JsonType::Null))
+      {
+        object.Erase(key);
+      }
+      else
+      {
+        MergeValue(object[key], value);
+      }
+    }
+  }
+
+  bool JsonPatch::Equal(Json const& left, Json const& right)
+  {
+    if (left.Is(JsonType::Number) && right.Is(JsonType::Number))
+    {
+      return left == right;
+    }
+    if (left._value.index() != right._value.index())
+    {
+      return false;
+    }
+    if (auto object = get_if<JsonObject>(&left._value))
+    {
+      auto& other = get<JsonObject>(right._value);
+      if (object->_data == other._data)
+      {
+        return true;
+      }
+      if (object->Size() != other.Size())
+      {
+        return false;
+      }
+      for (auto& [key, value] : *object)
+      {
+        auto match = other.Find(key);
+        if (!match || !Equal(value, *match)) return false;
+      }
+      return true;
+    }
+    if (auto array = get_if<JsonArray>(&left._value))
+    {
+      auto& other = get<JsonArray>(right._value);
+      if (array->_data == other._data)
+      {
+        return true;
+      }
+      if (array->Size() != other.Size())
+      {
+        return false;
+      }
+      for (int64_t i = 0; i < array->Size(); ++i)
+      {
+        if (!Equal(array->At(i), other.At(i))) return false;
+      }
+      return true;
+    }
+    return left == right;
+  }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include "Value.h"
+
+#include <string>
+#include <cstdint>
+
+namespace Json4CPP
+{
+  class JSON_API Json;
+  class JSON_API JsonObject;
+  class JSON_API JsonArray;
+  class JSON_API JsonPointer;
+
+  namespace Detail
+  {
+    // RFC 6902 JSON Patch and RFC 7396 JSON Merge Patch, behind Json::Diff, Json::Apply and Json::Merge.
+    // Diff walks the two documents together. The members of objects are matched through the index of the other object, and the
+    // elements of arrays by the Myers algorithm, comparing their cached hashes first. Objects and arrays shared by copies are skipped
+    // without looking into them, so diffing a document against a modified copy of it only visits the modified paths.
+    class JSON_API JsonPatch
+    {
+    private:
+      static void DiffValue (Json       const& source, Json       const& target, std::wstring& path, JsonArray& patch);
+      static void DiffObject(JsonObject const& source, JsonObject const& target, std::wstring& path, JsonArray& patch);
+      static void DiffArray (JsonArray  const& source, JsonArray  const& target, std::wstring& path, JsonArray& patch);
+      // Whether left and right are objects or arrays which share their contents, so they are equal without comparing them
+      static bool Shared (Json const& left, Json const& right);
+      // Equal, but tells most of the different values apart by their cached hashes
+      static bool Matches(Json const& left, Json const& right);
+      // Appends key to path as a reference token, escaping '~' and '/'
+      static void AppendToken(std::wstring& path, KEY const& key);
+      static Json Operation(wchar_t const* op, std::wstring const& path);
+      static Json Operation(wchar_t const* op, std::wstring const& path, Json const& value);
+
+      static void ApplyOperation(Json& json, Json const& operation, int64_t index);
+      static void Add   (Json& json, JsonPointer const& path, Json value, int64_t index);
+      static Json Remove(Json& json, JsonPointer const& path, int64_t index);
+      template<typename JSON>
+      static JSON& Find (JSON& json, JsonPointer const& path, int64_t index);
+      static void MergeValue(Json& json, Json const& patch);
+      [[noreturn]] static void Fail(int64_t index, std::wstring const& reason);
+    public:
+      // Above this many inserted and removed elements between the common beginning and end of two arrays, Diff stops looking for
+      // the shortest edit script, and changes the remaining elements in place, removing or adding the ones over the shorter array.
+      static constexpr int64_t ArrayEditLimit = 1024;
+
+      // Returns the patch, an array of add, remove and replace operations, which turns source into target. Nested values are
+      // diffed recursively, so a changed member deep in the document is a single replace operation.
+      // The order of the members is not part of the patch, as RFC 6902 treats objects as unordered. The added members end up
+      // after the others, so the patched source is equal to target by Equal, but not by operator== if they are in another order.
+      static Json Diff(Json const& source, Json const& target);
+      // Applies the operations of patch to json in order. If one of them fails, json is left unchanged and an exception is thrown
+      // with the position of the operation. The operations are applied to a copy, which shares the contents of json until they
+      // change them, so only the modified paths are copied.
+      static void Apply(Json& json, Json const& patch);
+      // Applies patch as a merge patch: its members replace the ones of json recursively, and its null members remove them.
+      // If patch is not an object, it replaces json.
+      static void Merge(Json& json, Json const& patch);
+      // Equality of the test operation: numbers are equal if their values are, objects regardless of the order of their members,
+      // but true is not equal to 1, unlike with operator==.
+      static bool Equal(Json const& left, Json const& right);
+    };
+  }
+}
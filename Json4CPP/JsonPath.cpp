@@ -0,0 +1,692 @@
+#include "stdafx.h"
+
+#include "JsonPath.h"
+#include "Json.h"
+#include "Helper.h"
+
+using namespace std;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP
+{
+  // Recursive descent parser of the query, fills the segments and filters of the JsonPath.
+  class JsonPath::Parser
+  {
+  private:
+    JsonPath& _query;
+    wstring_view _text;
+    size_t _position;
+
+    [[noreturn]] void Fail() const
+    {
+      auto message = WString2String(L"Invalid JSONPath at position "s + to_wstring(_position) + L": "s + wstring(_text) + L"!"s);
+      throw exception(message.c_str());
+    }
+
+    wchar_t Peek() const
+    {
+      return _position < _text.size() ? _text[_position] : L'\0';
+    }
+
+    bool Accept(wchar_t c)
+    {
+      if (Peek() != c) return false;
+      ++_position;
+      return true;
+    }
+
+    bool Accept(wstring_view text)
+    {
+      if (_text.substr(_position, text.size()) != text) return false;
+      _position += text.size();
+      return true;
+    }
+
+    void Expect(wchar_t c)
+    {
+      if (!Accept(c)) Fail();
+    }
+
+    void SkipWhitespace()
+    {
+      while (Peek() == L' ' || Peek() == L'\t' || Peek() == L'\n' || Peek() == L'\r')
+      {
+        ++_position;
+      }
+    }
+
+    static bool IsNameFirst(wchar_t c)
+    {
+      return (L'a' <= c && c <= L'z') || (L'A' <= c && c <= L'Z') || c == L'_' || c >= 0x80;
+    }
+
+    static bool IsNameChar(wchar_t c)
+    {
+      return IsNameFirst(c) || (L'0' <= c && c <= L'9');
+    }
+
+    static Selector Name(KEY key)
+    {
+      auto hash = JsonObject::HashKey(key);
+      return Selector{ SelectorType::Name, move(key), hash, 0, 0, 1, false, false };
+    }
+
+    static Selector Index(int64_t index)
+    {
+      return Selector{ SelectorType::Index, KEY(), 0, index, 0, 1, false, false };
+    }
+
+    static Selector Wildcard()
+    {
+      return Selector{ SelectorType::Wildcard, KEY(), 0, 0, 0, 1, false, false };
+    }
+
+    // Name in the dot notation, like .name
+    KEY ParseName()
+    {
+      auto begin = _position;
+      if (!IsNameFirst(Peek())) Fail();
+      while (IsNameChar(Peek()))
+      {
+        ++_position;
+      }
+      return KEY(_text.substr(begin, _position - begin));
+    }
+
+    // Quoted with ' or ", with the escapes of JSON strings, and \' too
+    wstring ParseString()
+    {
+      auto quote = Peek();
+      if (quote != L'\'' && quote != L'"') Fail();
+      ++_position;
+      auto result = wstring();
+      while (!Accept(quote))
+      {
+        auto c = Peek();
+        if (c == L'\0' && _position >= _text.size()) Fail();
+        ++_position;
+        if (c != L'\\')
+        {
+          result += c;
+          continue;
+        }
+        switch (c = Peek(), ++_position, c)
+        {
+        case L'\'': result += L'\''; break;
+        case L'"' : result += L'"' ; break;
+        case L'\\': result += L'\\'; break;
+        case L'/' : result += L'/' ; break;
+        case L'b' : result += L'\b'; break;
+        case L'f' : result += L'\f'; break;
+        case L'n' : result += L'\n'; break;
+        case L'r' : result += L'\r'; break;
+        case L't' : result += L'\t'; break;
+        case L'u' :
+        {
+          auto code = 0;
+          for (int i = 0; i < 4; ++i, ++_position)
+          {
+            auto h = Peek();
+            if      (L'0' <= h && h <= L'9') code = code * 16 + (h - L'0');
+            else if (L'a' <= h && h <= L'f') code = code * 16 + (h - L'a' + 10);
+            else if (L'A' <= h && h <= L'F') code = code * 16 + (h - L'A' + 10);
+            else Fail();
+          }
+          result += (wchar_t)code;
+          break;
+        }
+        default: --_position; Fail();
+        }
+      }
+      return result;
+    }
+
+    bool IsInteger() const
+    {
+      auto c = Peek();
+      return c == L'-' || (L'0' <= c && c <= L'9');
+    }
+
+    int64_t ParseInteger()
+    {
+      auto begin = _position;
+      Accept(L'-');
+      if (!(L'0' <= Peek() && Peek() <= L'9')) Fail();
+      while (L'0' <= Peek() && Peek() <= L'9')
+      {
+        ++_position;
+      }
+      if (_position - begin > 18)
+      {
+        _position = begin;
+        Fail();
+      }
+      return stoll(wstring(_text.substr(begin, _position - begin)));
+    }
+
+    Selector ParseSelector()
+    {
+      SkipWhitespace();
+      auto c = Peek();
+      if (c == L'\'' || c == L'"')
+      {
+        return Name(ParseString());
+      }
+      if (Accept(L'*'))
+      {
+        return Wildcard();
+      }
+      if (Accept(L'?'))
+      {
+        SkipWhitespace();
+        auto filter = ParseOr();
+        return Selector{ SelectorType::Filter, KEY(), 0, filter, 0, 1, false, false };
+      }
+      auto selector = Index(0);
+      if (IsInteger())
+      {
+        selector.index = ParseInteger();
+        selector.hasStart = true;
+        SkipWhitespace();
+      }
+      if (!Accept(L':'))
+      {
+        if (!selector.hasStart) Fail();
+        return selector;
+      }
+      selector.type = SelectorType::Slice;
+      SkipWhitespace();
+      if (IsInteger())
+      {
+        selector.end = ParseInteger();
+        selector.hasEnd = true;
+        SkipWhitespace();
+      }
+      if (Accept(L':'))
+      {
+        SkipWhitespace();
+        if (IsInteger())
+        {
+          selector.step = ParseInteger();
+        }
+      }
+      return selector;
+    }
+
+    void ParseBracket(vector<Selector>& selectors)
+    {
+      do
+      {
+        selectors.push_back(ParseSelector());
+        SkipWhitespace();
+      } while (Accept(L','));
+      Expect(L']');
+    }
+
+    // Path of names and indexes after @ or $
+    void ParseSingularPath(vector<Selector>& path)
+    {
+      while (true)
+      {
+        if (Accept(L'.'))
+        {
+          path.push_back(Name(ParseName()));
+        }
+        else if (Accept(L'['))
+        {
+          SkipWhitespace();
+          auto c = Peek();
+          path.push_back(c == L'\'' || c == L'"' ? Name(ParseString()) : Index(ParseInteger()));
+          SkipWhitespace();
+          Expect(L']');
+        }
+        else
+        {
+          break;
+        }
+      }
+    }
+
+    Operand ParseOperand()
+    {
+      SkipWhitespace();
+      auto operand = Operand{ Operand::Type::Literal, Json(), {} };
+      auto c = Peek();
+      if (Accept(L'@') || Accept(L'$'))
+      {
+        operand.type = c == L'@' ? Operand::Type::Current : Operand::Type::Root;
+        ParseSingularPath(operand.path);
+      }
+      else if (c == L'\'' || c == L'"')
+      {
+        operand.literal = ParseString();
+      }
+      else
+      {
+        // Numbers and the literals are parsed the same way as in JSON text, which only has arrays and objects at the root
+        auto begin = _position;
+        if (IsInteger())
+        {
+          while (IsInteger() || Peek() == L'.' || Peek() == L'e' || Peek() == L'E' || Peek() == L'+')
+          {
+            ++_position;
+          }
+        }
+        else if (!Accept(L"true"sv) && !Accept(L"false"sv) && !Accept(L"null"sv))
+        {
+          Fail();
+        }
+        if (IsNameChar(Peek()))
+        {
+          Fail();
+        }
+        try
+        {
+          operand.literal = Json::Parse(L"["s + wstring(_text.substr(begin, _position - begin)) + L"]"s).At(0);
+        }
+        catch (exception const&)
+        {
+          _position = begin;
+          Fail();
+        }
+      }
+      return operand;
+    }
+
+    int64_t Add(Filter filter)
+    {
+      _query._filters.push_back(move(filter));
+      return _query._filters.size() - 1;
+    }
+
+    int64_t ParseComparison()
+    {
+      auto first = ParseOperand();
+      SkipWhitespace();
+      auto operators = { pair(L"=="sv, FilterType::Equal), pair(L"!="sv, FilterType::NotEqual), pair(L"<="sv, FilterType::LessOrEqual),
+                         pair(L">="sv, FilterType::GreaterOrEqual), pair(L"<"sv, FilterType::Less), pair(L">"sv, FilterType::Greater) };
+      for (auto& [text, type] : operators)
+      {
+        if (Accept(text))
+        {
+          auto second = ParseOperand();
+          return Add(Filter{ type, -1, -1, move(first), move(second) });
+        }
+      }
+      // Only a path can be tested for existence
+      if (first.type == Operand::Type::Literal) Fail();
+      return Add(Filter{ FilterType::Exists, -1, -1, move(first), Operand{} });
+    }
+
+    int64_t ParseUnary()
+    {
+      SkipWhitespace();
+      if (Accept(L'!'))
+      {
+        auto operand = ParseUnary();
+        return Add(Filter{ FilterType::Not, operand, -1, Operand{}, Operand{} });
+      }
+      if (Accept(L'('))
+      {
+        auto expression = ParseOr();
+        SkipWhitespace();
+        Expect(L')');
+        return expression;
+      }
+      return ParseComparison();
+    }
+
+    int64_t ParseAnd()
+    {
+      auto left = ParseUnary();
+      while (SkipWhitespace(), Accept(L"&&"sv))
+      {
+        auto right = ParseUnary();
+        left = Add(Filter{ FilterType::And, left, right, Operand{}, Operand{} });
+      }
+      return left;
+    }
+
+    int64_t ParseOr()
+    {
+      auto left = ParseAnd();
+      while (SkipWhitespace(), Accept(L"||"sv))
+      {
+        auto right = ParseAnd();
+        left = Add(Filter{ FilterType::Or, left, right, Operand{}, Operand{} });
+      }
+      return left;
+    }
+
+  public:
+    Parser(JsonPath& query) : _query(query), _text(query._path), _position(0)
+    {
+
+    }
+
+    void Parse()
+    {
+      SkipWhitespace();
+      Expect(L'$');
+      while (SkipWhitespace(), _position < _text.size())
+      {
+        auto segment = Segment{ false, {} };
+        if (Accept(L".."sv))
+        {
+          segment.descendant = true;
+          if      (Accept(L'[')) ParseBracket(segment.selectors);
+          else if (Accept(L'*')) segment.selectors.push_back(Wildcard());
+          else                   segment.selectors.push_back(Name(ParseName()));
+        }
+        else if (Accept(L'.'))
+        {
+          if (Accept(L'*')) segment.selectors.push_back(Wildcard());
+          else              segment.selectors.push_back(Name(ParseName()));
+        }
+        else if (Accept(L'['))
+        {
+          ParseBracket(segment.selectors);
+        }
+        else
+        {
+          Fail();
+        }
+        _query._segments.push_back(move(segment));
+      }
+    }
+  };
+
+  // Numbers are compared by value, everything else only to values of the same type, unlike the operators of Json, where true == 1.
+  static bool IsNumber(Json const& value)
+  {
+    auto type = value.Type();
+    return type == JsonType::Integer || type == JsonType::Real;
+  }
+
+  static bool Equal(Json const* left, Json const* right)
+  {
+    if (!left || !right) return left == right;
+    if (IsNumber(*left) && IsNumber(*right)) return *left == *right;
+    return left->Type() == right->Type() && *left == *right;
+  }
+
+  static bool Less(Json const* left, Json const* right)
+  {
+    if (!left || !right) return false;
+    if (IsNumber(*left) && IsNumber(*right)) return *left < *right;
+    return left->Type() == JsonType::String && right->Type() == JsonType::String && *left < *right;
+  }
+
+  // Visitor of the non-const overloads, the results of which can be used to modify the values. Walk keeps the positions of the
+  // values on the way to the current one, and references only the containers on the way to a match, see ReferencePath.
+  template<typename Function>
+  struct MutableVisitor
+  {
+    Function function;
+    vector<int64_t> positions;
+
+    bool operator()(Json const& value)
+    {
+      return function(value);
+    }
+  };
+  template<typename Function>
+  MutableVisitor(Function)->MutableVisitor<Function>;
+
+  template<typename Visitor>
+  constexpr bool IsMutable = false;
+  template<typename Function>
+  constexpr bool IsMutable<MutableVisitor<Function>> = true;
+
+  // Calls step for the child at position, with the position added to the ones the mutable visitor keeps.
+  template<typename Visitor, typename Step>
+  static bool Enter(Visitor& visitor, int64_t position, Step const& step)
+  {
+    if constexpr (IsMutable<Visitor>)
+    {
+      visitor.positions.push_back(position);
+      auto result = step();
+      visitor.positions.pop_back();
+      return result;
+    }
+    else
+    {
+      return step();
+    }
+  }
+
+  JsonPath::JsonPath(wstring_view path) : _path(path)
+  {
+    Parser(*this).Parse();
+  }
+
+  wstring const& JsonPath::ToString() const
+  {
+    return _path;
+  }
+
+  Json const* JsonPath::Resolve(Json const& root, Json const& value, Operand const& operand) const
+  {
+    if (operand.type == Operand::Type::Literal)
+    {
+      return &operand.literal;
+    }
+    auto current = operand.type == Operand::Type::Current ? &value : &root;
+    for (auto& selector : operand.path)
+    {
+      if (auto object = get_if<JsonObject>(&current->_value); object && selector.type == SelectorType::Name)
+      {
+        auto index = object->IndexOf(selector.key, selector.hash);
+        current = index == -1 ? nullptr : &object->Contents().pairs[index].second;
+      }
+      else if (auto array = get_if<JsonArray>(&current->_value); array && selector.type == SelectorType::Index)
+      {
+        current = array->Find(selector.index < 0 ? selector.index + array->Size() : selector.index);
+      }
+      else
+      {
+        current = nullptr;
+      }
+      if (!current) break;
+    }
+    return current;
+  }
+
+  Json& JsonPath::ReferencePath(Json& root, vector<int64_t> const& positions)
+  {
+    auto current = &root;
+    for (auto position : positions)
+    {
+      if (auto object = get_if<JsonObject>(&current->_value))
+      {
+        current = &object->Reference().pairs[position].second;
+      }
+      else
+      {
+        current = &get<JsonArray>(current->_value).Reference().values[position];
+      }
+    }
+    return *current;
+  }
+
+  bool JsonPath::Test(Json const& root, Json const& value, int64_t filter) const
+  {
+    auto& node = _filters[filter];
+    switch (node.type)
+    {
+    case FilterType::And           : return  Test(root, value, node.left) && Test(root, value, node.right);
+    case FilterType::Or            : return  Test(root, value, node.left) || Test(root, value, node.right);
+    case FilterType::Not           : return !Test(root, value, node.left);
+    case FilterType::Exists        : return  Resolve(root, value, node.first) != nullptr;
+    default: break;
+    }
+    auto first  = Resolve(root, value, node.first );
+    auto second = Resolve(root, value, node.second);
+    switch (node.type)
+    {
+    case FilterType::Equal         : return  Equal(first, second);
+    case FilterType::NotEqual      : return !Equal(first, second);
+    case FilterType::Less          : return  Less (first, second);
+    case FilterType::LessOrEqual   : return  Less (first, second) || Equal(first, second);
+    case FilterType::Greater       : return  Less (second, first);
+    case FilterType::GreaterOrEqual: return  Less (second, first) || Equal(first, second);
+    default                        : return false;
+    }
+  }
+
+  template<typename Visitor>
+  bool JsonPath::Walk(Json const& root, Json const& value, size_t segment, Visitor& visitor) const
+  {
+    if (segment == _segments.size())
+    {
+      if constexpr (IsMutable<Visitor>)
+      {
+        // The walk reads the contents shared with the copies, only the match is referenced
+        return visitor(ReferencePath(const_cast<Json&>(root), visitor.positions));
+      }
+      return visitor(value);
+    }
+    return _segments[segment].descendant ? Descend(root, value, segment, visitor) : Select(root, value, segment, visitor);
+  }
+
+  template<typename Visitor>
+  bool JsonPath::Descend(Json const& root, Json const& value, size_t segment, Visitor& visitor) const
+  {
+    if (!Select(root, value, segment, visitor))
+    {
+      return false;
+    }
+    if (auto object = get_if<JsonObject>(&value._value))
+    {
+      auto& pairs = object->Contents().pairs;
+      for (int64_t i = 0; i < (int64_t)pairs.size(); ++i)
+      {
+        if (!Enter(visitor, i, [&] { return Descend(root, pairs[i].second, segment, visitor); })) return false;
+      }
+    }
+    else if (auto array = get_if<JsonArray>(&value._value))
+    {
+      auto& values = array->Contents().values;
+      for (int64_t i = 0; i < (int64_t)values.size(); ++i)
+      {
+        if (!Enter(visitor, i, [&] { return Descend(root, values[i], segment, visitor); })) return false;
+      }
+    }
+    return true;
+  }
+
+  template<typename Visitor>
+  bool JsonPath::Select(Json const& root, Json const& value, size_t segment, Visitor& visitor) const
+  {
+    auto object = get_if<JsonObject>(&value._value);
+    auto array  = get_if<JsonArray >(&value._value);
+    // Calls Walk with the member or element at position
+    auto walk = [&](Json const& child, int64_t position)
+    {
+      return Enter(visitor, position, [&] { return Walk(root, child, segment + 1, visitor); });
+    };
+    // Calls Walk with every member or element for which predicate returns true
+    auto children = [&](auto&& predicate)
+    {
+      if (object)
+      {
+        auto& pairs = object->Contents().pairs;
+        for (int64_t i = 0; i < (int64_t)pairs.size(); ++i)
+        {
+          if (predicate(pairs[i].second) && !walk(pairs[i].second, i)) return false;
+        }
+      }
+      else if (array)
+      {
+        auto& values = array->Contents().values;
+        for (int64_t i = 0; i < (int64_t)values.size(); ++i)
+        {
+          if (predicate(values[i]) && !walk(values[i], i)) return false;
+        }
+      }
+      return true;
+    };
+    for (auto& selector : _segments[segment].selectors)
+    {
+      switch (selector.type)
+      {
+      case SelectorType::Name:
+        if (object)
+        {
+          auto index = object->IndexOf(selector.key, selector.hash);
+          if (index != -1 && !walk(object->Contents().pairs[index].second, index)) return false;
+        }
+        break;
+      case SelectorType::Index:
+        if (array)
+        {
+          auto index = selector.index < 0 ? selector.index + array->Size() : selector.index;
+          auto child = array->Find(index);
+          if (child && !walk(*child, index)) return false;
+        }
+        break;
+      case SelectorType::Wildcard:
+        if (!children([](Json const&) { return true; })) return false;
+        break;
+      case SelectorType::Slice:
+        if (array && selector.step != 0)
+        {
+          // Bounds as in RFC 9535, negative ones count from the end, and both are clamped to the array
+          auto size = array->Size();
+          auto normalize = [&](int64_t i) { return i < 0 ? i + size : i; };
+          if (selector.step > 0)
+          {
+            auto lower = selector.hasStart ? clamp<int64_t>(normalize(selector.index), 0, size) : 0;
+            auto upper = selector.hasEnd   ? clamp<int64_t>(normalize(selector.end  ), 0, size) : size;
+            for (auto i = lower; i < upper; i += selector.step)
+            {
+              if (!walk(array->At(i), i)) return false;
+            }
+          }
+          else
+          {
+            auto upper = selector.hasStart ? clamp<int64_t>(normalize(selector.index), -1, size - 1) : size - 1;
+            auto lower = selector.hasEnd   ? clamp<int64_t>(normalize(selector.end  ), -1, size - 1) : -1;
+            for (auto i = upper; lower < i; i += selector.step)
+            {
+              if (!walk(array->At(i), i)) return false;
+            }
+          }
+        }
+        break;
+      case SelectorType::Filter:
+        if (!children([&](Json const& child) { return Test(root, child, selector.index); })) return false;
+        break;
+      }
+    }
+    return true;
+  }
+
+  void JsonPath::Evaluate(Json const& json, vector<Json const*>& results) const
+  {
+    auto visitor = [&](Json const& value) { results.push_back(&value); return true; };
+    Walk(json, json, 0, visitor);
+  }
+
+  void JsonPath::Evaluate(Json& json, vector<Json*>& results) const
+  {
+    auto visitor = MutableVisitor{ [&](Json const& value) { results.push_back(const_cast<Json*>(&value)); return true; } };
+    Walk(json, json, 0, visitor);
+  }
+
+  Json const* JsonPath::First(Json const& json) const
+  {
+    auto result = (Json const*)nullptr;
+    auto visitor = [&](Json const& value) { result = &value; return false; };
+    Walk(json, json, 0, visitor);
+    return result;
+  }
+
+  Json* JsonPath::First(Json& json) const
+  {
+    auto result = (Json*)nullptr;
+    auto visitor = MutableVisitor{ [&](Json const& value) { result = const_cast<Json*>(&value); return false; } };
+    Walk(json, json, 0, visitor);
+    return result;
+  }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include "Value.h"
+#include "Json.h"
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace Json4CPP
+{
+  // JSONPath query, compiled once and evaluated against any number of Json values. The supported subset follows RFC 9535:
+  //   $                   the root
+  //   .name  ['name']     member of an object, the keys are hashed in advance
+  //   [0]  [-1]           element of an array, negative indexes count from the end
+  //   .*  [*]             every member or element
+  //   [start:end:step]    slice of an array, any part can be omitted
+  //   ['a','b']  [0,2]    union of the selectors above
+  //   ..name  ..*  ..[0]  recursive descent, the selector is applied to the value and to all of its descendants
+  //   [?@.price < 10]     filter, also [?(...)], with ==, !=, <, <=, >, >=, &&, || and !, and existence tests like [?@.isbn].
+  //                       The operands are literals (numbers, 'strings', "strings", true, false, null) and paths from @ or $,
+  //                       which can only contain names and indexes, so that they select at most one value.
+  // Evaluation walks the Json recursively, and does not allocate besides growing the vector of the results, and the positions
+  // of the values on the way to the current one for the non-const overloads.
+  class JSON_API JsonPath
+  {
+  private:
+    enum class SelectorType : uint8_t { Name, Index, Wildcard, Slice, Filter };
+    struct Selector
+    {
+      SelectorType type;
+      KEY key;          // Name
+      uint32_t hash;    // JsonObject::HashKey of key
+      int64_t index;    // Index, the start of a Slice, or the position of the Filter in _filters
+      int64_t end;      // Slice
+      int64_t step;     // Slice
+      bool hasStart;    // Slice
+      bool hasEnd;      // Slice
+    };
+    struct Segment
+    {
+      bool descendant;
+#pragma warning(suppress: 4251)
+      std::vector<Selector> selectors;
+    };
+    // Literal or a path with only names and indexes, from the current value (@) or from the root ($)
+    struct Operand
+    {
+      enum class Type : uint8_t { Literal, Current, Root } type;
+      Json literal;
+#pragma warning(suppress: 4251)
+      std::vector<Selector> path;
+    };
+    enum class FilterType : uint8_t { Exists, Equal, NotEqual, Less, LessOrEqual, Greater, GreaterOrEqual, And, Or, Not };
+    // Node of a filter expression, And, Or and Not refer to their operands by their position in _filters
+    struct Filter
+    {
+      FilterType type;
+      int64_t left;
+      int64_t right;
+      Operand first;
+      Operand second;
+    };
+    class Parser;
+
+#pragma warning(suppress: 4251)
+    std::wstring _path;
+#pragma warning(suppress: 4251)
+    std::vector<Segment> _segments;
+#pragma warning(suppress: 4251)
+    std::vector<Filter> _filters;
+
+    template<typename Visitor> bool Walk    (Json const& root, Json const& value, size_t segment, Visitor& visitor) const;
+    template<typename Visitor> bool Descend (Json const& root, Json const& value, size_t segment, Visitor& visitor) const;
+    template<typename Visitor> bool Select  (Json const& root, Json const& value, size_t segment, Visitor& visitor) const;
+    bool                            Test    (Json const& root, Json const& value, int64_t filter) const;
+    Json const*                     Resolve (Json const& root, Json const& value, Operand const& operand) const;
+    // Follows the positions of the members and elements from root. The containers on the way are detached from their copies and
+    // marked referenced, as the result of a non-const overload can be modified at any time later, the rest of them stay shared.
+    static Json&                    ReferencePath(Json& root, std::vector<int64_t> const& positions);
+  public:
+    // Throws if path is not a valid query of the supported subset, with the position where it went wrong.
+    JsonPath(std::wstring_view path);
+
+    // The query as it was given.
+    std::wstring const& ToString() const;
+
+    // Appends the matches to results, in the order of the document, and does not clear it first,
+    // so the same vector can be reused between evaluations without allocating again.
+    void        Evaluate(Json const& json, std::vector<Json const*>& results) const;
+    void        Evaluate(Json      & json, std::vector<Json      *>& results) const;
+    // Returns the first match, or nullptr if there is none, and stops walking there.
+    Json const* First   (Json const& json) const;
+    Json      * First   (Json      & json) const;
+  };
+}
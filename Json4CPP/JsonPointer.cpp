@@ -0,0 +1,129 @@
+#include "stdafx.h"
+
+#include "JsonPointer.h"
+#include "Json.h"
+#include "Helper.h"
+
+using namespace std;
+using namespace Json4CPP::Detail;
+
+namespace Json4CPP
+{
+  JsonPointer::JsonPointer(wstring_view pointer) : _pointer(pointer)
+  {
+    if (pointer.empty())
+    {
+      return;
+    }
+    if (pointer[0] != L'/')
+    {
+      auto message = WString2String(L"Invalid JSON Pointer, it has to start with '/': "s + _pointer + L"!"s);
+      throw exception(message.c_str());
+    }
+    for (size_t begin = 1, end; begin <= pointer.size(); begin = end + 1)
+    {
+      end = min(pointer.find(L'/', begin), pointer.size());
+      auto token = Token{ KEY(), 0, -1 };
+      for (auto i = begin; i < end; ++i)
+      {
+        if (pointer[i] != L'~')
+        {
+          token.key += pointer[i];
+        }
+        else if (i + 1 < end && (pointer[i + 1] == L'0' || pointer[i + 1] == L'1'))
+        {
+          token.key += pointer[++i] == L'0' ? L'~' : L'/';
+        }
+        else
+        {
+          auto message = WString2String(L"Invalid JSON Pointer, '~' has to be followed by '0' or '1': "s + _pointer + L"!"s);
+          throw exception(message.c_str());
+        }
+      }
+      // Array indexes are written in decimal without leading zeros, the ones too large for an int64_t can not be in range anyway
+      auto digits = !token.key.empty() && token.key.size() <= 18 && (token.key[0] != L'0' || token.key.size() == 1) &&
+                    all_of(token.key.begin(), token.key.end(), [](wchar_t c) { return L'0' <= c && c <= L'9'; });
+      if (digits)
+      {
+        token.index = stoll(token.key);
+      }
+      token.hash = JsonObject::HashKey(token.key);
+      _tokens.push_back(move(token));
+    }
+  }
+
+  wstring const& JsonPointer::ToString() const
+  {
+    return _pointer;
+  }
+
+  int64_t JsonPointer::Size() const
+  {
+    return _tokens.size();
+  }
+
+  template<typename JSON>
+  JSON* JsonPointer::Resolve(JSON& json, size_t size) const
+  {
+    auto current = &json;
+    for (size_t i = 0; i < size; ++i)
+    {
+      auto& token = _tokens[i];
+      if (auto object = get_if<JsonObject>(&current->_value))
+      {
+        auto index = object->IndexOf(token.key, token.hash);
+        if (index == -1) return nullptr;
+        if constexpr (is_const_v<JSON>)
+        {
+          current = &object->Contents().pairs[index].second;
+        }
+        else
+        {
+          current = &object->Reference().pairs[index].second;
+        }
+      }
+      else if (auto array = get_if<JsonArray>(&current->_value))
+      {
+        current = array->Find(token.index);
+        if (!current) return nullptr;
+      }
+      else
+      {
+        return nullptr;
+      }
+    }
+    return current;
+  }
+
+  Json const* JsonPointer::Find(Json const& json) const
+  {
+    return Resolve(json, _tokens.size());
+  }
+
+  Json* JsonPointer::Find(Json& json) const
+  {
+    return Resolve(json, _tokens.size());
+  }
+
+  Json const& JsonPointer::At(Json const& json) const
+  {
+    if (auto value = Find(json))
+    {
+      return *value;
+    }
+    auto message = WString2String(L"Path not found: "s + _pointer + L"!"s);
+    throw out_of_range(message.c_str());
+  }
+
+  Json& JsonPointer::At(Json& json) const
+  {
+    if (auto value = Find(json))
+    {
+      return *value;
+    }
+    auto message = WString2String(L"Path not found: "s + _pointer + L"!"s);
+    throw out_of_range(message.c_str());
+  }
+
+  template Json* JsonPointer::Resolve(Json& json, size_t size) const;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include "Value.h"
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace Json4CPP
+{
+  namespace Detail
+  {
+    class JSON_API JsonPatch;
+  }
+  class JSON_API Json;
+
+  // RFC 6901 JSON Pointer, for example L"/items/0/name". The pointer is parsed once, with the hash of every key computed in advance,
+  // so resolving it against a Json only looks up the keys and indexes, without building strings or allocating.
+  class JSON_API JsonPointer
+  {
+  private:
+    friend class Detail::JsonPatch;
+    struct Token
+    {
+      KEY key;       // Unescaped, ~0 and ~1 are replaced by ~ and /
+      uint32_t hash; // JsonObject::HashKey of key
+      int64_t index; // The array index the token stands for, or -1 if it is not one, like "-" or "01"
+    };
+#pragma warning(suppress: 4251)
+    std::wstring _pointer;
+#pragma warning(suppress: 4251)
+    std::vector<Token> _tokens;
+
+    // Follows the first size tokens from json. If json is not const, the containers on the way are detached from their copies,
+    // drop their cached hash and are marked referenced, as the result can be modified at any time later.
+    template<typename JSON>
+    JSON* Resolve(JSON& json, size_t size) const;
+  public:
+    // Throws if pointer is neither empty nor starts with '/', or if a '~' is not followed by '0' or '1'.
+    JsonPointer(std::wstring_view pointer);
+
+    // The pointer as it was given.
+    std::wstring const& ToString() const;
+    // The number of reference tokens, 0 for the whole document.
+    int64_t Size() const;
+
+    // Returns the value the pointer refers to in json, or nullptr if there is no such value.
+    Json const* Find(Json const& json) const;
+    Json      * Find(Json      & json) const;
+    // Same, but throws std::out_of_range if there is no such value.
+    Json const& At  (Json const& json) const;
+    Json      & At  (Json      & json) const;
+  };
+}
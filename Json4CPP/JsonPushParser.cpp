@@ -0,0 +1,184 @@
+#include "stdafx.h"
+
+#include "JsonPushParser.h"
+#include "JsonBuffer.h"
+
+using namespace std;
+
+namespace Json4CPP::Detail
+{
+  // Returns the length of the end of text which is the beginning of a UTF-8 sequence, that can only be decoded with more text.
+  static size_t IncompleteUtf8(string_view text)
+  {
+    for (size_t i = 1; i <= min<size_t>(3, text.size()); ++i)
+    {
+      auto c = (unsigned char)text[text.size() - i];
+      if (c < 0x80)
+      {
+        return 0;
+      }
+      if (c >= 0xC0)
+      {
+        auto length = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : 2;
+        return length > i ? i : 0;
+      }
+    }
+    return 0;
+  }
+
+  JsonPushParser::JsonPushParser(JsonHandler& handler) :
+    _handler(handler), _start(1, 0), _scanned(0), _inString(false), _escaped(false), _finished(false), _token(JsonTokenType::Undefined)
+  {
+
+  }
+
+  void JsonPushParser::Null        (               ) { _token = JsonTokenType::Null        ; _value = nullptr;     }
+  void JsonPushParser::String      (wstring&& value) { _token = JsonTokenType::String      ; _value = move(value); }
+  void JsonPushParser::Boolean     (bool      value) { _token = JsonTokenType::Boolean     ; _value = value;       }
+  void JsonPushParser::Real        (double    value) { _token = JsonTokenType::Real        ; _value = value;       }
+  void JsonPushParser::Integer     (int64_t   value) { _token = JsonTokenType::Integer     ; _value = value;       }
+  void JsonPushParser::PropertyName(wstring&& value) { _token = JsonTokenType::PropertyName; _value = move(value); }
+  void JsonPushParser::StartObject (               ) { _token = JsonTokenType::StartObject ; }
+  void JsonPushParser::EndObject   (               ) { _token = JsonTokenType::EndObject   ; }
+  void JsonPushParser::StartArray  (               ) { _token = JsonTokenType::StartArray  ; }
+  void JsonPushParser::EndArray    (               ) { _token = JsonTokenType::EndArray    ; }
+
+  void JsonPushParser::Emit()
+  {
+    switch (_token)
+    {
+    case JsonTokenType::Null        : _handler.Null        ();                               break;
+    case JsonTokenType::String      : _handler.String      (move(get<wstring>(_value)));     break;
+    case JsonTokenType::Boolean     : _handler.Boolean     (get<bool>(_value));              break;
+    case JsonTokenType::Real        : _handler.Real        (get<double>(_value));            break;
+    case JsonTokenType::Integer     : _handler.Integer     (get<int64_t>(_value));           break;
+    case JsonTokenType::PropertyName: _handler.PropertyName(move(get<wstring>(_value)));     break;
+    case JsonTokenType::StartObject : _handler.StartObject ();                               break;
+    case JsonTokenType::EndObject   : _handler.EndObject   ();                               break;
+    case JsonTokenType::StartArray  : _handler.StartArray  ();                               break;
+    case JsonTokenType::EndArray    : _handler.EndArray    ();                               break;
+    }
+  }
+
+  bool JsonPushParser::Scan()
+  {
+    auto ended = false;
+    for (; _scanned < _text.size(); ++_scanned)
+    {
+      auto c = _text[_scanned];
+      if (_escaped)
+      {
+        _escaped = false;
+      }
+      else if (c == '"')
+      {
+        ended |= _inString;
+        _inString = !_inString;
+      }
+      else if (c == '\\')
+      {
+        _escaped = _inString;
+      }
+    }
+    return ended;
+  }
+
+  void JsonPushParser::Parse()
+  {
+    // Until the end of the input, a UTF-8 sequence which is cut in half is left for the next chunk
+    auto text = string_view(_text);
+    text.remove_suffix(_finished ? 0 : IncompleteUtf8(text));
+    auto buffer = JsonBuffer<char>(text, _start);
+    auto consumed = size_t(0);
+    while (true)
+    {
+      _saved = _state;
+      auto found = false;
+      try
+      {
+        found = JsonLinter::Next(buffer, _state, *this);
+      }
+      catch (exception const& e)
+      {
+        // Reaching the end of the available text may be the reason of the error, more text may complete the token
+        if (!buffer.eof() || _finished)
+        {
+          _error = e.what();
+          throw;
+        }
+      }
+      // A token which reached the end of the available text may continue in the next chunk, like a number
+      if (buffer.eof() && !_finished)
+      {
+        _state = _saved;
+        break;
+      }
+      if (!found)
+      {
+        break;
+      }
+      Emit();
+      consumed = buffer.position();
+    }
+
+    // The text of the complete tokens is dropped, but never between \r and \n, for the positions in the error messages
+    if (consumed > 0 && _text[consumed - 1] == '\r')
+    {
+      --consumed;
+    }
+    if (consumed > 0)
+    {
+      _start = AdvancePosition(_start, string_view(_text.data(), consumed));
+      _text.erase(0, consumed);
+    }
+    // The rest starts between two tokens, so outside of any string
+    _scanned = 0;
+    _inString = false;
+    _escaped = false;
+    Scan();
+  }
+
+  void JsonPushParser::Push(string_view chunk)
+  {
+    if (!_error.empty())
+    {
+      throw exception(_error.c_str());
+    }
+    if (_finished)
+    {
+      auto message = "The input has already been finished!"s;
+      throw exception(message.c_str());
+    }
+    // The text before a string which is still open was already parsed, the string itself can only complete once it ends
+    auto waiting = _inString;
+    _text.append(chunk);
+    if (!Scan() && waiting)
+    {
+      return;
+    }
+    Parse();
+  }
+
+  void JsonPushParser::Finish()
+  {
+    if (!_error.empty())
+    {
+      throw exception(_error.c_str());
+    }
+    if (!_finished)
+    {
+      _finished = true;
+      Parse();
+    }
+  }
+
+  size_t JsonPushParser::Pending() const
+  {
+    return _text.size();
+  }
+
+  int64_t JsonPushParser::Depth() const
+  {
+    return _state.containers.size();
+  }
+}
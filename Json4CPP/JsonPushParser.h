@@ -0,0 +1,75 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include "JsonLinter.h"
+#include "JsonHandler.h"
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <cstdint>
+
+namespace Json4CPP::Detail
+{
+  // Push style parser for UTF-8 encoded text which arrives in chunks of any size, for example from the network.
+  // The tokens are passed to handler as soon as they are complete, the same tokens and the same errors as JsonLinter::Read produces from the whole text.
+  // Only the text of the token which is not complete yet is kept, together with the open containers, so the memory usage is bounded
+  // by the depth and the largest scalar. Tokens are parsed by JsonLinter::Next, a token which runs into the end of the available text
+  // is parsed again from its beginning once more text arrives, but not before a string which is still open ends.
+  class JSON_API JsonPushParser : private JsonHandler
+  {
+  private:
+    JsonHandler& _handler;
+#pragma warning(suppress: 4251)
+    JsonLinterState _state;
+#pragma warning(suppress: 4251)
+    JsonLinterState _saved;  // The state before the token which is being parsed
+#pragma warning(suppress: 4251)
+    std::string _text;       // The text after the last complete token
+    std::pair<uint64_t, uint64_t> _start; // { line, column } where _text starts
+    size_t _scanned;         // How much of _text has been scanned for strings
+    bool _inString;          // Whether _text ends inside of a string, which is not parsed again until it ends
+    bool _escaped;           // Whether _text ends with a backslash inside of a string
+    bool _finished;
+#pragma warning(suppress: 4251)
+    std::string _error;      // Once there was an error, it is thrown again by every call
+    JsonTokenType _token;
+#pragma warning(suppress: 4251)
+    VALUE_TOKEN _value;
+
+    void Null        (                     ) override;
+    void String      (std::wstring&& value ) override;
+    void Boolean     (bool           value ) override;
+    void Real        (double         value ) override;
+    void Integer     (int64_t        value ) override;
+    void PropertyName(std::wstring&& value ) override;
+    void StartObject (                     ) override;
+    void EndObject   (                     ) override;
+    void StartArray  (                     ) override;
+    void EndArray    (                     ) override;
+
+    // Passes the token which was parsed last to the handler.
+    void Emit();
+    // Parses as many tokens from _text as there are complete ones, and drops their text.
+    void Parse();
+    // Updates _inString and _escaped with the rest of _text, returns whether a string ended in it.
+    bool Scan();
+  public:
+    JsonPushParser(JsonHandler& handler);
+
+    // Appends chunk to the input, and passes every token which is complete to the handler.
+    void Push(std::string_view chunk);
+    // Marks the end of the input, and passes the rest of the tokens to the handler. Throws if the document is not complete.
+    void Finish();
+
+    // The number of bytes which are kept, because the token they belong to is not complete yet.
+    size_t Pending() const;
+    // The number of objects and arrays which are open after the last token.
+    int64_t Depth() const;
+  };
+}
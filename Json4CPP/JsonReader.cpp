@@ -0,0 +1,73 @@
+#include "stdafx.h"
+
+#include "JsonReader.h"
+#include "Helper.h"
+
+using namespace std;
+
+namespace Json4CPP::Detail
+{
+  JsonReader::JsonReader(istream& is, size_t bufferSize) : _input(in_place_type<JsonStreamBuffer>, is, bufferSize), _token(JsonTokenType::Undefined)
+  {
+
+  }
+
+  JsonReader::JsonReader(wistream& is) : _input(in_place_type<JsonWideStream>, is), _token(JsonTokenType::Undefined)
+  {
+
+  }
+
+  JsonReader::JsonReader(wstring_view value) : _input(in_place_type<JsonBuffer<wchar_t>>, value), _token(JsonTokenType::Undefined)
+  {
+
+  }
+
+  JsonReader::JsonReader(string_view value) : _input(in_place_type<JsonBuffer<char>>, value), _token(JsonTokenType::Undefined)
+  {
+
+  }
+
+  void JsonReader::Null        (               ) { _token = JsonTokenType::Null        ; _value = nullptr;     }
+  void JsonReader::String      (wstring&& value) { _token = JsonTokenType::String      ; _value = move(value); }
+  void JsonReader::Boolean     (bool      value) { _token = JsonTokenType::Boolean     ; _value = value;       }
+  void JsonReader::Real        (double    value) { _token = JsonTokenType::Real        ; _value = value;       }
+  void JsonReader::Integer     (int64_t   value) { _token = JsonTokenType::Integer     ; _value = value;       }
+  void JsonReader::PropertyName(wstring&& value) { _token = JsonTokenType::PropertyName; _value = move(value); }
+  void JsonReader::StartObject (               ) { _token = JsonTokenType::StartObject ; _value = L"{"s;       }
+  void JsonReader::EndObject   (               ) { _token = JsonTokenType::EndObject   ; _value = L"}"s;       }
+  void JsonReader::StartArray  (               ) { _token = JsonTokenType::StartArray  ; _value = L"["s;       }
+  void JsonReader::EndArray    (               ) { _token = JsonTokenType::EndArray    ; _value = L"]"s;       }
+
+  bool JsonReader::Read()
+  {
+    auto found = visit([&](auto& input) { return JsonLinter::Next(input, _state, *this); }, _input);
+    if (!found)
+    {
+      _token = JsonTokenType::Undefined;
+      _value = nullptr;
+    }
+    return found;
+  }
+
+  void JsonReader::Read(JsonHandler& handler)
+  {
+    visit([&](auto& input) { while (JsonLinter::Next(input, _state, handler)); }, _input);
+    _token = JsonTokenType::Undefined;
+    _value = nullptr;
+  }
+
+  JsonTokenType JsonReader::TokenType() const
+  {
+    return _token;
+  }
+
+  VALUE_TOKEN const& JsonReader::Value() const
+  {
+    return _value;
+  }
+
+  int64_t JsonReader::Depth() const
+  {
+    return _state.containers.size();
+  }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include "JsonLinter.h"
+#include "JsonHandler.h"
+#include "JsonBuffer.h"
+#include "JsonStreamBuffer.h"
+#include "JsonWideStream.h"
+
+#include <variant>
+#include <string>
+#include <string_view>
+#include <istream>
+
+namespace Json4CPP::Detail
+{
+  // Pull style reader, each call to Read parses the input until the next token, which is then available through TokenType and Value.
+  // Only the open containers are kept, so reading from an std::istream takes constant memory no matter how large the document is.
+  // The same JsonDefault::MaxDepth limit and error messages apply as for JsonLinter::Read.
+  class JSON_API JsonReader : private JsonHandler
+  {
+  private:
+#pragma warning(suppress: 4251)
+    std::variant<JsonWideStream, JsonBuffer<wchar_t>, JsonBuffer<char>, JsonStreamBuffer> _input;
+#pragma warning(suppress: 4251)
+    JsonLinterState _state;
+    JsonTokenType _token;
+#pragma warning(suppress: 4251)
+    VALUE_TOKEN _value;
+
+    void Null        (                     ) override;
+    void String      (std::wstring&& value ) override;
+    void Boolean     (bool           value ) override;
+    void Real        (double         value ) override;
+    void Integer     (int64_t        value ) override;
+    void PropertyName(std::wstring&& value ) override;
+    void StartObject (                     ) override;
+    void EndObject   (                     ) override;
+    void StartArray  (                     ) override;
+    void EndArray    (                     ) override;
+  public:
+    // Reads UTF-8 encoded text from the stream, through a buffer of bufferSize bytes.
+    JsonReader(std::istream& is, size_t bufferSize = JsonStreamBuffer::DefaultBufferSize);
+    JsonReader(std::wistream& is);
+    JsonReader(std::wstring_view value);
+    JsonReader(std::string_view value);
+
+    // Advances to the next token. Returns false at the end of the document, after which TokenType is JsonTokenType::Undefined.
+    bool Read();
+    // Passes the remaining tokens to handler.
+    void Read(JsonHandler& handler);
+
+    JsonTokenType      TokenType() const;
+    VALUE_TOKEN const& Value    () const;
+    // The number of objects and arrays which are open after the current token.
+    int64_t            Depth    () const;
+  };
+}
@@ -0,0 +1,155 @@
+#include "stdafx.h"
+
+#include "JsonStreamBuffer.h"
+#include "JsonBuffer.h"
+#include "Helper.h"
+
+using namespace std;
+
+namespace Json4CPP::Detail
+{
+  JsonStreamBuffer::JsonStreamBuffer(istream& is, size_t bufferSize) :
+    _is(is), _buffer(max<size_t>(bufferSize, 4)), _current(0), _end(0), _pending(L'\0'), _eof(false), _line(1), _column(0), _carriageReturn(false)
+  {
+
+  }
+
+  bool JsonStreamBuffer::Fill(size_t count)
+  {
+    if (_end - _current >= count) return true;
+    // Keep the incomplete UTF-8 sequence, and read after it
+    move(_buffer.begin() + _current, _buffer.begin() + _end, _buffer.begin());
+    _end -= _current;
+    _current = 0;
+    while (_end < count && _is)
+    {
+      _is.read(_buffer.data() + _end, _buffer.size() - _end);
+      _end += (size_t)_is.gcount();
+    }
+    return _end >= count;
+  }
+
+  void JsonStreamBuffer::Track(wchar_t c)
+  {
+    if (_carriageReturn && c == L'\n')
+    {
+      _carriageReturn = false;
+      _column = 0;
+      _line++;
+    }
+    else
+    {
+      _carriageReturn = c == L'\r';
+      _column++;
+    }
+  }
+
+  JsonStreamBuffer::int_type JsonStreamBuffer::Next(bool consume)
+  {
+    if (_pending)
+    {
+      auto c = _pending;
+      if (consume)
+      {
+        _pending = L'\0';
+        Track(c);
+      }
+      return c;
+    }
+    if (!Fill(1))
+    {
+      _eof = true;
+      return eof_value;
+    }
+    auto c0 = (unsigned char)_buffer[_current];
+    if (c0 < 0x80)
+    {
+      if (consume)
+      {
+        _current++;
+        Track(c0);
+      }
+      return c0;
+    }
+    Fill(c0 >= 0xF0 ? 4 : c0 >= 0xE0 ? 3 : 2);
+    char32_t codePoint;
+    auto length = DecodeUtf8(_buffer.data() + _current, _buffer.data() + _end, codePoint);
+    if (length == 0)
+    {
+      auto message = "Invalid UTF-8 sequence at position Line: "s + to_string(_line) + " Column: "s + to_string(_column + 1) + "!"s;
+      throw exception(message.c_str());
+    }
+    // Code points above U+FFFF are split into a surrogate pair where wchar_t is 2 bytes, the same way as String2WString does
+    auto pair = codePoint >= 0x10000 && sizeof(wchar_t) == 2;
+    auto c = pair ? (wchar_t)(0xD800 + ((codePoint - 0x10000) >> 10)) : (wchar_t)codePoint;
+    if (consume)
+    {
+      _current += length;
+      if (pair) _pending = (wchar_t)(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+      Track(c);
+    }
+    return c;
+  }
+
+  JsonStreamBuffer::int_type JsonStreamBuffer::peek()
+  {
+    return Next(false);
+  }
+
+  JsonStreamBuffer::int_type JsonStreamBuffer::get()
+  {
+    return Next(true);
+  }
+
+  bool JsonStreamBuffer::eof() const
+  {
+    return _eof;
+  }
+
+  JsonStreamBuffer::pos_type JsonStreamBuffer::tellg() const
+  {
+    // Like GetStreamPosition for an std::wistream, the end of the stream is one column after the last character
+    return { _line, _eof ? _column + 1 : _column };
+  }
+
+  void JsonStreamBuffer::ReadPlain(wstring& text)
+  {
+    if (_pending) return;
+    // The run can continue after the end of the buffer, it contains no line breaks, so only the column has to be tracked
+    while (Fill(1))
+    {
+      auto count = ScanString(_buffer.data() + _current, _end - _current);
+      text.append(_buffer.data() + _current, _buffer.data() + _current + count);
+      _current += count;
+      _column += count;
+      if (count) _carriageReturn = false;
+      if (_current != _end) break;
+    }
+  }
+
+  JsonStreamBuffer& JsonStreamBuffer::operator>>(wistream& (*)(wistream&))
+  {
+    while (iswspace((wint_t)peek()))
+    {
+      get();
+    }
+    return *this;
+  }
+
+  pair<uint64_t, uint64_t> GetStreamPosition(JsonStreamBuffer const&, JsonStreamBuffer::pos_type pos)
+  {
+    return pos;
+  }
+
+  wstring GetFormattedStreamPosition(JsonStreamBuffer const& is, JsonStreamBuffer::pos_type pos)
+  {
+    auto [line, column] = GetStreamPosition(is, pos);
+    return L"Line: "s + to_wstring(line) + L" Column: "s + to_wstring(column);
+  }
+
+  string GetFormattedStreamPositionA(JsonStreamBuffer const& is, JsonStreamBuffer::pos_type pos)
+  {
+    auto [line, column] = GetStreamPosition(is, pos);
+    return "Line: "s + to_string(line) + " Column: "s + to_string(column);
+  }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <istream>
+#include <cstdint>
+
+namespace Json4CPP::Detail
+{
+  // Reads UTF-8 encoded text from an std::istream through a fixed size buffer, which is refilled as it is consumed,
+  // so the memory usage does not depend on the size of the input. Exposes the same interface as JsonBuffer.
+  // As the stream is never rewound, the { line, column } position is tracked while reading, and tellg returns it directly.
+  // Line endings are handled as \r\n, the same way as GetStreamPosition does.
+  class JSON_API JsonStreamBuffer
+  {
+  public:
+    using int_type = std::wistream::int_type;
+    using pos_type = std::pair<uint64_t, uint64_t>;
+
+    static constexpr int_type eof_value = std::char_traits<wchar_t>::eof();
+    static constexpr size_t DefaultBufferSize = 64 * 1024;
+
+  private:
+    std::istream& _is;
+#pragma warning(suppress: 4251)
+    std::vector<char> _buffer;
+    size_t _current;
+    size_t _end;
+    wchar_t _pending;   // Low surrogate of an already consumed 4 byte UTF-8 sequence
+    bool _eof;
+    uint64_t _line;
+    uint64_t _column;
+    bool _carriageReturn;
+
+    // Makes sure that at least count bytes are available in the buffer, unless the stream ends before.
+    bool Fill(size_t count);
+    int_type Next(bool consume);
+    void Track(wchar_t c);
+  public:
+    JsonStreamBuffer(std::istream& is, size_t bufferSize = DefaultBufferSize);
+
+    int_type peek();
+    int_type get();
+    bool eof() const;
+    pos_type tellg() const;
+
+    // Appends the leading run of characters which need neither escaping nor decoding to text, see ScanString.
+    void ReadPlain(std::wstring& text);
+
+    // Only meant to be used with std::ws, skips whitespace the same way.
+    JsonStreamBuffer& operator>>(std::wistream& (*)(std::wistream&));
+  };
+
+  // Returns the { line, column } pair of the specified position in the buffer.
+  JSON_API std::pair<uint64_t, uint64_t> GetStreamPosition(JsonStreamBuffer const& is, JsonStreamBuffer::pos_type pos);
+
+  // Returns the { line, column } data as L"Line: {line} Column: {column}"s of the specified position in the buffer.
+  JSON_API std::wstring GetFormattedStreamPosition(JsonStreamBuffer const& is, JsonStreamBuffer::pos_type pos);
+
+  // Returns the { line, column } data as "Line: {line} Column: {column}"s of the specified position in the buffer.
+  JSON_API std::string GetFormattedStreamPositionA(JsonStreamBuffer const& is, JsonStreamBuffer::pos_type pos);
+}
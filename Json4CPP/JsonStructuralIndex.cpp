@@ -0,0 +1,214 @@
+#include "stdafx.h"
+
+#include "JsonStructuralIndex.h"
+
+#include <bitset>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define JSON4CPP_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+namespace Json4CPP::Detail
+{
+  // One bit for each character of a block of 64, for each class of characters.
+  struct JsonStructuralBlock
+  {
+    uint64_t quote      = 0;
+    uint64_t backslash  = 0;
+    uint64_t structural = 0; // '{', '}', '[', ']', ':' and ','
+    uint64_t whitespace = 0;
+    uint64_t nonAscii   = 0;
+  };
+
+  // Returns the index of the lowest set bit, mask must not be 0.
+  static uint32_t CountTrailingZeros(uint64_t mask)
+  {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanForward(&index, (unsigned long)mask))
+    {
+      return index;
+    }
+    _BitScanForward(&index, (unsigned long)(mask >> 32));
+    return index + 32;
+#else
+    return __builtin_ctzll(mask);
+#endif
+  }
+
+#ifdef JSON4CPP_SSE2
+  // Loads 16 characters as bytes. Code units above 0x7F become 0x80, they only have to stay non-ASCII for the classification.
+  static __m128i Load(char const* value)
+  {
+    return _mm_loadu_si128((__m128i const*)value);
+  }
+
+  static __m128i Load(wchar_t const* value)
+  {
+    auto load = [](wchar_t const* units) { return _mm_loadu_si128((__m128i const*)units); };
+    if constexpr (sizeof(wchar_t) == 2)
+    {
+      auto clamp = [](__m128i units)
+      {
+        auto high = _mm_cmpgt_epi16(_mm_xor_si128(units, _mm_set1_epi16((short)0x8000)), _mm_set1_epi16((short)0x807F));
+        return _mm_or_si128(_mm_andnot_si128(high, units), _mm_and_si128(high, _mm_set1_epi16(0x80)));
+      };
+      return _mm_packus_epi16(clamp(load(value)), clamp(load(value + 8)));
+    }
+    else
+    {
+      auto clamp = [](__m128i units)
+      {
+        auto high = _mm_cmpgt_epi32(_mm_xor_si128(units, _mm_set1_epi32((int)0x80000000)), _mm_set1_epi32((int)0x8000007F));
+        return _mm_or_si128(_mm_andnot_si128(high, units), _mm_and_si128(high, _mm_set1_epi32(0x80)));
+      };
+      return _mm_packus_epi16(_mm_packs_epi32(clamp(load(value     )), clamp(load(value +  4))),
+                              _mm_packs_epi32(clamp(load(value +  8)), clamp(load(value + 12))));
+    }
+  }
+#endif
+
+  template<typename Char>
+  static JsonStructuralBlock Classify(Char const* value)
+  {
+    auto block = JsonStructuralBlock();
+#ifdef JSON4CPP_SSE2
+    auto set = [](char c) { return _mm_set1_epi8(c); };
+    for (int i = 0; i < 64; i += 16)
+    {
+      auto bytes = Load(value + i);
+      auto mask = [&](__m128i matches) { return (uint64_t)(uint32_t)_mm_movemask_epi8(matches) << i; };
+      // '[' and ']' only differ from '{' and '}' in the 0x20 bit, '\t', '\n', '\v', '\f' and '\r' are 0x09-0x0D
+      auto lower = _mm_or_si128(bytes, set(0x20));
+      block.quote      |= mask(_mm_cmpeq_epi8(bytes, set('"')));
+      block.backslash  |= mask(_mm_cmpeq_epi8(bytes, set('\\')));
+      block.structural |= mask(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(lower, set('{')), _mm_cmpeq_epi8(lower, set('}'))),
+                                            _mm_or_si128(_mm_cmpeq_epi8(bytes, set(':')), _mm_cmpeq_epi8(bytes, set(',')))));
+      block.whitespace |= mask(_mm_or_si128(_mm_cmpeq_epi8(bytes, set(' ')),
+                                            _mm_and_si128(_mm_cmpgt_epi8(bytes, set(0x08)), _mm_cmpgt_epi8(set(0x0E), bytes))));
+      block.nonAscii   |= mask(bytes);
+    }
+#else
+    for (int i = 0; i < 64; ++i)
+    {
+      auto c = (make_unsigned_t<Char>)value[i];
+      auto bit = (uint64_t)1 << i;
+      if (c == '"')
+      {
+        block.quote |= bit;
+      }
+      else if (c == '\\')
+      {
+        block.backslash |= bit;
+      }
+      else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',')
+      {
+        block.structural |= bit;
+      }
+      else if (c == ' ' || (0x09 <= c && c <= 0x0D))
+      {
+        block.whitespace |= bit;
+      }
+      else if (c > 0x7F)
+      {
+        block.nonAscii |= bit;
+      }
+    }
+#endif
+    return block;
+  }
+
+  template<typename Char>
+  static bool BuildIndex(basic_string_view<Char> value, vector<uint32_t>& positions)
+  {
+    positions.clear();
+    if (value.size() > numeric_limits<uint32_t>::max())
+    {
+      return false;
+    }
+    // The state carried over from the previous block
+    auto escapedCarry  = uint64_t(0); // 1 if the first character is escaped by a backslash at the end of the previous block
+    auto inStringCarry = uint64_t(0); // All ones if the previous block ended inside of a string
+    auto valueCarry    = uint64_t(0); // 1 if the previous block ended with a character of a number or a literal
+    Char padded[64];
+    for (size_t offset = 0; offset < value.size(); offset += 64)
+    {
+      auto data = value.data() + offset;
+      if (value.size() - offset < 64)
+      {
+        // The last block is padded with whitespace, which is never a token
+        fill(copy(data, value.data() + value.size(), padded), padded + 64, (Char)' ');
+        data = padded;
+      }
+      auto block = Classify(data);
+
+      // A backslash escapes the next character unless it is escaped itself. Backslashes are rare, so they are walked one by one.
+      auto escaped = escapedCarry;
+      escapedCarry = 0;
+      for (auto backslash = block.backslash; backslash; backslash &= backslash - 1)
+      {
+        auto bit = backslash & (0 - backslash);
+        if (escaped & bit)
+        {
+          continue;
+        }
+        if (bit >> 63)
+        {
+          escapedCarry = 1;
+        }
+        else
+        {
+          escaped |= bit << 1;
+        }
+      }
+
+      // The prefix xor of the quotes is set from each opening quote up to, but without, the closing one
+      auto quote = block.quote & ~escaped;
+      auto inString = quote;
+      for (int shift = 1; shift < 64; shift <<= 1)
+      {
+        inString ^= inString << shift;
+      }
+      inString ^= inStringCarry;
+      inStringCarry = 0 - (inString >> 63);
+      if (block.nonAscii & ~inString)
+      {
+        return false;
+      }
+
+      // Everything else outside of the strings belongs to a number or a literal, only the first character of them is a token
+      auto other = ~(block.structural | block.whitespace | quote | inString);
+      auto start = other & ~(other << 1 | valueCarry);
+      valueCarry = other >> 63;
+
+      auto tokens = (block.structural & ~inString) | (quote & inString) | start;
+      auto index = positions.size();
+      positions.resize(index + bitset<64>(tokens).count());
+      for (; tokens; tokens &= tokens - 1)
+      {
+        positions[index++] = (uint32_t)(offset + CountTrailingZeros(tokens));
+      }
+    }
+    return true;
+  }
+
+  bool JsonStructuralIndex::Build(string_view value, vector<uint32_t>& positions)
+  {
+    return BuildIndex(value, positions);
+  }
+
+  bool JsonStructuralIndex::Build(wstring_view value, vector<uint32_t>& positions)
+  {
+    return BuildIndex(value, positions);
+  }
+}
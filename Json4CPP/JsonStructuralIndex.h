@@ -0,0 +1,29 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace Json4CPP::Detail
+{
+  // First stage of JsonBackend::StructuralIndex, the second one is JsonLinter::ParseIndexed.
+  // The text is classified 64 characters at a time with SIMD into bitmasks of quotes, backslashes, brackets, separators and whitespace.
+  // Escaped quotes are removed, the quotes are turned into a mask of the inside of the strings by a prefix xor,
+  // and the positions of the remaining tokens are collected: every '{', '}', '[', ']', ':' and ',' outside of the strings,
+  // the opening quote of every string and the first character of every other value.
+  class JSON_API JsonStructuralIndex
+  {
+  public:
+    // Fills positions in the order of the text, returns false if it can not be indexed, in which case it has to be parsed by the linter.
+    // That is the case above 4 GB, and with any character above U+007F outside of the strings, as the linter skips non-ASCII whitespace.
+    // UTF-8 and UTF-16 text is indexed the same way, as all of the characters looked for are ASCII.
+    static bool Build(std::string_view  value, std::vector<uint32_t>& positions);
+    static bool Build(std::wstring_view value, std::vector<uint32_t>& positions);
+  };
+}
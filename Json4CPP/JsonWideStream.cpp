@@ -0,0 +1,96 @@
+#include "stdafx.h"
+
+#include "JsonWideStream.h"
+
+using namespace std;
+
+namespace Json4CPP::Detail
+{
+  JsonWideStream::JsonWideStream(wistream& is) : _is(is), _line(1), _column(0), _carriageReturn(false)
+  {
+
+  }
+
+  JsonWideStream::int_type JsonWideStream::peek()
+  {
+    return _is.peek();
+  }
+
+  JsonWideStream::int_type JsonWideStream::get()
+  {
+    auto c = _is.get();
+    if (c == char_traits<wchar_t>::eof())
+    {
+      return c;
+    }
+    if (_carriageReturn && c == L'\n')
+    {
+      _carriageReturn = false;
+      _column = 0;
+      _line++;
+    }
+    else
+    {
+      _carriageReturn = c == L'\r';
+      _column++;
+    }
+    return c;
+  }
+
+  bool JsonWideStream::eof() const
+  {
+    return _is.eof();
+  }
+
+  JsonWideStream::pos_type JsonWideStream::tellg() const
+  {
+    // Like GetStreamPosition for an std::wistream, the end of the stream is one column after the last character
+    return { _line, _is.eof() ? _column + 1 : _column };
+  }
+
+  void JsonWideStream::ReadPlain(wstring& text)
+  {
+    // Reads the stream buffer directly instead of going through the sentry of get for every character.
+    // The run contains no line breaks, so only the column has to be tracked.
+    auto buffer = _is.rdbuf();
+    if (!buffer || !_is.good()) return;
+    auto count = uint64_t(0);
+    for (auto c = buffer->sgetc(); c != char_traits<wchar_t>::eof(); c = buffer->snextc())
+    {
+      if (c == L'\"' || c == L'\\' || c <= 0x1F || (0x7F <= c && c <= 0x9F))
+      {
+        break;
+      }
+      text.push_back((wchar_t)c);
+      count++;
+    }
+    _column += count;
+    if (count) _carriageReturn = false;
+  }
+
+  JsonWideStream& JsonWideStream::operator>>(wistream& (*)(wistream&))
+  {
+    while (iswspace((wint_t)peek()))
+    {
+      get();
+    }
+    return *this;
+  }
+
+  pair<uint64_t, uint64_t> GetStreamPosition(JsonWideStream const&, JsonWideStream::pos_type pos)
+  {
+    return pos;
+  }
+
+  wstring GetFormattedStreamPosition(JsonWideStream const& is, JsonWideStream::pos_type pos)
+  {
+    auto [line, column] = GetStreamPosition(is, pos);
+    return L"Line: "s + to_wstring(line) + L" Column: "s + to_wstring(column);
+  }
+
+  string GetFormattedStreamPositionA(JsonWideStream const& is, JsonWideStream::pos_type pos)
+  {
+    auto [line, column] = GetStreamPosition(is, pos);
+    return "Line: "s + to_string(line) + " Column: "s + to_string(column);
+  }
+}
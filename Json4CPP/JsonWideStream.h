@@ -0,0 +1,55 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include <string>
+#include <utility>
+#include <istream>
+#include <cstdint>
+
+namespace Json4CPP::Detail
+{
+  // Reads an std::wistream character by character for JsonLinter, and tracks the { line, column } position while reading,
+  // so the stream is never rewound for the error messages, which also works for streams that can not seek.
+  // Nothing is read ahead, the stream is left right after the last character the linter consumed.
+  // Line endings are handled as \r\n, the same way as GetStreamPosition does.
+  class JSON_API JsonWideStream
+  {
+  public:
+    using int_type = std::wistream::int_type;
+    using pos_type = std::pair<uint64_t, uint64_t>;
+
+  private:
+    std::wistream& _is;
+    uint64_t _line;
+    uint64_t _column;
+    bool _carriageReturn;
+  public:
+    JsonWideStream(std::wistream& is);
+
+    int_type peek();
+    int_type get();
+    bool eof() const;
+    pos_type tellg() const;
+
+    // Appends the leading run of characters which need no escaping to text, the same ones as ScanString.
+    void ReadPlain(std::wstring& text);
+
+    // Only meant to be used with std::ws, skips whitespace the same way.
+    JsonWideStream& operator>>(std::wistream& (*)(std::wistream&));
+  };
+
+  // Returns the { line, column } pair of the specified position in the stream, which is already the position itself.
+  // The stream is only taken, so JsonLinter can call it the same way for every input.
+  JSON_API std::pair<uint64_t, uint64_t> GetStreamPosition(JsonWideStream const& is, JsonWideStream::pos_type pos);
+
+  // Returns the { line, column } data as L"Line: {line} Column: {column}"s of the specified position in the stream.
+  JSON_API std::wstring GetFormattedStreamPosition(JsonWideStream const& is, JsonWideStream::pos_type pos);
+
+  // Returns the { line, column } data as "Line: {line} Column: {column}"s of the specified position in the stream.
+  JSON_API std::string GetFormattedStreamPositionA(JsonWideStream const& is, JsonWideStream::pos_type pos);
+}
@@ -0,0 +1,315 @@
+#include "stdafx.h"
+
+#include "JsonWriter.h"
+#include "Json.h"
+#include "JsonObject.h"
+#include "JsonArray.h"
+#include "Helper.h"
+
+#include <charconv>
+
+using namespace std;
+
+namespace Json4CPP::Detail
+{
+  // The buffer JsonWriter appends to, and the stream it is flushed to, if any.
+  template<typename Char>
+  struct JsonSink
+  {
+    basic_ostream<Char>* os;
+    basic_string<Char> owned;   // The buffer, unless one is given by the caller
+    basic_string<Char>& buffer;
+    uint8_t indentation;
+
+    JsonSink(basic_ostream<Char>* os, uint8_t indentation) : os(os), buffer(owned), indentation(indentation)
+    {
+      if (os)
+      {
+        buffer.reserve(JsonWriter::BufferSize);
+      }
+    }
+
+    JsonSink(basic_string<Char>& buffer, uint8_t indentation) : os(nullptr), buffer(buffer), indentation(indentation)
+    {
+
+    }
+
+    void Flush(bool force = false)
+    {
+      if (os && (force || buffer.size() >= JsonWriter::BufferSize))
+      {
+        os->write(buffer.data(), buffer.size());
+        buffer.clear();
+      }
+    }
+
+    // Appends ASCII text.
+    void Append(char const* value)
+    {
+      for (; *value; ++value)
+      {
+        buffer += (Char)*value;
+      }
+    }
+  };
+
+  template<typename Sink>
+  void JsonWriter::NewLine(Sink& sink, int64_t depth)
+  {
+    if (sink.indentation)
+    {
+      sink.Append("\r\n");
+      sink.buffer.append((size_t)sink.indentation * depth, ' ');
+    }
+  }
+
+  template<typename Sink>
+  void JsonWriter::WriteValue(Sink& sink, Json const& json, int64_t depth)
+  {
+    visit(Overload{
+      [&](nullptr_t  const& value) { sink.Append("null"); },
+      [&](wstring    const& value) { WriteString(sink, value); },
+      [&](bool       const& value) { sink.Append(value ? "true" : "false"); },
+      [&](double     const& value) { WriteNumber(sink, value); },
+      [&](int64_t    const& value) { WriteNumber(sink, value); },
+      [&](JsonObject const& value) { WriteObject(sink, value, depth); },
+      [&](JsonArray  const& value) { WriteArray (sink, value, depth); }
+    }, json._value);
+    sink.Flush();
+  }
+
+  template<typename Sink>
+  void JsonWriter::WriteObject(Sink& sink, JsonObject const& object, int64_t depth)
+  {
+    sink.buffer += '{';
+    if (object.Contents().pairs.empty())
+    {
+      sink.buffer += '}';
+      return;
+    }
+    auto first = true;
+    for (auto& [key, value] : object.Contents().pairs)
+    {
+      if (!first)
+      {
+        sink.buffer += ',';
+      }
+      first = false;
+      NewLine(sink, depth + 1);
+      WriteString(sink, key);
+      sink.Append(sink.indentation ? ": " : ":");
+      WriteValue(sink, value, depth + 1);
+    }
+    NewLine(sink, depth);
+    sink.buffer += '}';
+  }
+
+  template<typename Sink>
+  void JsonWriter::WriteArray(Sink& sink, JsonArray const& array, int64_t depth)
+  {
+    sink.buffer += '[';
+    if (array.Contents().values.empty())
+    {
+      sink.buffer += ']';
+      return;
+    }
+    auto first = true;
+    for (auto& value : array.Contents().values)
+    {
+      if (!first)
+      {
+        sink.buffer += ',';
+      }
+      first = false;
+      NewLine(sink, depth + 1);
+      WriteValue(sink, value, depth + 1);
+    }
+    NewLine(sink, depth);
+    sink.buffer += ']';
+  }
+
+  template<typename Sink>
+  void JsonWriter::WriteString(Sink& sink, wstring const& value)
+  {
+    // Same escaping as EscapeString. UTF-16 output appends the characters between two escapes at once,
+    // UTF-8 output copies ASCII as is and encodes everything else. The runs to copy are found by ScanString.
+    static constexpr char digits[] = "0123456789abcdef";
+    static constexpr auto wide = is_same_v<remove_reference_t<decltype(sink.buffer)>, wstring>;
+    auto& buffer = sink.buffer;
+    auto escape = [&](uint32_t c)
+    {
+      sink.Append("\\u");
+      for (int shift = 12; shift >= 0; shift -= 4)
+      {
+        buffer += digits[(c >> shift) & 0xF];
+      }
+    };
+    auto codeUnit = [](wchar_t c) { return (uint32_t)(make_unsigned_t<wchar_t>)c; };
+    buffer += '"';
+    auto end = value.data() + value.size();
+    auto run = value.data();
+    for (auto current = value.data(); current != end; ++current)
+    {
+      // Skip the run which needs neither escaping nor encoding, UTF-8 output copies it as ASCII
+      auto plain = ScanString(current, end - current, !wide);
+      if constexpr (!wide)
+      {
+        // Every character of the run is ASCII, so it is narrowed one by one
+        auto size = buffer.size();
+        buffer.resize(size + plain);
+        transform(current, current + plain, buffer.begin() + size, [](wchar_t c) { return (char)c; });
+      }
+      current += plain;
+      if (current == end)
+      {
+        break;
+      }
+      auto c = codeUnit(*current);
+      if (c == '"' || c == '\\' || c <= 0x1F)
+      {
+        if constexpr (wide)
+        {
+          buffer.append(run, current);
+          run = current + 1;
+        }
+        switch (c)
+        {
+        case '"' : sink.Append("\\\""); break;
+        case '\\': sink.Append("\\\\"); break;
+        case '\b': sink.Append("\\b" ); break;
+        case '\f': sink.Append("\\f" ); break;
+        case '\n': sink.Append("\\n" ); break;
+        case '\r': sink.Append("\\r" ); break;
+        case '\t': sink.Append("\\t" ); break;
+        default  : escape(c);           break;
+        }
+      }
+      else if constexpr (!wide)
+      {
+        if (c < 0x80)
+        {
+          buffer += (char)c;
+          continue;
+        }
+        if (0xD800 <= c && c <= 0xDBFF && current + 1 != end && 0xDC00 <= codeUnit(current[1]) && codeUnit(current[1]) <= 0xDFFF)
+        {
+          c = 0x10000 + ((c - 0xD800) << 10) + (codeUnit(*++current) - 0xDC00);
+        }
+        else if (0xD800 <= c && c <= 0xDFFF)
+        {
+          // An unpaired surrogate can not be encoded into UTF-8, but it can be escaped
+          escape(c);
+          continue;
+        }
+        else if (c > 0x10FFFF)
+        {
+          c = 0xFFFD;
+        }
+        if (c < 0x800)
+        {
+          buffer += (char)(0xC0 | c >> 6);
+        }
+        else if (c < 0x10000)
+        {
+          buffer += (char)(0xE0 | c >> 12);
+          buffer += (char)(0x80 | (c >> 6 & 0x3F));
+        }
+        else
+        {
+          buffer += (char)(0xF0 | c >> 18);
+          buffer += (char)(0x80 | (c >> 12 & 0x3F));
+          buffer += (char)(0x80 | (c >> 6 & 0x3F));
+        }
+        buffer += (char)(0x80 | (c & 0x3F));
+      }
+    }
+    if constexpr (wide)
+    {
+      buffer.append(run, end);
+    }
+    buffer += '"';
+  }
+
+  template<typename Sink>
+  void JsonWriter::WriteNumber(Sink& sink, NUMBER number)
+  {
+    char buffer[JsonLinter::NumberSize];
+    sink.buffer.append(buffer, JsonLinter::FormatNumber(buffer, number));
+  }
+
+  wostream& JsonWriter::Write(wostream& os, Json const& json, uint8_t indentation)
+  {
+    auto sink = JsonSink<wchar_t>(&os, indentation);
+    WriteValue(sink, json, 0);
+    sink.Flush(true);
+    return os;
+  }
+
+  wostream& JsonWriter::Write(wostream& os, JsonObject const& object, uint8_t indentation)
+  {
+    auto sink = JsonSink<wchar_t>(&os, indentation);
+    WriteObject(sink, object, 0);
+    sink.Flush(true);
+    return os;
+  }
+
+  wostream& JsonWriter::Write(wostream& os, JsonArray const& array, uint8_t indentation)
+  {
+    auto sink = JsonSink<wchar_t>(&os, indentation);
+    WriteArray(sink, array, 0);
+    sink.Flush(true);
+    return os;
+  }
+
+  ostream& JsonWriter::Write(ostream& os, Json const& json, uint8_t indentation)
+  {
+    auto sink = JsonSink<char>(&os, indentation);
+    WriteValue(sink, json, 0);
+    sink.Flush(true);
+    return os;
+  }
+
+  ostream& JsonWriter::Write(ostream& os, JsonObject const& object, uint8_t indentation)
+  {
+    auto sink = JsonSink<char>(&os, indentation);
+    WriteObject(sink, object, 0);
+    sink.Flush(true);
+    return os;
+  }
+
+  ostream& JsonWriter::Write(ostream& os, JsonArray const& array, uint8_t indentation)
+  {
+    auto sink = JsonSink<char>(&os, indentation);
+    WriteArray(sink, array, 0);
+    sink.Flush(true);
+    return os;
+  }
+
+  wstring JsonWriter::Dump(Json const& json, uint8_t indentation)
+  {
+    auto sink = JsonSink<wchar_t>(nullptr, indentation);
+    WriteValue(sink, json, 0);
+    return move(sink.buffer);
+  }
+
+  wstring JsonWriter::Dump(JsonObject const& object, uint8_t indentation)
+  {
+    auto sink = JsonSink<wchar_t>(nullptr, indentation);
+    WriteObject(sink, object, 0);
+    return move(sink.buffer);
+  }
+
+  wstring JsonWriter::Dump(JsonArray const& array, uint8_t indentation)
+  {
+    auto sink = JsonSink<wchar_t>(nullptr, indentation);
+    WriteArray(sink, array, 0);
+    return move(sink.buffer);
+  }
+
+  string& JsonWriter::Append(string& buffer, Json const& json, uint8_t indentation)
+  {
+    auto sink = JsonSink<char>(buffer, indentation);
+    WriteValue(sink, json, 0);
+    return buffer;
+  }
+}
\ No newline at end of file
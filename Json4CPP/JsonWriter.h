@@ -0,0 +1,55 @@
+#pragma once
+
+#ifdef JSON4CPP_EXPORTS
+#define JSON_API __declspec(dllexport)
+#else
+#define JSON_API __declspec(dllimport)
+#endif
+
+#include "JsonLinter.h"
+
+#include <string>
+#include <ostream>
+#include <cstdint>
+
+namespace Json4CPP
+{
+  class JSON_API Json;
+  class JSON_API JsonObject;
+  class JSON_API JsonArray;
+
+  namespace Detail
+  {
+    // Serializes a Json by walking the JsonObject and JsonArray values directly, without collecting tokens first.
+    // The output is the same as JsonLinter::Write produces from the tokens, with the same indentation.
+    // Everything is appended to a buffer which is flushed to the stream whenever it grows above BufferSize.
+    // std::wostream receives UTF-16, std::ostream receives UTF-8, which is encoded on the fly without an intermediate wstring.
+    class JSON_API JsonWriter
+    {
+    private:
+      template<typename Sink> static void WriteValue (Sink& sink, Json        const& json  , int64_t depth);
+      template<typename Sink> static void WriteObject(Sink& sink, JsonObject  const& object, int64_t depth);
+      template<typename Sink> static void WriteArray (Sink& sink, JsonArray   const& array , int64_t depth);
+      template<typename Sink> static void WriteString(Sink& sink, std::wstring const& value);
+      template<typename Sink> static void WriteNumber(Sink& sink, NUMBER number);
+      template<typename Sink> static void NewLine    (Sink& sink, int64_t depth);
+    public:
+      static constexpr size_t BufferSize = 64 * 1024;
+
+      static std::wostream& Write(std::wostream& os, Json       const& json  , uint8_t indentation);
+      static std::wostream& Write(std::wostream& os, JsonObject const& object, uint8_t indentation);
+      static std::wostream& Write(std::wostream& os, JsonArray  const& array , uint8_t indentation);
+
+      static std::ostream& Write(std::ostream& os, Json       const& json  , uint8_t indentation);
+      static std::ostream& Write(std::ostream& os, JsonObject const& object, uint8_t indentation);
+      static std::ostream& Write(std::ostream& os, JsonArray  const& array , uint8_t indentation);
+
+      static std::wstring Dump(Json       const& json  , uint8_t indentation);
+      static std::wstring Dump(JsonObject const& object, uint8_t indentation);
+      static std::wstring Dump(JsonArray  const& array , uint8_t indentation);
+
+      // Appends the UTF-8 encoded text to buffer, without clearing it first, so a buffer which is reused does not allocate once it is large enough.
+      static std::string& Append(std::string& buffer, Json const& json, uint8_t indentation);
+    };
+  }
+}
@@ -82,6 +82,24 @@ namespace Json4CPP::Detail::Value
     return !Equal(left, right);
   }
 
+  uint64_t Hash(VALUE const& value)
+  {
+    // -0.0 == 0.0, so both are hashed as 0.0
+    auto number = [](double value) { return (uint64_t)hash<double>()(value == 0 ? 0.0 : value); };
+    uint64_t result;
+    visit(Overload{
+      [&](nullptr_t  const& v) { result = 0x3c6ef372fe94f82b; },
+      [&](wstring    const& v) { result = hash<wstring>()(v); },
+      [&](bool       const& v) { result = number(v);          },
+      [&](double     const& v) { result = number(v);          },
+      [&](int64_t    const& v) { result = number((double)v);  },
+      [&](JsonObject const& v) { result = v.Hash();           },
+      [&](JsonArray  const& v) { result = v.Hash();           },
+      [&](auto       const& v) { result = 0;                  }
+    }, value);
+    return result;
+  }
+
   bool LessThan(VALUE const& left, VALUE const& right)
   {
     bool result;
@@ -40,6 +40,8 @@ namespace Json4CPP
 
       JSON_API bool   Equal              (VALUE const& left, VALUE const& right);
       JSON_API bool   NotEqual           (VALUE const& left, VALUE const& right);
+      // Consistent with Equal: numbers and booleans are hashed by their value as a double, so 1, 1.0 and true hash the same.
+      JSON_API uint64_t Hash             (VALUE const& value                   );
       JSON_API bool   LessThan           (VALUE const& left, VALUE const& right);
       JSON_API bool   LessThanOrEqual    (VALUE const& left, VALUE const& right);
       JSON_API bool   GreaterThan        (VALUE const& left, VALUE const& right);
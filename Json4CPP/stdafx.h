@@ -25,9 +25,12 @@
 #include <vector>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <algorithm>
 #include <iterator>
 #include <filesystem>
 #include <charconv>
-#include <functional>
\ No newline at end of file
+#include <functional>
+#include <cmath>
+#include <limits>
\ No newline at end of file